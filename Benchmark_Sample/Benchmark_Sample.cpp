@@ -0,0 +1,45 @@
+// Benchmark_Sample.cpp : Defines the entry point for the console application.
+//
+// Usage: Benchmark_Sample [-frame file.ppm] [name...]
+// Runs the named benchmarks, or all of them when no name is given. The stencil benchmark filters the frame of the
+// binary PPM file, or a generated one.
+
+#include "stdafx.h"
+#include "benchmark.h"
+
+struct benchmark
+{
+	const char* name;
+	void (*run)();
+};
+
+static const benchmark benchmarks[] = {
+	{ "reduce", reduce_benchmark },
+	{ "scan", scan_benchmark },
+	{ "search", search_benchmark },
+	{ "stable_partition", stable_partition_benchmark },
+	{ "stencil", stencil_benchmark },
+};
+
+int main(int argc, char* argv[])
+{
+	int names = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-frame") == 0 && i + 1 < argc)
+			frame_path = argv[++i];
+		else
+			argv[++names] = argv[i];
+	}
+
+	for (auto& b : benchmarks)
+	{
+		bool selected = names == 0;
+		for (int i = 1; i <= names; ++i)
+			selected |= strcmp(argv[i], b.name) == 0;
+
+		if (selected)
+			b.run();
+	}
+	return 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Runs f the given number of times and returns the fastest run in milliseconds
+template<typename F>
+double measure_best_ms(F&& f, int runs = 5)
+{
+	using namespace std::chrono;
+
+	double best = 0;
+	for (int i = 0; i < runs; ++i)
+	{
+		auto begin = high_resolution_clock::now();
+		f();
+		auto end = high_resolution_clock::now();
+
+		double ms = duration_cast<duration<double, std::milli>>(end - begin).count();
+		if (i == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+// Keeps the optimizer from dropping a computation whose result is otherwise unused
+template<typename T>
+void do_not_optimize(const T& value)
+{
+	static volatile char sink;
+	sink = *reinterpret_cast<const volatile char*>(&value);
+}
+
+// Benchmarks, one per source file
+void reduce_benchmark();
+void scan_benchmark();
+void search_benchmark();
+void stable_partition_benchmark();
+void stencil_benchmark();
+
+// Binary PPM file of the stencil benchmark, a frame is generated without it
+extern const char* frame_path;
@@ -0,0 +1,90 @@
+// reduce(par_deterministic) against reduce(par): the price of a fixed chunk tree and index ordered combine
+// transform_reduce(par) against transform(par) + reduce(par): what the fused pass saves over a temporary
+
+#include "stdafx.h"
+#include "benchmark.h"
+
+#include <set>
+#include <experimental/algorithm>
+#include <experimental/numeric>
+
+using namespace std::experimental::parallel;
+
+static void test_reduce(size_t size)
+{
+	// Values spread over many magnitudes so that the summation order shows in the result
+	std::vector<double> v(size);
+	for (size_t i = 0; i < size; ++i)
+		v[i] = (i % 3 == 0) ? 1e9 / (i + 1) : 1e-3 * (i % 1000);
+
+	printf("\nTesting reduce of %llu doubles:\n", static_cast<unsigned long long>(size));
+
+	double result = 0;
+	double serial = measure_best_ms([&] {
+		result = std::accumulate(v.begin(), v.end(), 0.0);
+		do_not_optimize(result);
+	});
+	printf("serial:            %9.3f ms\n", serial);
+
+	std::set<double> results;
+	double parallel = measure_best_ms([&] {
+		result = reduce(par, v.begin(), v.end(), 0.0);
+		results.insert(result);
+	}, 10);
+	printf("par:               %9.3f ms  %llu distinct results in 10 runs\n", parallel, static_cast<unsigned long long>(results.size()));
+
+	results.clear();
+	double deterministic = measure_best_ms([&] {
+		result = reduce(par_deterministic, v.begin(), v.end(), 0.0);
+		results.insert(result);
+	}, 10);
+	printf("par_deterministic: %9.3f ms  %llu distinct results in 10 runs, overhead vs par %+.1f%%\n", deterministic,
+		static_cast<unsigned long long>(results.size()), (deterministic / parallel - 1) * 100);
+}
+
+static void test_dot_product(size_t size)
+{
+	std::vector<double> a(size), b(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		a[i] = 1.0 / (i % 100 + 1);
+		b[i] = static_cast<double>(i % 7);
+	}
+
+	printf("\nTesting dot product of %llu doubles:\n", static_cast<unsigned long long>(size));
+
+	double result = 0;
+	double serial = measure_best_ms([&] {
+		result = std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+		do_not_optimize(result);
+	});
+	printf("serial:                   %9.3f ms\n", serial);
+
+	double materialized = measure_best_ms([&] {
+		std::vector<double> products(size);
+		transform(par, a.begin(), a.end(), b.begin(), products.begin(), std::multiplies<>());
+		result = reduce(par, products.begin(), products.end(), 0.0);
+		do_not_optimize(result);
+	});
+	printf("transform + reduce (par): %9.3f ms\n", materialized);
+
+	double fused = measure_best_ms([&] {
+		result = transform_reduce(par, a.begin(), a.end(), b.begin(), 0.0);
+		do_not_optimize(result);
+	});
+	printf("transform_reduce (par):   %9.3f ms  speedup vs materialized %.2fx\n", fused, materialized / fused);
+}
+
+void reduce_benchmark()
+{
+	test_reduce(1000 * 10);
+	test_reduce(1000 * 100);
+	test_reduce(1000 * 1000);
+	test_reduce(1000 * 1000 * 10);
+	test_reduce(1000 * 1000 * 50);
+
+	test_dot_product(1000 * 100);
+	test_dot_product(1000 * 1000);
+	test_dot_product(1000 * 1000 * 10);
+	test_dot_product(1000 * 1000 * 50);
+}
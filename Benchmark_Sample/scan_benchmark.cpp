@@ -0,0 +1,54 @@
+// inclusive_scan(par) with the single pass look-back engine against the two stage copy partitioner engine
+// on a memory bound prefix sum (offset table), reported as effective bandwidth: bytes read once plus bytes written
+
+#include "stdafx.h"
+#include "benchmark.h"
+
+#include <cstdint>
+#include <experimental/numeric>
+
+using namespace std::experimental::parallel;
+
+static void test_scan(size_t size)
+{
+	std::vector<uint64_t> sizes(size), offsets(size);
+	for (size_t i = 0; i < size; ++i)
+		sizes[i] = i % 61;
+
+	const double bytes = 2.0 * size * sizeof(uint64_t);
+	auto gbps = [bytes](double ms) { return bytes / (ms * 1e6); };
+
+	printf("\nTesting inclusive scan of %llu uint64_t (%.0f MB):\n", static_cast<unsigned long long>(size), bytes / 2 / (1024 * 1024));
+
+	double serial = measure_best_ms([&] {
+		std::partial_sum(sizes.begin(), sizes.end(), offsets.begin());
+		do_not_optimize(offsets.back());
+	});
+	printf("serial:          %9.3f ms  %6.2f GB/s\n", serial, gbps(serial));
+
+	// The engines are picked by iterator type, call the two stage one directly to compare on the same data
+	double two_stage = measure_best_ms([&] {
+		details::_Inclusive_scan_engine<parallel_execution_policy>(sizes.begin(), sizes.end(), offsets.begin(), details::_Scan_identity(), uint64_t{ 0 }, std::plus<>(), std::false_type());
+		do_not_optimize(offsets.back());
+	});
+	printf("par two stage:   %9.3f ms  %6.2f GB/s\n", two_stage, gbps(two_stage));
+
+	double lookback = measure_best_ms([&] {
+		inclusive_scan(par, sizes.begin(), sizes.end(), offsets.begin());
+		do_not_optimize(offsets.back());
+	});
+	printf("par look-back:   %9.3f ms  %6.2f GB/s  speedup vs two stage %.2fx\n", lookback, gbps(lookback), two_stage / lookback);
+
+	std::vector<uint64_t> expected(size);
+	std::partial_sum(sizes.begin(), sizes.end(), expected.begin());
+	if (offsets != expected)
+		printf("look-back result mismatch\n");
+}
+
+void scan_benchmark()
+{
+	test_scan(1000 * 100);
+	test_scan(1000 * 1000);
+	test_scan(1000 * 1000 * 10);
+	test_scan(1000 * 1000 * 64);
+}
@@ -0,0 +1,71 @@
+// find, count and mismatch over a log-like buffer of chars and over ints: std:: against par (one comparison and
+// cancellation check per element) and par_vec (SSE2/AVX2 kernels, one check per block), in GB/s of input read
+
+#include "stdafx.h"
+#include "benchmark.h"
+
+#include <cstdint>
+#include <experimental/algorithm>
+
+using namespace std::experimental::parallel;
+
+static void print_rate(const char* name, double ms, size_t bytes, double serial)
+{
+	printf("%-16s %9.3f ms  %6.2f GB/s  speedup vs serial %.2fx\n", name, ms, bytes / (ms * 1e6), serial / ms);
+}
+
+template<typename _Ty>
+static void test_search(const char* name, size_t size, _Ty other, _Ty marker)
+{
+	std::vector<_Ty> data(size), copy(size);
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<_Ty>(other + static_cast<_Ty>(i % 61));
+	// Only the last element matches, every search reads the whole input
+	data[size - 1] = marker;
+	copy = data;
+	copy[size - 1] = other;
+
+	const size_t bytes = size * sizeof(_Ty);
+	printf("\nTesting searches over %llu %s (%.0f MB):\n", static_cast<unsigned long long>(size), name, bytes / 1e6);
+
+	double serial = measure_best_ms([&] {
+		do_not_optimize(std::find(data.begin(), data.end(), marker));
+	});
+	print_rate("find serial:", serial, bytes, serial);
+	print_rate("find par:", measure_best_ms([&] {
+		do_not_optimize(find(par, data.begin(), data.end(), marker));
+	}), bytes, serial);
+	print_rate("find par_vec:", measure_best_ms([&] {
+		do_not_optimize(find(par_vec, data.begin(), data.end(), marker));
+	}), bytes, serial);
+
+	serial = measure_best_ms([&] {
+		do_not_optimize(std::count(data.begin(), data.end(), marker));
+	});
+	print_rate("count serial:", serial, bytes, serial);
+	print_rate("count par:", measure_best_ms([&] {
+		do_not_optimize(count(par, data.begin(), data.end(), marker));
+	}), bytes, serial);
+	print_rate("count par_vec:", measure_best_ms([&] {
+		do_not_optimize(count(par_vec, data.begin(), data.end(), marker));
+	}), bytes, serial);
+
+	// Two inputs are read
+	serial = measure_best_ms([&] {
+		do_not_optimize(std::mismatch(data.begin(), data.end(), copy.begin()));
+	});
+	print_rate("mismatch serial:", serial, 2 * bytes, serial);
+	print_rate("mismatch par:", measure_best_ms([&] {
+		do_not_optimize(mismatch(par, data.begin(), data.end(), copy.begin()));
+	}), 2 * bytes, serial);
+	print_rate("mismatch par_vec:", measure_best_ms([&] {
+		do_not_optimize(mismatch(par_vec, data.begin(), data.end(), copy.begin()));
+	}), 2 * bytes, serial);
+}
+
+void search_benchmark()
+{
+	test_search<char>("chars", 1000 * 1000 * 128, ' ', '\n');
+	test_search<int32_t>("ints", 1000 * 1000 * 64, 0, -1);
+	test_search<float>("floats", 1000 * 1000 * 64, 1.0f, -1.0f);
+}
@@ -0,0 +1,100 @@
+// stable_partition(par) with the flag-scan engine (scratch storage for the whole range) and with the bounded variant
+// (an eighth of the range, block partitions combined by parallel rotations) against the former recursive
+// divide-and-rotate implementation, on random access and on bidirectional (std::list) ranges
+
+#include "stdafx.h"
+#include "benchmark.h"
+
+#include <list>
+#include <cstdint>
+#include <experimental/algorithm>
+
+using namespace std::experimental::parallel;
+
+// The implementation stable_partition(par) used before the flag-scan engine: halves partitioned in parallel down to
+// one task per core and combined with a sequential rotation
+template<class _BidIt, class _Pr>
+static _BidIt legacy_stable_partition(_BidIt first, _BidIt last, size_t count, _Pr pred, size_t div)
+{
+	if (div < 2)
+		return std::stable_partition(first, last, pred);
+
+	auto mid = first;
+	size_t mid_point = count / 2;
+	std::advance(mid, mid_point);
+
+	_BidIt right;
+	auto handle = details::make_task([=, &right] {
+		right = legacy_stable_partition(mid, last, count - mid_point, pred, div / 2);
+	});
+
+	details::TaskGroup tg;
+	tg.run(handle);
+
+	auto left = legacy_stable_partition(first, mid, mid_point, pred, div / 2);
+	tg.wait();
+
+	return std::rotate(left, mid, right);
+}
+
+// Fastest of the runs in milliseconds, the input is restored from source before every run and not timed
+template<typename _Container, typename F>
+static double measure_partition(_Container& data, const _Container& source, F&& f, int runs = 5)
+{
+	double best = 0;
+	for (int i = 0; i < runs; ++i)
+	{
+		std::copy(source.begin(), source.end(), data.begin());
+		double ms = measure_best_ms(f, 1);
+		if (i == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+template<typename _Container>
+static void test_stable_partition(const char* name, size_t size)
+{
+	_Container source;
+	for (size_t i = 0; i < size; ++i)
+		source.push_back(static_cast<uint64_t>(i) * 2654435761u % 1000);
+
+	_Container data(source), expected(source);
+	auto pred = [](uint64_t x) { return x < 400; };
+	std::stable_partition(expected.begin(), expected.end(), pred);
+
+	printf("\nTesting stable_partition of %llu uint64_t in a %s (40%% true):\n", static_cast<unsigned long long>(size), name);
+
+	double serial = measure_partition(data, source, [&] {
+		do_not_optimize(std::stable_partition(data.begin(), data.end(), pred));
+	});
+	printf("serial:              %9.3f ms\n", serial);
+
+	double legacy = measure_partition(data, source, [&] {
+		do_not_optimize(legacy_stable_partition(data.begin(), data.end(), size, pred, details::get_hardware_concurrency()));
+	});
+	printf("par divide-rotate:   %9.3f ms  speedup vs serial %.2fx\n", legacy, serial / legacy);
+
+	double flag_scan = measure_partition(data, source, [&] {
+		do_not_optimize(stable_partition(par, data.begin(), data.end(), pred));
+	});
+	printf("par flag-scan:       %9.3f ms  speedup vs serial %.2fx, vs divide-rotate %.2fx\n", flag_scan, serial / flag_scan, legacy / flag_scan);
+	if (data != expected)
+		printf("flag-scan result mismatch\n");
+
+	double bounded = measure_partition(data, source, [&] {
+		do_not_optimize(stable_partition(par, data.begin(), data.end(), pred, size / 8));
+	});
+	printf("par bounded (n/8):   %9.3f ms  speedup vs serial %.2fx, vs divide-rotate %.2fx\n", bounded, serial / bounded, legacy / bounded);
+	if (data != expected)
+		printf("bounded result mismatch\n");
+}
+
+void stable_partition_benchmark()
+{
+	test_stable_partition<std::vector<uint64_t>>("vector", 1000 * 100);
+	test_stable_partition<std::vector<uint64_t>>("vector", 1000 * 1000);
+	test_stable_partition<std::vector<uint64_t>>("vector", 1000 * 1000 * 10);
+	test_stable_partition<std::vector<uint64_t>>("vector", 1000 * 1000 * 64);
+	test_stable_partition<std::list<uint64_t>>("list", 1000 * 1000);
+}
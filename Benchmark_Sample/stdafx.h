@@ -0,0 +1,14 @@
+// stdafx.h : include file for standard system include files,
+// or project specific include files that are used frequently, but
+// are changed infrequently
+//
+
+#pragma once
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <numeric>
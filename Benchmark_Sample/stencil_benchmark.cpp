@@ -0,0 +1,203 @@
+// The cartoonizer filters on a frame read from a binary PPM file (-frame file.ppm) or on a generated 1920 x 1080 one:
+// the former per-pixel implementation, for_each(par) over the bounds of the frame with the neighbours read and
+// converted to YUV at every pixel, against the filters on the stencil algorithm (converted once, passes of the color
+// simplifier fused per tile) with seq, par and par_vec, in milliseconds and megapixels per second
+
+#include "stdafx.h"
+#include "benchmark.h"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <experimental/algorithm>
+#include "../ImageCartoonizerServer_Sample/CartoonizerFilters.h"
+
+using namespace std::experimental::parallel;
+using namespace std::experimental::D4087;
+using Cartoonizer::Pixel;
+
+const char* frame_path = nullptr;
+
+static const int phases = 3;
+static const int neighbour_window = 3;
+
+// P6 header with optional comments, 8 bit samples in RGB order
+static bool load_ppm(const char* path, std::vector<Pixel>& frame, int& width, int& height)
+{
+	std::ifstream file(path, std::ios::binary);
+	std::string magic;
+	int max_value = 0;
+	file >> magic;
+	for (int* field : { &width, &height, &max_value })
+	{
+		while (file >> std::ws && file.peek() == '#')
+			file.ignore(1 << 20, '\n');
+		file >> *field;
+	}
+	file.get();
+	if (!file || magic != "P6" || width <= 0 || height <= 0 || max_value != 255)
+		return false;
+
+	std::vector<uint8_t> rgb(3 * static_cast<size_t>(width) * height);
+	file.read(reinterpret_cast<char*>(rgb.data()), rgb.size());
+	if (!file)
+		return false;
+
+	frame.resize(static_cast<size_t>(width) * height);
+	for (size_t i = 0; i < frame.size(); ++i)
+	{
+		frame[i].r = rgb[3 * i];
+		frame[i].g = rgb[3 * i + 1];
+		frame[i].b = rgb[3 * i + 2];
+	}
+	return true;
+}
+
+// Gradients with blocks of flat color, so that both filters find edges
+static void generate_frame(std::vector<Pixel>& frame, int width, int height)
+{
+	frame.resize(static_cast<size_t>(width) * height);
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			Pixel& p = frame[static_cast<size_t>(y) * width + x];
+			bool block = ((x / 97) + (y / 61)) % 3 == 0;
+			p.r = static_cast<uint8_t>(block ? 200 : x * 255 / width);
+			p.g = static_cast<uint8_t>(block ? 40 : y * 255 / height);
+			p.b = static_cast<uint8_t>(block ? 90 : (x + y) % 256);
+		}
+	}
+}
+
+// The filters as they were, one for_each over the bounds per phase
+static void legacy_cartoonize(const std::vector<Pixel>& source, std::vector<Pixel>& target, int width, int height)
+{
+	using Cartoonizer::TonePixel;
+
+	auto yuv = [](const Pixel& p, float& y, float& u, float& v) { Cartoonizer::RGBToYUV(p.r, p.g, p.b, y, u, v); };
+	std::vector<Pixel> current(source), next(source);
+	const int shift = neighbour_window / 2;
+
+	bounds<2> inner{ height - 2 * shift, width - 2 * shift };
+	for (int phase = 0; phase < phases; ++phase)
+	{
+		for_each(par, std::begin(inner), std::end(inner), [&](std::experimental::D4087::index<2> idx) {
+			const int y = static_cast<int>(idx[0]) + shift, x = static_cast<int>(idx[1]) + shift;
+			float y0, u0, v0;
+			yuv(current[y * width + x], y0, u0, v0);
+
+			double sSum = 0, partialSumR = 0, partialSumG = 0, partialSumB = 0;
+			for (int j = y - shift; j <= y + shift; ++j)
+			{
+				for (int i = x - shift; i <= x + shift; ++i)
+				{
+					if (i == x && j == y)
+						continue;
+					const Pixel& clr = current[j * width + i];
+					float y1, u1, v1;
+					yuv(clr, y1, u1, v1);
+					double du = u0 - u1, dv = v0 - v1;
+					double sValue = std::exp(-0.5 * (du * du + dv * dv) / (0.025 * 0.025));
+					sSum += sValue;
+					partialSumR += clr.r * sValue;
+					partialSumG += clr.g * sValue;
+					partialSumB += clr.b * sValue;
+				}
+			}
+
+			TonePixel simplified(Cartoonizer::ColorSimplifier::Clamp(partialSumR / sSum), Cartoonizer::ColorSimplifier::Clamp(partialSumG / sSum), Cartoonizer::ColorSimplifier::Clamp(partialSumB / sSum));
+			Pixel& out = next[y * width + x];
+			out.r = simplified.r;
+			out.g = simplified.g;
+			out.b = simplified.b;
+		});
+		std::swap(current, next);
+	}
+
+	target = current;
+	bounds<2> edges{ height - 2, width - 2 };
+	for_each(par, std::begin(edges), std::end(edges), [&](std::experimental::D4087::index<2> idx) {
+		const int y = static_cast<int>(idx[0]) + 1, x = static_cast<int>(idx[1]) + 1;
+		Cartoonizer::EdgeSample window[9];
+		for (int j = -1; j < 2; ++j)
+		{
+			for (int i = -1; i < 2; ++i)
+			{
+				float* s = window[(j + 1) * 3 + i + 1].yuv;
+				yuv(current[(y + j) * width + x + i], s[0], s[1], s[2]);
+				yuv(source[(y + j) * width + x + i], s[3], s[4], s[5]);
+			}
+		}
+
+		float i = Cartoonizer::EdgeDetector()(stencil_window<const Cartoonizer::EdgeSample>(window + 4, 3, 1));
+		const Pixel& clr = current[y * width + x];
+		Pixel& out = target[y * width + x];
+		out.r = static_cast<uint8_t>(clr.r * (1 - i));
+		out.g = static_cast<uint8_t>(clr.g * (1 - i));
+		out.b = static_cast<uint8_t>(clr.b * (1 - i));
+	});
+}
+
+static void print_rate(const char* name, double ms, size_t pixels, double legacy)
+{
+	printf("%-28s %9.3f ms  %7.2f Mpixel/s  speedup vs per-pixel %.2fx\n", name, ms, pixels / (ms * 1e3), legacy / ms);
+}
+
+void stencil_benchmark()
+{
+	std::vector<Pixel> frame;
+	int width = 1920, height = 1080;
+	if (frame_path == nullptr)
+		generate_frame(frame, width, height);
+	else if (!load_ppm(frame_path, frame, width, height))
+	{
+		printf("\nCannot read %s as a binary PPM file with 8 bit samples\n", frame_path);
+		return;
+	}
+
+	const size_t pixels = frame.size();
+	printf("\nTesting the cartoonizer filters (%d phases, %d x %d window) on a %d x %d frame:\n", phases, neighbour_window, neighbour_window, width, height);
+
+	std::vector<Pixel> expected(pixels), result(pixels);
+	bounds<2> bnd{ height, width };
+	array_view<const Pixel, 2> source(bnd, frame);
+	Cartoonizer::FrameFilters filters;
+
+	double legacy = measure_best_ms([&] {
+		legacy_cartoonize(frame, expected, width, height);
+	}, 3);
+	print_rate("per-pixel for_each par:", legacy, pixels, legacy);
+
+	const struct { const char* name; execution_policy policy; } policies[] = {
+		{ "stencil seq:", seq }, { "stencil par:", par }, { "stencil par_vec:", par_vec }
+	};
+	for (auto& p : policies)
+	{
+		print_rate(p.name, measure_best_ms([&] {
+			filters.Apply(p.policy, source, array_view<Pixel, 2>(bnd, result), phases, neighbour_window);
+		}, 3), pixels, legacy);
+		if (memcmp(expected.data(), result.data(), pixels * sizeof(Pixel)) != 0)
+			printf("result differs from the per-pixel filters\n");
+	}
+
+	// The passes of the simplifier one stencil each, a full sweep over the frame per pass, against all fused per tile
+	std::vector<Cartoonizer::TonePixel> tones(pixels), other(pixels);
+	std::transform(frame.begin(), frame.end(), tones.begin(), [](const Pixel& p) { return Cartoonizer::TonePixel(p.r, p.g, p.b); });
+	other = tones;
+	Cartoonizer::ColorSimplifier simplifier = { neighbour_window / 2 };
+
+	double sweeps = measure_best_ms([&] {
+		for (int phase = 0; phase < phases; ++phase)
+		{
+			stencil(par, array_view<const Cartoonizer::TonePixel, 2>(bnd, phase % 2 ? other : tones), array_view<Cartoonizer::TonePixel, 2>(bnd, phase % 2 ? tones : other), neighbour_window / 2, simplifier);
+		}
+	}, 3);
+	printf("%-28s %9.3f ms\n", "simplifier, pass per sweep:", sweeps);
+
+	double fused = measure_best_ms([&] {
+		stencil(par, array_view<const Cartoonizer::TonePixel, 2>(bnd, tones), array_view<Cartoonizer::TonePixel, 2>(bnd, other), neighbour_window / 2, static_cast<size_t>(phases), simplifier);
+	}, 3);
+	printf("%-28s %9.3f ms  speedup %.2fx\n", "simplifier, fused passes:", fused, sweeps / fused);
+}
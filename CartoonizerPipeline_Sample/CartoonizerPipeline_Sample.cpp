@@ -0,0 +1,161 @@
+// CartoonizerPipeline_Sample.cpp : Defines the entry point for the console application.
+//
+// Usage: CartoonizerPipeline_Sample [-raw WIDTHxHEIGHT] [-frames n] [-phases n] [-window n] [-inflight n]
+//                                   [-policy seq|par|par_vec] [-out file.ppm] [file...]
+// Cartoonizes the frames of the files, binary PPM sequences or raw 24 bit RGB frames of the -raw size, or generated
+// 1280 x 720 frames without files. -frames limits the number of frames (24 generated ones by default). The frames go
+// through a pipeline of four stages, decode, simplify, edge detect and write, with at most -inflight frames (4 by
+// default) in the pipeline. Every policy, or the one of -policy, runs the whole sequence and reports the time the
+// frames spend in every stage and the frame rate. -out writes the cartoonized frames as a PPM sequence, a file per
+// policy named after it (out.seq.ppm, out.par.ppm, ...) unless -policy picks one.
+
+#include "stdafx.h"
+#include "frame_pipeline.h"
+
+#include <experimental/algorithm>
+
+using namespace std::experimental::parallel;
+
+// Moving gradients with blocks of flat color, as a PPM sequence
+static void generate_sequence(std::vector<uint8_t>& sequence, int width, int height, int count)
+{
+	char header[32];
+	int header_size = sprintf(header, "P6\n%d %d\n255\n", width, height);
+	size_t frame_size = header_size + 3 * static_cast<size_t>(width) * height;
+	sequence.resize(frame_size * count);
+
+	for (int frame = 0; frame < count; ++frame)
+	{
+		uint8_t* data = sequence.data() + frame * frame_size;
+		memcpy(data, header, header_size);
+		data += header_size;
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x, data += 3)
+			{
+				int u = x + 8 * frame;
+				bool block = ((u / 97) + (y / 61)) % 3 == 0;
+				data[0] = static_cast<uint8_t>(block ? 200 : u * 255 / (width + 8 * count));
+				data[1] = static_cast<uint8_t>(block ? 40 : y * 255 / height);
+				data[2] = static_cast<uint8_t>(block ? 90 : (u + y) % 256);
+			}
+		}
+	}
+}
+
+// Inserts the policy name before the extension of the file name
+static std::string policy_output_path(const char* path, const char* policy)
+{
+	std::string name(path);
+	size_t dot = name.find_last_of('.');
+	size_t separator = name.find_last_of("/\\");
+	if (dot == std::string::npos || (separator != std::string::npos && dot < separator))
+		dot = name.size();
+	return name.insert(dot, std::string(".") + policy);
+}
+
+static void print_report(const char* name, const pipeline_report& report, const pipeline_options& options)
+{
+	printf("\nCartoonizing %d frames with %s (%d phases, %d x %d window, %d frames in flight):\n",
+		static_cast<int>(report.frames), name, options.phases, options.window, options.window, static_cast<int>(options.in_flight));
+	for (int stage = 0; stage < stage_count; ++stage)
+	{
+		printf("  %-12s mean %9.3f ms  max %9.3f ms\n", stage_name(static_cast<pipeline_stage>(stage)),
+			report.stage_mean_ms[stage], report.stage_max_ms[stage]);
+	}
+	printf("  %-12s mean %9.3f ms  max %9.3f ms\n", "end to end", report.latency_mean_ms, report.latency_max_ms);
+	printf("  %.3f ms, %.2f frames/s\n", report.total_ms, report.frames / (report.total_ms / 1000));
+}
+
+int main(int argc, char* argv[])
+{
+	pipeline_options options = { 3, 3, 4, nullptr };
+	int raw_width = 0, raw_height = 0;
+	int max_frames = -1;
+	const char* policy_name = nullptr;
+	const char* output_path = nullptr;
+	std::vector<const char*> paths;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		bool has_value = i + 1 < argc;
+		if (strcmp(argv[i], "-raw") == 0 && has_value)
+		{
+			if (sscanf(argv[++i], "%dx%d", &raw_width, &raw_height) != 2 || raw_width <= 0 || raw_height <= 0)
+			{
+				printf("-raw expects the frame size as WIDTHxHEIGHT\n");
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "-frames") == 0 && has_value)
+			max_frames = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-phases") == 0 && has_value)
+			options.phases = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-window") == 0 && has_value)
+			options.window = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-inflight") == 0 && has_value)
+			options.in_flight = static_cast<size_t>((std::max)(1, atoi(argv[++i])));
+		else if (strcmp(argv[i], "-policy") == 0 && has_value)
+			policy_name = argv[++i];
+		else if (strcmp(argv[i], "-out") == 0 && has_value)
+			output_path = argv[++i];
+		else
+			paths.push_back(argv[i]);
+	}
+
+	// The mappings stay open while the frames are processed, the frames point into them
+	std::vector<std::unique_ptr<mapped_file>> files;
+	std::vector<uint8_t> generated;
+	std::vector<frame_info> frames;
+	for (const char* path : paths)
+	{
+		files.emplace_back(new mapped_file(path));
+		const mapped_file& file = *files.back();
+		bool parsed = raw_width > 0 ? parse_raw_sequence(file.data(), file.size(), raw_width, raw_height, frames)
+			: parse_ppm_sequence(file.data(), file.size(), frames);
+		if (file.data() == nullptr || !parsed)
+		{
+			printf("Cannot read %s as a %s\n", path, raw_width > 0 ? "sequence of raw frames of that size" : "binary PPM sequence with 8 bit samples");
+			return 1;
+		}
+	}
+	if (paths.empty())
+	{
+		generate_sequence(generated, 1280, 720, max_frames < 0 ? 24 : max_frames);
+		parse_ppm_sequence(generated.data(), generated.size(), frames);
+	}
+	if (max_frames >= 0 && frames.size() > static_cast<size_t>(max_frames))
+		frames.resize(max_frames);
+
+	const struct { const char* name; execution_policy policy; } policies[] = {
+		{ "seq", seq }, { "par", par }, { "par_vec", par_vec }
+	};
+
+	uint32_t checksum = 0;
+	bool first = true;
+	for (auto& p : policies)
+	{
+		if (policy_name != nullptr && strcmp(policy_name, p.name) != 0)
+			continue;
+
+		options.output = nullptr;
+		if (output_path != nullptr)
+			options.output = fopen(policy_name != nullptr ? output_path : policy_output_path(output_path, p.name).c_str(), "wb");
+		pipeline_report report = run_pipeline(p.policy, frames, options);
+		if (options.output != nullptr)
+			fclose(options.output);
+
+		print_report(p.name, report, options);
+		if (!first && report.checksum != checksum)
+			printf("  the frames differ from the ones of the policy before\n");
+		checksum = report.checksum;
+		first = false;
+	}
+
+	if (first)
+	{
+		printf("Unknown policy %s, expected seq, par or par_vec\n", policy_name);
+		return 1;
+	}
+	return 0;
+}
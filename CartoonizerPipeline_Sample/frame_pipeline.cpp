@@ -0,0 +1,207 @@
+#include "stdafx.h"
+#include "frame_pipeline.h"
+
+#include <experimental/algorithm>
+#include <experimental/array_view>
+#include "../ImageCartoonizerServer_Sample/CartoonizerFilters.h"
+
+using namespace std::experimental::parallel;
+using namespace std::experimental::D4087;
+using Cartoonizer::Pixel;
+
+typedef std::chrono::high_resolution_clock pipeline_clock;
+
+namespace
+{
+	// Hands elements from one stage to the next, pop waits for an element and fails once the queue is closed and empty
+	template<typename T>
+	class stage_queue
+	{
+	public:
+		stage_queue() : closed_(false)
+		{
+		}
+
+		void push(T value)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				items_.push_back(value);
+			}
+			ready_.notify_one();
+		}
+
+		void close()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				closed_ = true;
+			}
+			ready_.notify_all();
+		}
+
+		bool pop(T& value)
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			ready_.wait(lock, [this] { return closed_ || !items_.empty(); });
+			if (items_.empty())
+				return false;
+
+			value = items_.front();
+			items_.pop_front();
+			return true;
+		}
+
+	private:
+		std::mutex mutex_;
+		std::condition_variable ready_;
+		std::deque<T> items_;
+		bool closed_;
+	};
+
+	// A frame on its way through the stages, the buffers are reused by the next frame once it is written
+	struct frame_slot
+	{
+		const frame_info* source;
+		std::vector<Pixel> pixels;
+		std::vector<Pixel> cartoon;
+		std::vector<rgb> encoded;
+		Cartoonizer::FrameFilters filters;
+		pipeline_clock::time_point start;
+		double stage_ms[stage_count];
+	};
+
+	double elapsed_ms(pipeline_clock::time_point begin, pipeline_clock::time_point end)
+	{
+		return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(end - begin).count();
+	}
+
+	template<typename F>
+	double measure_ms(F&& f)
+	{
+		auto begin = pipeline_clock::now();
+		f();
+		return elapsed_ms(begin, pipeline_clock::now());
+	}
+
+	// FNV-1a
+	uint32_t hash_bytes(uint32_t hash, const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+			hash = (hash ^ bytes[i]) * 16777619u;
+		return hash;
+	}
+}
+
+const char* stage_name(pipeline_stage stage)
+{
+	static const char* const names[stage_count] = { "decode", "simplify", "edge detect", "write" };
+	return names[stage];
+}
+
+pipeline_report run_pipeline(const execution_policy& policy, const std::vector<frame_info>& frames, const pipeline_options& options)
+{
+	std::vector<std::unique_ptr<frame_slot>> slots((std::max)(options.in_flight, size_t{ 1 }));
+	stage_queue<frame_slot*> free_slots, decoded, simplified, detected;
+	for (auto& slot : slots)
+	{
+		slot.reset(new frame_slot());
+		free_slots.push(slot.get());
+	}
+
+	pipeline_report report = {};
+	report.checksum = 2166136261u;
+	auto begin = pipeline_clock::now();
+
+	// Waits for a free slot, which keeps the decoder at most in_flight frames ahead of the writer
+	std::thread decoder([&] {
+		for (auto& frame : frames)
+		{
+			frame_slot* slot;
+			free_slots.pop(slot);
+			slot->source = &frame;
+			slot->start = pipeline_clock::now();
+			slot->stage_ms[stage_decode] = measure_ms([&] {
+				slot->pixels.resize(static_cast<size_t>(frame.width) * frame.height);
+				std::experimental::parallel::transform(policy, frame.pixels, frame.pixels + slot->pixels.size(), slot->pixels.begin(), [](const rgb& color) {
+					Pixel pixel = { color.b, color.g, color.r };
+					return pixel;
+				});
+			});
+			decoded.push(slot);
+		}
+		decoded.close();
+	});
+
+	std::thread simplifier([&] {
+		frame_slot* slot;
+		while (decoded.pop(slot))
+		{
+			bounds<2> bnd{ slot->source->height, slot->source->width };
+			slot->stage_ms[stage_simplify] = measure_ms([&] {
+				slot->filters.ApplyColorSimplifier(policy, array_view<const Pixel, 2>(bnd, slot->pixels), options.phases, options.window);
+			});
+			simplified.push(slot);
+		}
+		simplified.close();
+	});
+
+	std::thread edge_detector([&] {
+		frame_slot* slot;
+		while (simplified.pop(slot))
+		{
+			bounds<2> bnd{ slot->source->height, slot->source->width };
+			slot->stage_ms[stage_edges] = measure_ms([&] {
+				slot->cartoon.resize(slot->pixels.size());
+				slot->filters.ApplyEdgeDetection(policy, array_view<const Pixel, 2>(bnd, slot->pixels), array_view<Pixel, 2>(bnd, slot->cartoon));
+			});
+			detected.push(slot);
+		}
+		detected.close();
+	});
+
+	// The frames arrive in order, every stage is a single thread
+	frame_slot* slot;
+	while (detected.pop(slot))
+	{
+		slot->stage_ms[stage_write] = measure_ms([&] {
+			slot->encoded.resize(slot->cartoon.size());
+			std::experimental::parallel::transform(policy, slot->cartoon.begin(), slot->cartoon.end(), slot->encoded.begin(), [](const Pixel& pixel) {
+				rgb color = { pixel.r, pixel.g, pixel.b };
+				return color;
+			});
+			report.checksum = hash_bytes(report.checksum, slot->encoded.data(), slot->encoded.size() * sizeof(rgb));
+
+			if (options.output != nullptr)
+			{
+				fprintf(options.output, "P6\n%d %d\n255\n", slot->source->width, slot->source->height);
+				fwrite(slot->encoded.data(), sizeof(rgb), slot->encoded.size(), options.output);
+			}
+		});
+
+		double latency = elapsed_ms(slot->start, pipeline_clock::now());
+		report.latency_mean_ms += latency;
+		report.latency_max_ms = (std::max)(report.latency_max_ms, latency);
+		for (int stage = 0; stage < stage_count; ++stage)
+		{
+			report.stage_mean_ms[stage] += slot->stage_ms[stage];
+			report.stage_max_ms[stage] = (std::max)(report.stage_max_ms[stage], slot->stage_ms[stage]);
+		}
+		++report.frames;
+		free_slots.push(slot);
+	}
+
+	decoder.join();
+	simplifier.join();
+	edge_detector.join();
+	report.total_ms = elapsed_ms(begin, pipeline_clock::now());
+
+	if (report.frames > 0)
+	{
+		report.latency_mean_ms /= report.frames;
+		for (int stage = 0; stage < stage_count; ++stage)
+			report.stage_mean_ms[stage] /= report.frames;
+	}
+	return report;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// The cartoonizer as a pipeline over a frame sequence: every stage runs on a thread of its own and hands the frame to
+// the next one, a pool of frame slots bounds the number of frames between the first and the last stage. Inside a
+// stage the filters run with the execution policy.
+
+#include <experimental/execution_policy>
+#include "frame_source.h"
+
+enum pipeline_stage
+{
+	stage_decode,
+	stage_simplify,
+	stage_edges,
+	stage_write,
+	stage_count
+};
+
+struct pipeline_options
+{
+	int phases;
+	int window;
+	size_t in_flight;
+	// PPM sequence of the cartoonized frames, nothing is written when null
+	FILE* output;
+};
+
+struct pipeline_report
+{
+	size_t frames;
+	double total_ms;
+	// Time a frame spends in a stage, without the waits between stages
+	double stage_mean_ms[stage_count];
+	double stage_max_ms[stage_count];
+	// From the start of the decoding to the end of the writing of a frame
+	double latency_mean_ms;
+	double latency_max_ms;
+	// Of the cartoonized frames, the same for every policy
+	uint32_t checksum;
+};
+
+pipeline_report run_pipeline(const std::experimental::parallel::execution_policy& policy, const std::vector<frame_info>& frames, const pipeline_options& options);
+
+const char* stage_name(pipeline_stage stage);
@@ -0,0 +1,135 @@
+#include "stdafx.h"
+#include "frame_source.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+mapped_file::mapped_file(const char* path) : data_(nullptr), size_(0), file_(INVALID_HANDLE_VALUE), mapping_(nullptr)
+{
+	file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	LARGE_INTEGER size;
+	if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size) || size.QuadPart == 0)
+		return;
+
+	mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_ == nullptr)
+		return;
+
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	if (data_ != nullptr)
+		size_ = static_cast<size_t>(size.QuadPart);
+}
+
+mapped_file::~mapped_file()
+{
+	if (data_ != nullptr)
+		UnmapViewOfFile(data_);
+	if (mapping_ != nullptr)
+		CloseHandle(mapping_);
+	if (file_ != INVALID_HANDLE_VALUE)
+		CloseHandle(file_);
+}
+#else
+mapped_file::mapped_file(const char* path) : data_(nullptr), size_(0)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat info;
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED)
+		{
+			// The frames are read once, front to back
+			madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+			data_ = static_cast<const uint8_t*>(data);
+			size_ = static_cast<size_t>(info.st_size);
+		}
+	}
+	close(fd);
+}
+
+mapped_file::~mapped_file()
+{
+	if (data_ != nullptr)
+		munmap(const_cast<uint8_t*>(data_), size_);
+}
+#endif
+
+// Header fields are separated by whitespace and comments run from # to the end of the line
+static bool read_header_field(const uint8_t* data, size_t size, size_t& pos, int& value)
+{
+	for (;;)
+	{
+		while (pos < size && isspace(data[pos]))
+			++pos;
+		if (pos < size && data[pos] == '#')
+		{
+			while (pos < size && data[pos] != '\n')
+				++pos;
+		}
+		else
+			break;
+	}
+
+	value = 0;
+	size_t digits = 0;
+	for (; pos < size && isdigit(data[pos]) && digits < 9; ++pos, ++digits)
+		value = value * 10 + (data[pos] - '0');
+	return digits > 0;
+}
+
+bool parse_ppm_sequence(const uint8_t* data, size_t size, std::vector<frame_info>& frames)
+{
+	size_t pos = 0;
+	while (pos < size)
+	{
+		if (isspace(data[pos]))
+		{
+			++pos;
+			continue;
+		}
+
+		int width, height, max_value;
+		if (size - pos < 2 || data[pos] != 'P' || data[pos + 1] != '6')
+			return false;
+		pos += 2;
+		if (!read_header_field(data, size, pos, width) || !read_header_field(data, size, pos, height) || !read_header_field(data, size, pos, max_value))
+			return false;
+
+		// A single whitespace character ends the header
+		size_t bytes = 3 * static_cast<size_t>(width) * height;
+		if (width == 0 || height == 0 || max_value != 255 || pos >= size || !isspace(data[pos]) || size - pos - 1 < bytes)
+			return false;
+		++pos;
+
+		frame_info frame = { reinterpret_cast<const rgb*>(data + pos), width, height };
+		frames.push_back(frame);
+		pos += bytes;
+	}
+	return true;
+}
+
+bool parse_raw_sequence(const uint8_t* data, size_t size, int width, int height, std::vector<frame_info>& frames)
+{
+	size_t bytes = 3 * static_cast<size_t>(width) * height;
+	if (bytes == 0 || size % bytes != 0)
+		return false;
+
+	for (size_t pos = 0; pos < size; pos += bytes)
+	{
+		frame_info frame = { reinterpret_cast<const rgb*>(data + pos), width, height };
+		frames.push_back(frame);
+	}
+	return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Frame sequences read in place from memory mapped files: binary PPM images (P6, 8 bit samples) back to back in one
+// file, or raw 24 bit RGB frames of a size given on the command line
+
+struct rgb
+{
+	uint8_t r, g, b;
+};
+
+// A frame of a sequence, the pixels point into the mapping, row after row without padding
+struct frame_info
+{
+	const rgb* pixels;
+	int width;
+	int height;
+};
+
+// Read-only mapping of a whole file, data() is null when the file cannot be opened or mapped
+class mapped_file
+{
+public:
+	explicit mapped_file(const char* path);
+	~mapped_file();
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	const uint8_t* data() const { return data_; }
+	size_t size() const { return size_; }
+
+private:
+	const uint8_t* data_;
+	size_t size_;
+#ifdef _WIN32
+	void* file_;
+	void* mapping_;
+#endif
+};
+
+// Append the frames of data to frames, return false when data is not such a sequence
+bool parse_ppm_sequence(const uint8_t* data, size_t size, std::vector<frame_info>& frames);
+bool parse_raw_sequence(const uint8_t* data, size_t size, int width, int height, std::vector<frame_info>& frames);
@@ -0,0 +1,224 @@
+#pragma once
+
+//
+// The cartoonizer filters on frames of 24 bit pixels, built on the stencil algorithm of the Parallel STL. The file
+// depends on the standard library and the Parallel STL only, thus the filters run outside of the WinRT sample too.
+//
+//   color simplifier: every pixel becomes the average of its neighbours weighted by how close their colors are, the
+//                     passes run on tiles that stay in the cache between passes
+//   edge detection:   Sobel edges of the simplified and of the original frame darken the simplified one
+//
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <experimental/algorithm>
+#include <experimental/array_view>
+
+namespace Cartoonizer
+{
+	using std::experimental::D4087::array_view;
+	using std::experimental::parallel::execution_policy;
+	using std::experimental::parallel::stencil_window;
+
+	// Byte order of the 24 bpp frames of WIC
+	struct Pixel
+	{
+		uint8_t b, g, r;
+	};
+
+	const double Wr = 0.299;
+	const double Wb = 0.114;
+	const double Wg = 1 - Wr - Wb;
+
+	inline void RGBToYUV(double r, double g, double b, float& y, float& u, float& v)
+	{
+		r /= 255.0;
+		g /= 255.0;
+		b /= 255.0;
+
+		double luma = Wr * r + Wb * b + Wg * g;
+		y = static_cast<float>(luma);
+		u = static_cast<float>(0.436 * (b - luma) / (1 - Wb));
+		v = static_cast<float>(0.615 * (r - luma) / (1 - Wr));
+	}
+
+	inline float SmoothStep(float a, float b, float x)
+	{
+		if (x < a) return 0.0f;
+		else if (x >= b) return 1.0f;
+
+		x = (x - a) / (b - a);
+		return (x * x * (3.0f - 2.0f * x));
+	}
+
+	// Pixel of the simplifier passes, the chroma is computed once per pass instead of once per neighbour
+	struct TonePixel
+	{
+		float u, v;
+		uint8_t r, g, b;
+
+		TonePixel() : u(0), v(0), r(0), g(0), b(0)
+		{
+		}
+
+		TonePixel(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue)
+		{
+			float y;
+			RGBToYUV(r, g, b, y, u, v);
+		}
+	};
+
+	struct ColorSimplifier
+	{
+		int shift;
+
+		TonePixel operator()(const stencil_window<const TonePixel>& window) const
+		{
+			const double standardDeviation = 0.025;
+			const TonePixel& center = window(0, 0);
+
+			double sSum = 0;
+			double partialSumR = 0, partialSumG = 0, partialSumB = 0;
+			for (int j = -shift; j <= shift; ++j)
+			{
+				for (int i = -shift; i <= shift; ++i)
+				{
+					if (i != 0 || j != 0) // don't apply filter to the requested index, only to the neighbors
+					{
+						const TonePixel& clr = window(j, i);
+						double du = center.u - clr.u, dv = center.v - clr.v;
+						double sValue = std::exp(-0.5 * (du * du + dv * dv) / (standardDeviation * standardDeviation));
+						sSum += sValue;
+						partialSumR += clr.r * sValue;
+						partialSumG += clr.g * sValue;
+						partialSumB += clr.b * sValue;
+					}
+				}
+			}
+
+			return TonePixel(Clamp(partialSumR / sSum), Clamp(partialSumG / sSum), Clamp(partialSumB / sSum));
+		}
+
+		static uint8_t Clamp(double value)
+		{
+			return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+		}
+	};
+
+	// Luma and chroma of a pixel of the simplified frame, then of the original one
+	struct EdgeSample
+	{
+		float yuv[6];
+	};
+
+	// Strength of the edge at a pixel, 0 for none and 1 for a black line
+	struct EdgeDetector
+	{
+		float operator()(const stencil_window<const EdgeSample>& window) const
+		{
+			const float alpha = 0.3f;
+			const float beta = 0.8f;
+			const float s0 = 0.054f;
+			const float s1 = 0.064f;
+			const float a0 = 0.3f;
+			const float a1 = 0.7f;
+
+			float sx[6] = {}, sy[6] = {};
+			for (int j = -1; j < 2; j++)
+			{
+				for (int i = -1; i < 2; i++)
+				{
+					// The Sobel matrices Gx and Gy
+					const float gx = static_cast<float>(i * (j == 0 ? 2 : 1));
+					const float gy = static_cast<float>(-j * (i == 0 ? 2 : 1));
+					const float* sample = window(j, i).yuv;
+					for (int c = 0; c < 6; ++c)
+					{
+						sx[c] += gx * sample[c];
+						sy[c] += gy * sample[c];
+					}
+				}
+			}
+
+			float d[6];
+			for (int c = 0; c < 6; ++c)
+				d[c] = std::sqrt(sx[c] * sx[c] + sy[c] * sy[c]);
+
+			float edgeS = (1 - alpha) * d[0] + alpha * (d[1] + d[2]) / 2;
+			float edgeA = (1 - alpha) * d[3] + alpha * (d[4] + d[5]) / 2;
+
+			return (1 - beta) * SmoothStep(s0, s1, edgeS) + beta * SmoothStep(a0, a1, edgeA);
+		}
+	};
+
+	class FrameFilters
+	{
+	public:
+		// Simplifies the colors of source in phases passes over windows of neighbourWindow x neighbourWindow pixels,
+		// then darkens the edges. target has the bounds of source and may be the same frame.
+		void Apply(const execution_policy& policy, const array_view<const Pixel, 2>& source, const array_view<Pixel, 2>& target, int phases, int neighbourWindow)
+		{
+			ApplyColorSimplifier(policy, source, phases, neighbourWindow);
+			ApplyEdgeDetection(policy, source, target);
+		}
+
+		// The result stays in the filters for ApplyEdgeDetection
+		void ApplyColorSimplifier(const execution_policy& policy, const array_view<const Pixel, 2>& source, int phases, int neighbourWindow)
+		{
+			auto bnd = source.bounds();
+			m_Tones.resize(bnd.size());
+			m_Simplified.resize(bnd.size());
+			array_view<TonePixel, 2> tones(bnd, m_Tones);
+			array_view<TonePixel, 2> simplified(bnd, m_Simplified);
+
+			std::experimental::parallel::transform(policy, source, tones, [](const Pixel& p) {
+				return TonePixel(p.r, p.g, p.b);
+			});
+			// The pixels too close to the border for a full window keep their colors
+			std::experimental::parallel::copy(policy, std::begin(m_Tones), std::end(m_Tones), std::begin(m_Simplified));
+
+			ColorSimplifier simplifier = { neighbourWindow / 2 };
+			std::experimental::parallel::stencil(policy, array_view<const TonePixel, 2>(tones), simplified, neighbourWindow / 2, static_cast<size_t>(phases), simplifier);
+		}
+
+		void ApplyEdgeDetection(const execution_policy& policy, const array_view<const Pixel, 2>& source, const array_view<Pixel, 2>& target)
+		{
+			using std::experimental::D4087::index;
+
+			auto bnd = source.bounds();
+			m_Samples.resize(bnd.size());
+			m_Edges.assign(bnd.size(), 0.0f);
+			array_view<const TonePixel, 2> simplified(bnd, m_Simplified);
+			array_view<EdgeSample, 2> samples(bnd, m_Samples);
+			array_view<float, 2> edges(bnd, m_Edges);
+
+			// Luma and chroma of both frames, converted once instead of at every Sobel window around a pixel
+			std::experimental::parallel::for_each(policy, std::begin(bnd), std::end(bnd), [&](index<2> idx) {
+				const TonePixel& tone = simplified[idx];
+				const Pixel& original = source[idx];
+				float* yuv = samples[idx].yuv;
+				RGBToYUV(tone.r, tone.g, tone.b, yuv[0], yuv[1], yuv[2]);
+				RGBToYUV(original.r, original.g, original.b, yuv[3], yuv[4], yuv[5]);
+			});
+
+			// The border has no edges
+			std::experimental::parallel::stencil(policy, array_view<const EdgeSample, 2>(samples), edges, 1, EdgeDetector());
+
+			std::experimental::parallel::for_each(policy, std::begin(bnd), std::end(bnd), [&](index<2> idx) {
+				const TonePixel& clr = simplified[idx];
+				float oneMinusi = 1 - edges[idx];
+				Pixel& out = target[idx];
+				out.r = static_cast<uint8_t>(clr.r * oneMinusi);
+				out.g = static_cast<uint8_t>(clr.g * oneMinusi);
+				out.b = static_cast<uint8_t>(clr.b * oneMinusi);
+			});
+		}
+
+	private:
+		std::vector<TonePixel> m_Tones;
+		std::vector<TonePixel> m_Simplified;
+		std::vector<EdgeSample> m_Samples;
+		std::vector<float> m_Edges;
+	};
+}
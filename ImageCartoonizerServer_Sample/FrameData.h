@@ -1,7 +1,8 @@
 #pragma once
 
-#include <experimental\coordinate>
-#include <experimental\algorithm>
+#include <experimental/coordinate>
+#include <experimental/algorithm>
+#include "CartoonizerFilters.h"
 
 using namespace concurrency;
 using namespace std;
@@ -69,33 +70,14 @@ public:
 	
 
 public: //methods
-    void ApplyColorSimplifier(ReportProgressCallback progressCallback);
     void ApplyColorSimplifier(int nPhases,ReportProgressCallback progressCallback);
-    void ApplyColorSimplifier(unsigned int startHeight, unsigned int endHeight, unsigned int startWidth, unsigned int endWidth, ReportProgressCallback progressCallback);
-    void SimplifyIndexOptimized(BYTE* pFrame, int x, int y);
     void ApplyEdgeDetection(ReportProgressCallback progressCallback);
-    void ApplyEdgeDetectionParallel(unsigned int startHeight, unsigned int endHeight, unsigned int startWidth, unsigned int endWidth,ReportProgressCallback progressCallback);
-    void CalculateSobel(BYTE* pSource, int row, int column, float& dy, float& du, float& dv);
 
 public:
-    static inline COLORREF GetPixel(BYTE* pFrame, int x, int y, int pitch, int bpp)
-    {
-        int width = abs((int)pitch);
-        int bytesPerPixel = bpp / 8;
-        int byteIndex = y * width + x * bytesPerPixel;
-        return RGB(pFrame[byteIndex + 2], 
-            pFrame[byteIndex + 1],
-            pFrame[byteIndex]);
-    }
-    static inline void SetPixel(BYTE* pFrame, int x, int y, int pitch, int bpp, COLORREF color)
-    {
-        int width = abs((int)pitch);
-        int bytesPerPixel = bpp / 8;
-        int byteIndex = y * width + x * bytesPerPixel;
-        pFrame[byteIndex + 2] = GetRValue(color);
-        pFrame[byteIndex + 1] = GetGValue(color);
-        pFrame[byteIndex] = GetBValue(color);
-    }
+	// Copies between the frame, m_Pitch bytes per row and m_BPP bits per pixel, and pixels stored row after row
+	void UnpackFrame(const BYTE* pFrame, std::vector<Cartoonizer::Pixel>& pixels);
+	void PackFrame(const std::vector<Cartoonizer::Pixel>& pixels, BYTE* pFrame);
+
 	parallel::execution_policy execPolicy = parallel::seq;
 	
 
@@ -113,6 +95,10 @@ private: //members
     int m_Pitch;
     unsigned int m_BPP;
     unsigned int m_ColorPlanes;
+
+	std::vector<Cartoonizer::Pixel> m_CurrentPixels;
+	std::vector<Cartoonizer::Pixel> m_BufferPixels;
+	Cartoonizer::FrameFilters m_Filters;
 	
 
     // Progress tracking data:
@@ -11,10 +11,6 @@
 #include "pch.h"
 #include "FrameData.h"
 
-const double Util::Wr = 0.299;
-const double Util::Wb = 0.114;
-const double Util::wg = 1 - Util::Wr - Util::Wb;
-
 FrameProcessing::FrameProcessing()
 {
 	m_Size = 0;
@@ -43,11 +39,8 @@ void FrameProcessing::ApplyFilters(int nPhases, bool isParallel, ReportProgressC
 	if (isParallel) execPolicy = parallel::par;
 	else execPolicy = parallel::seq;
 
-	// ColorSimplifier work:
-	m_totalCompletion = nPhases * (m_Height - m_NeighborWindow);
-
-	// EdgeDetection work:
-	m_totalCompletion += m_Height - 2;
+	// ColorSimplifier work, one unit per phase, and EdgeDetection work:
+	m_totalCompletion = nPhases + 1;
 
 	m_lastReportedCompletion = 0;
 	m_workDone = 0;
@@ -91,170 +84,66 @@ void FrameProcessing::SetCurrentFrame(BYTE* pFrame, unsigned int size, int width
 	memcpy_s(m_pCurrentImage, size, pFrame, size);
 	memcpy_s(m_pBufferImage, size, pFrame, size);
 	m_Size = size;
+
+	UnpackFrame(m_pCurrentImage, m_CurrentPixels);
 }
 
+// The phases run one after the other, each one on the result of the previous one, and the stencil keeps a tile in
+// the cache for all of them
 void FrameProcessing::ApplyColorSimplifier(int nPhases, ReportProgressCallback progressCallback)
 {
-	bounds<1> bnd(nPhases);
-	std::experimental::parallel::for_each(execPolicy, begin(bnd), end(bnd), [&](index<1> /*idx*/)
-	{
-		ApplyColorSimplifier(progressCallback);
-	});
+	bounds<2> bnd{ (int __w64)m_Height, (int __w64)m_Width };
+	m_Filters.ApplyColorSimplifier(execPolicy, array_view<const Cartoonizer::Pixel, 2>(bnd, m_CurrentPixels), nPhases, m_NeighborWindow);
 
+	for (int phase = 0; phase < nPhases; ++phase)
+		UpdateProgress(progressCallback);
 }
 
-void FrameProcessing::ApplyColorSimplifier(ReportProgressCallback progressCallback)
+void FrameProcessing::ApplyEdgeDetection(ReportProgressCallback progressCallback)
 {
-	unsigned int shift = m_NeighborWindow / 2;
+	bounds<2> bnd{ (int __w64)m_Height, (int __w64)m_Width };
+	m_BufferPixels.resize(bnd.size());
+	m_Filters.ApplyEdgeDetection(execPolicy, array_view<const Cartoonizer::Pixel, 2>(bnd, m_CurrentPixels), array_view<Cartoonizer::Pixel, 2>(bnd, m_BufferPixels));
 
-	ApplyColorSimplifier(shift, (m_Height - shift), shift, (m_Width - shift), progressCallback);
+	PackFrame(m_BufferPixels, m_pBufferImage);
+	UpdateProgress(progressCallback);
 }
 
-void FrameProcessing::ApplyColorSimplifier(unsigned int startHeight, unsigned int endHeight, unsigned int startWidth, unsigned int endWidth, ReportProgressCallback progressCallback)
+void FrameProcessing::UnpackFrame(const BYTE* pFrame, std::vector<Cartoonizer::Pixel>& pixels)
 {
-	std::mutex progressCritSec;
-	
-	bounds<2> bnd{ (int __w64)(endWidth - startWidth), (int __w64)(endHeight - startHeight) }; //creates bounds matrix of size width x height
-
-	if (NULL != m_pBufferImage)
+	int bytesPerPixel = m_BPP / 8;
+	pixels.resize(m_Width * m_Height);
+	for (unsigned int y = 0; y < m_Height; ++y)
 	{
-		std::experimental::parallel::for_each(execPolicy, begin(bnd), end(bnd), [&](index<2> idx)
+		const BYTE* pRow = pFrame + y * abs(m_Pitch);
+		for (unsigned int x = 0; x < m_Width; ++x, pRow += bytesPerPixel)
 		{
-			SimplifyIndexOptimized(m_pBufferImage, static_cast<int>(idx[0]) + startWidth, static_cast<int>(idx[1]) + startHeight);
-			if (idx[1] == 0)
-			{
-				std::lock_guard<std::mutex> lockHolder(progressCritSec);
-				UpdateProgress(progressCallback);
-			}
-
-		});
-
+			Cartoonizer::Pixel& pixel = pixels[y * m_Width + x];
+			// Gray frames have one byte per pixel
+			pixel.b = pRow[0];
+			pixel.g = bytesPerPixel > 1 ? pRow[1] : pRow[0];
+			pixel.r = bytesPerPixel > 2 ? pRow[2] : pRow[0];
+		}
 	}
 }
 
-void FrameProcessing::SimplifyIndexOptimized(BYTE* pFrame, int x, int y)
+void FrameProcessing::PackFrame(const std::vector<Cartoonizer::Pixel>& pixels, BYTE* pFrame)
 {
-	COLORREF orgClr = GetPixel(pFrame, x, y, m_Pitch, m_BPP);
-
-	int shift = m_NeighborWindow / 2;
-	double sSum = 0;
-	double partialSumR = 0, partialSumG = 0, partialSumB = 0;
-	double standardDeviation = 0.025;
-
-	for (int j = y - shift; j <= (y + shift); ++j)
+	int bytesPerPixel = m_BPP / 8;
+	for (unsigned int y = 0; y < m_Height; ++y)
 	{
-		for (int i = x - shift; i <= (x + shift); ++i)
+		BYTE* pRow = pFrame + y * abs(m_Pitch);
+		for (unsigned int x = 0; x < m_Width; ++x, pRow += bytesPerPixel)
 		{
-			if (i != x || j != y) // don't apply filter to the requested index, only to the neighbors
+			const Cartoonizer::Pixel& pixel = pixels[y * m_Width + x];
+			pRow[0] = pixel.b;
+			if (bytesPerPixel > 2)
 			{
-				COLORREF clr = GetPixel(pFrame, i, j, m_Pitch, m_BPP);
-				/*int index = (j - (y - shift)) * m_NeighborWindow + i - (x - shift);*/
-				double distance = Util::GetDistance(orgClr, clr);
-				double sValue = pow(M_E, -0.5 * pow(distance / standardDeviation, 2));
-				sSum += sValue;
-				partialSumR += GetRValue(clr) * sValue;
-				partialSumG += GetGValue(clr) * sValue;
-				partialSumB += GetBValue(clr) * sValue;
+				pRow[1] = pixel.g;
+				pRow[2] = pixel.r;
 			}
 		}
 	}
-
-	COLORREF simplifiedClr;
-	int simpleRed, simpleGreen, simpleBlue;
-
-	simpleRed = (int)min(max(partialSumR / sSum, 0), 255);
-	simpleGreen = (int)min(max(partialSumG / sSum, 0), 255);
-	simpleBlue = (int)min(max(partialSumB / sSum, 0), 255);
-	simplifiedClr = RGB(simpleRed, simpleGreen, simpleBlue);
-	SetPixel(m_pBufferImage, x, y, m_Pitch, m_BPP, simplifiedClr);
-}
-
-void FrameProcessing::ApplyEdgeDetection(ReportProgressCallback progressCallback)
-{
-	ApplyEdgeDetectionParallel(1, (m_Height - 1), 1, (m_Width - 1), progressCallback);
-}
-
-void FrameProcessing::ApplyEdgeDetectionParallel(unsigned int startHeight, unsigned int endHeight, unsigned int startWidth, unsigned int endWidth, ReportProgressCallback progressCallback)
-{
-	const float alpha = 0.3f;
-	const float beta = 0.8f;
-	const float s0 = 0.054f;
-	const float s1 = 0.064f;
-	const float a0 = 0.3f;
-	const float a1 = 0.7f;
-
-	BYTE* pFrame = new BYTE[m_Size];
-	memcpy_s(pFrame, m_Size, m_pBufferImage, m_Size);
-
-	std::mutex progressCritSec;
-	
-	bounds<2> bnd{ (int __w64)(endHeight - startHeight), (int __w64)(endWidth - startWidth) }; //creates bounds matrix of size height x width
-
-	std::experimental::parallel::for_each(execPolicy, begin(bnd), end(bnd), [&](index<2> idx)
-	{
-		int y = static_cast<int>(idx[0]) + startHeight;
-		int x = static_cast<int>(idx[1]) + startWidth;
-		float Sy, Su, Sv;
-		float Ay, Au, Av;
-
-		CalculateSobel(m_pBufferImage, x, y, Sy, Su, Sv);
-		CalculateSobel(m_pCurrentImage, x, y, Ay, Au, Av);
-
-		float edgeS = (1 - alpha) * Sy +
-			alpha * (Su + Sv) / 2;
-
-		float edgeA = (1 - alpha) * Ay +
-			alpha * (Au + Av) / 2;
-
-		float i = (1 - beta) * Util::SmoothStep(s0, s1, edgeS)
-			+ beta * Util::SmoothStep(a0, a1, edgeA);
-
-		float oneMinusi = 1 - i;
-		COLORREF clr = this->GetPixel(m_pBufferImage, x, y, m_Pitch, m_BPP);
-		COLORREF newClr = RGB(GetRValue(clr) * oneMinusi, GetGValue(clr) * oneMinusi, GetBValue(clr) * oneMinusi);
-		this->SetPixel(pFrame, x, y, m_Pitch, m_BPP, newClr);
-
-		if (idx[1] == 0)
-		{
-			std::lock_guard<std::mutex> lockHolder(progressCritSec);
-			UpdateProgress(progressCallback);
-		}
-	});
-
-
-	memcpy_s(m_pBufferImage, m_Size, pFrame, m_Size);
-	delete[] pFrame;
-}
-
-void FrameProcessing::CalculateSobel(BYTE* pSource, int row, int column, float& dy, float& du, float& dv)
-{
-	int gx[3][3] = { { -1, 0, 1 }, { -2, 0, 2 }, { -1, 0, 1 } };   //  The matrix Gx
-	int gy[3][3] = { { 1, 2, 1 }, { 0, 0, 0 }, { -1, -2, -1 } };  //  The matrix Gy
-
-	double new_yX = 0, new_yY = 0;
-	double new_uX = 0, new_uY = 0;
-	double new_vX = 0, new_vY = 0;
-	for (int i = -1; i < 2; i++)
-	{
-		for (int j = -1; j < 2; j++)
-		{
-			double y, u, v;
-			Util::RGBToYUV(GetPixel(pSource, row + i, column + j, m_Pitch, m_BPP), y, u, v);
-
-			new_yX += gx[i + 1][j + 1] * y;
-			new_yY += gy[i + 1][j + 1] * y;
-
-			new_uX += gx[i + 1][j + 1] * u;
-			new_uY += gy[i + 1][j + 1] * u;
-
-			new_vX += gx[i + 1][j + 1] * v;
-			new_vY += gy[i + 1][j + 1] * v;
-		}
-	}
-
-	dy = (float)sqrt(pow(new_yX, 2) + pow(new_yY, 2));
-	du = (float)sqrt(pow(new_uX, 2) + pow(new_uY, 2));
-	dv = (float)sqrt(pow(new_vX, 2) + pow(new_vY, 2));
 }
 
 void FrameProcessing::UpdateProgress(ReportProgressCallback progressCallback)
@@ -10,5 +10,4 @@
 #include <windows.h>
 #include <wincodec.h>
 #include <ppltasks.h>
-#include "Utils.h"
 #include "FrameData.h"
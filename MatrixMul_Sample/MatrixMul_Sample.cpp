@@ -1,12 +1,15 @@
 #include "stdafx.h"
 #include <experimental/algorithm>
 #include <experimental/coordinate>
+#include <experimental/array_view>
+#include <cmath>
 #include <random>
 
 using namespace std::experimental::D4087;
 
+// Prints the time f takes and the rate of floating point operations it reaches, returns the time in seconds
 template<typename F>
-void measure_time(F&& f, const char* name)
+double measure_time(F&& f, const char* name, double flops)
 {
 	using namespace std::chrono;
 
@@ -14,9 +17,17 @@ void measure_time(F&& f, const char* name)
 	f();
 	auto end = high_resolution_clock::now();
 
-	printf("%s %llu.%03llu seconds\n", name,
-		duration_cast<seconds>(end - begin).count(),
-		duration_cast<milliseconds>(end - begin).count() % 1000);
+	double seconds = duration_cast<duration<double>>(end - begin).count();
+	printf("%-26s %8.3f seconds  %7.2f GFLOP/s\n", name, seconds, flops / (seconds * 1e9));
+	return seconds;
+}
+
+double max_difference(const std::vector<double>& vLeft, const std::vector<double>& vRight)
+{
+	double diff = 0;
+	for (size_t i = 0; i < vLeft.size(); ++i)
+		diff = (std::max)(diff, std::abs(vLeft[i] - vRight[i]));
+	return diff;
 }
 
 void multiply_element(const index<2>& idx, const std::vector<double>& vA, const std::vector<double>& vB, std::vector<double>& vResult, int N)
@@ -49,27 +60,36 @@ void test_matrix_multiplication(int N)
 	std::generate(std::begin(vA), std::end(vA), [&generator, &dist](){ return dist(generator); }); //double distribution
 	std::generate(std::begin(vB), std::end(vB), [&generator, &dist](){ return dist(generator); });
 
-	measure_time([&]() mutable
-	{
-		bounds<2> bnd{ N, N };
-		std::vector<double> vResult(bnd.size());
+	// A multiply and an add for every element of the result and every step of the dot product
+	const double flops = 2.0 * N * N * N;
+	bounds<2> bnd{ N, N };
+	std::vector<double> vExpected(bnd.size()), vResult(bnd.size());
 
+	double serial = measure_time([&]() mutable
+	{
 		// Using serial implementation
 		std::for_each(std::begin(bnd), std::end(bnd), [&](index<2> idx) {
-			multiply_element(idx, vA, vB, vResult, N);
+			multiply_element(idx, vA, vB, vExpected, N);
 		});
-	}, "serial:       ");
+	}, "serial:", flops);
 
-	measure_time([&]() mutable
+	double parallel = measure_time([&]() mutable
 	{
-		bounds<2> bnd{ N, N };
-		std::vector<double> vResult(bnd.size());
-
 		// Using Parallel STL implementation
 		std::experimental::parallel::for_each(std::experimental::parallel::par, std::begin(bnd), std::end(bnd), [&](index<2> idx)	{
 			multiply_element(idx, vA, vB, vResult, N);
 		});
-	}, "parallel STL: ");
+	}, "parallel STL:", flops);
+
+	double blocked = measure_time([&]() mutable
+	{
+		// Packed panels, vector micro-kernels and tiles of the result in parallel
+		std::experimental::parallel::matrix_multiply(std::experimental::parallel::par,
+			array_view<const double, 2>(bnd, vA), array_view<const double, 2>(bnd, vB), array_view<double, 2>(bnd, vResult));
+	}, "parallel matrix_multiply:", flops);
+
+	printf("matrix_multiply speedup: %.2fx vs serial, %.2fx vs parallel STL, max difference %g\n",
+		serial / blocked, parallel / blocked, max_difference(vExpected, vResult));
 }
 
 int _tmain(int /* argc */, _TCHAR* /* argv */[])
@@ -46,6 +46,12 @@ int test_sort(int size)
 		concurrency::parallel_sort(v.begin(), v.end());
 	}, "PPL:          ");
 
+	// Using PPL radix sort implementation
+	measure_time([v]() mutable 
+	{
+		concurrency::parallel_radixsort(v.begin(), v.end());
+	}, "PPL radix:    ");
+
 	return 0;
 }
  
@@ -7,10 +7,10 @@
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace utils;
 
-#include <experimental\algorithm>
-#include <experimental\numeric>
-#include <experimental\memory>
-#include <experimental\coordinate>
+#include <experimental/algorithm>
+#include <experimental/numeric>
+#include <experimental/memory>
+#include <experimental/coordinate>
 
 using namespace std::experimental::parallel;
 using namespace std;
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <type_traits>
 #include <chrono>
+#include <cstdlib>
 #include <CppUnitTest.h>
 // GLUE macro
 #define GLUE2(A, B) A ## B
@@ -342,6 +343,24 @@ public:
 #endif
 	}
 
+	// Calls _Check(size, _Val, _Other) over contiguous elements of every width the vector kernels handle, for sizes
+	// around the vector widths and across several blocks of the kernels. The integral values are the same for every
+	// algorithm, the floating point ones put NaN or -0.0 on the side the algorithm has to tell apart.
+	template<typename _Checker>
+	void run_vector_kernels(_Checker _Check, float _Float_val, float _Float_other, double _Double_val, double _Double_other)
+	{
+		const size_t sizes[] = { 1, 15, 31, 33, 100, 4096 + 7, static_cast<size_t>(100000 + rand() % 1000) };
+		for (auto size : sizes)
+		{
+			_Check(size, '\n', 'a');
+			_Check(size, static_cast<short>(-1), static_cast<short>(7));
+			_Check(size, -5, 5);
+			_Check(size, 1ull << 40, 1ull);
+			_Check(size, _Float_val, _Float_other);
+			_Check(size, _Double_val, _Double_other);
+		}
+	}
+
 	struct CustomException {};
 
 	// Helper counts destructions and constructions of the object
@@ -117,5 +117,38 @@ namespace ParallelSTL_Tests
 			std::vector<int> vec_two_negative = { 3, 4 };
 			Assert::IsTrue(adjacent_find(seq, std::begin(vec_two_negative), std::end(vec_two_negative)) == std::end(vec_two_negative));
 		}
+
+		// Contiguous arithmetic elements, par_vec runs the vector kernels
+		struct AdjacentFindVectorKernelCheck
+		{
+			template<typename _Ty>
+			void operator()(size_t size, _Ty _Val, _Ty _Other) const
+			{
+				if (size < 2)
+					return;
+
+				std::vector<_Ty> vec(size);
+				for (size_t i = 0; i < size; ++i)
+					vec[i] = i % 2 == 0 ? _Val : _Other;
+
+				Assert::IsTrue(adjacent_find(par_vec, std::begin(vec), std::end(vec)) == std::end(vec));
+
+				for (size_t pos : { size - 2, size / 3, static_cast<size_t>(0) })
+				{
+					vec[pos + 1] = vec[pos];
+					Assert::AreEqual(pos, static_cast<size_t>(std::distance(std::begin(vec), adjacent_find(par_vec, std::begin(vec), std::end(vec)))));
+					Assert::IsTrue(adjacent_find(par_vec, vec.data(), vec.data() + size) == vec.data() + pos);
+				}
+			}
+		};
+
+		TEST_METHOD(AdjacentFindVectorKernels)
+		{
+			utils::run_vector_kernels(AdjacentFindVectorKernelCheck(), 0.0f, 1.5f, 2.5, -2.5);
+
+			// NaN is not equal to itself
+			std::vector<float> nans(100, std::numeric_limits<float>::quiet_NaN());
+			Assert::IsTrue(adjacent_find(par_vec, std::begin(nans), std::end(nans)) == std::end(nans));
+		}
 	};
 } // ParallelSTL_Tests
@@ -303,6 +303,23 @@ namespace ParallelSTL_Tests
 			RunCopyIf<input_iterator_tag, output_iterator_tag>();
 		}
 
+		TEST_METHOD(CopyIfMaskWords)
+		{
+			// Sizes around the 64 element words of the predicate mask, with empty, partial and full words
+			for (size_t _Size : { 1, 63, 64, 65, 1000, 100003 })
+			{
+				std::vector<size_t> _Vec(_Size), _Out(_Size, 0), _Expected;
+				std::iota(std::begin(_Vec), std::end(_Vec), 0);
+
+				auto _Pred = [](size_t _Val) { return (_Val / 64) % 3 == 0 || _Val % 7 == 0; };
+				std::copy_if(std::begin(_Vec), std::end(_Vec), std::back_inserter(_Expected), _Pred);
+
+				auto _Iter = copy_if(par, std::begin(_Vec), std::end(_Vec), std::begin(_Out), _Pred);
+				Assert::AreEqual(_Expected.size(), static_cast<size_t>(std::distance(std::begin(_Out), _Iter)));
+				Assert::IsTrue(std::equal(std::begin(_Expected), std::end(_Expected), std::begin(_Out)));
+			}
+		}
+
 		TEST_METHOD(CopyIfEdgeCases)
 		{
 			// Empty destination & source
@@ -96,5 +96,30 @@ namespace ParallelSTL_Tests
 			RunCountIf<forward_iterator_tag>();
 			RunCountIf<input_iterator_tag>();
 		}
+
+		// Contiguous arithmetic elements, par_vec runs the vector kernels
+		struct CountVectorKernelCheck
+		{
+			template<typename _Ty>
+			void operator()(size_t size, _Ty _Val, _Ty _Other) const
+			{
+				std::vector<_Ty> vec(size, _Other);
+				for (size_t i = 0; i < size; i += 1 + rand() % 5)
+					vec[i] = _Val;
+
+				const auto expected = std::count(std::begin(vec), std::end(vec), _Val);
+				Assert::AreEqual(expected, count(par_vec, std::begin(vec), std::end(vec), _Val));
+				Assert::AreEqual(expected, count(par_vec, vec.data(), vec.data() + size, _Val));
+			}
+		};
+
+		TEST_METHOD(CountVectorKernels)
+		{
+			utils::run_vector_kernels(CountVectorKernelCheck(), 0.0f, std::numeric_limits<float>::quiet_NaN(), 2.5, -2.5);
+
+			std::vector<unsigned char> bytes(1000, 255);
+			Assert::AreEqual(1000, static_cast<int>(count(par_vec, std::begin(bytes), std::end(bytes), 255)));
+			Assert::AreEqual(0, static_cast<int>(count(par_vec, std::begin(bytes), std::end(bytes), -1)));
+		}
 	};
 } // ParallelSTL_Tests
@@ -203,5 +203,35 @@ namespace ParallelSTL_Tests
 			RunEqualElementPredicate4Params<forward_iterator_tag>(false);
 			RunEqualElementPredicate4Params<input_iterator_tag>(false);
 		}
+
+		// Contiguous arithmetic elements, par_vec runs the vector kernels
+		struct EqualVectorKernelCheck
+		{
+			template<typename _Ty>
+			void operator()(size_t size, _Ty _Val, _Ty _Other) const
+			{
+				std::vector<_Ty> vec(size, _Other), vec2(size, _Other);
+				Assert::IsTrue(equal(par_vec, std::begin(vec), std::end(vec), std::begin(vec2)));
+				Assert::IsTrue(equal(par_vec, vec.data(), vec.data() + size, vec2.data(), vec2.data() + size));
+
+				for (size_t pos : { static_cast<size_t>(0), size / 3, size - 1 })
+				{
+					vec2[pos] = _Val;
+					Assert::IsFalse(equal(par_vec, std::begin(vec), std::end(vec), std::begin(vec2)));
+					Assert::IsFalse(equal(par_vec, std::begin(vec), std::end(vec), std::begin(vec2), std::end(vec2)));
+					vec2[pos] = _Other;
+				}
+			}
+		};
+
+		TEST_METHOD(EqualVectorKernels)
+		{
+			utils::run_vector_kernels(EqualVectorKernelCheck(), 1.5f, -0.0f, std::numeric_limits<double>::quiet_NaN(), 2.5);
+
+			// Unlike a comparison of the bytes, -0.0 equals 0.0 and NaN equals nothing
+			std::vector<double> zeros(100, 0.0), negative_zeros(100, -0.0), nans(100, std::numeric_limits<double>::quiet_NaN());
+			Assert::IsTrue(equal(par_vec, std::begin(zeros), std::end(zeros), std::begin(negative_zeros)));
+			Assert::IsFalse(equal(par_vec, std::begin(nans), std::end(nans), std::begin(nans)));
+		}
 	};
 } // ParallelSTL_Tests
@@ -1,6 +1,6 @@
 #include "stdafx.h"
 
-#include <experimental\exception>
+#include <experimental/exception>
 
 namespace ParallelSTL_Tests
 {
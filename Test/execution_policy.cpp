@@ -1,5 +1,5 @@
 #include "stdafx.h"
-#include <experimental\execution_policy>
+#include <experimental/execution_policy>
 
 namespace ParallelSTL_Tests
 {
@@ -79,6 +79,21 @@ namespace ParallelSTL_Tests
 			RunFillN<output_iterator_tag>();
 		}
 
+		TEST_METHOD(FillArrayView)
+		{
+			using namespace std::experimental::D4087;
+			std::vector<int> _Vec(100 * 64);
+			array_view<int, 2> _Av({ 100, 64 }, _Vec);
+
+			fill(seq, _Av, 1);
+			Assert::IsTrue(std::all_of(std::begin(_Vec), std::end(_Vec), [](int _El) { return _El == 1; }));
+
+			fill(par, _Av.section({ 50, 0 }), 2);
+			fill(par_vec, strided_array_view<int, 2>({ 100, 16 }, { 64, 4 }, _Vec.data()), 3);
+			for (size_t _I = 0; _I < _Vec.size(); ++_I)
+				Assert::AreEqual(_I % 4 == 0 ? 3 : (_I >= 50 * 64 ? 2 : 1), _Vec[_I]);
+		}
+
 		template<typename _IterCat>
 		void RunUninitializedFill()
 		{
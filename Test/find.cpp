@@ -443,5 +443,39 @@ namespace ParallelSTL_Tests
 			// Find the last element in the chunk
 			Assert::IsTrue(static_cast<size_t>(std::distance(std::begin(vec), _It)) == (_Pos + (MATCH_ELEMENTS * 2)));
 		}
+
+		// Contiguous arithmetic elements, par_vec runs the vector kernels
+		struct FindVectorKernelCheck
+		{
+			template<typename _Ty>
+			void operator()(size_t size, _Ty _Val, _Ty _Other) const
+			{
+				std::vector<_Ty> vec(size, _Other);
+				Assert::IsTrue(find(par_vec, std::begin(vec), std::end(vec), _Val) == std::end(vec));
+
+				for (size_t pos : { size - 1, size / 2, size / 3, static_cast<size_t>(0) })
+				{
+					vec[pos] = _Val;
+					Assert::AreEqual(pos, static_cast<size_t>(std::distance(std::begin(vec), find(par_vec, std::begin(vec), std::end(vec), _Val))));
+					Assert::IsTrue(find(par_vec, vec.data(), vec.data() + size, _Val) == vec.data() + pos);
+				}
+			}
+		};
+
+		TEST_METHOD(FindVectorKernels)
+		{
+			utils::run_vector_kernels(FindVectorKernelCheck(), -0.0f, 1.5f, 2.5, std::numeric_limits<double>::quiet_NaN());
+
+			std::vector<float> zeros(1000, 1.0f);
+			zeros[300] = 0.0f;
+			Assert::IsTrue(find(par_vec, std::begin(zeros), std::end(zeros), -0.0f) == std::begin(zeros) + 300);
+
+			// A value of another integral type, and values no element can be equal to
+			std::vector<unsigned char> bytes(1000, 1);
+			bytes[700] = 255;
+			Assert::IsTrue(find(par_vec, std::begin(bytes), std::end(bytes), 255) == std::begin(bytes) + 700);
+			Assert::IsTrue(find(par_vec, std::begin(bytes), std::end(bytes), 257) == std::end(bytes));
+			Assert::IsTrue(find(par_vec, std::begin(bytes), std::end(bytes), -1) == std::end(bytes));
+		}
 	};
 } // ParallelSTL_Tests
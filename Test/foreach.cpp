@@ -163,6 +163,27 @@ namespace ParallelSTL_Tests
 			//}
 		}
 
+		TEST_METHOD(ForEachImplNoEmptyChunks)
+		{
+			// Every chunk covers at least one element, on a single core as well. The auto partitioner used to
+			// leave an empty last chunk there, and reduce read the first element of each chunk.
+			std::vector<int> _Ct(1000);
+
+			for (size_t _Chunk_size : { size_t{ 0 }, size_t{ 1 }, size_t{ 7 }, size_t{ 999 }, size_t{ 1000 } }) {
+				std::atomic<size_t> _Elements(0), _Empty(0);
+
+				details::_Partitioner<details::auto_partitioner_tag>::_For_Each(std::begin(_Ct), _Ct.size(), &_Empty,
+					[&_Elements](std::vector<int>::iterator, size_t _Count, std::atomic<size_t> *_Empty_count) {
+					_Elements += _Count;
+					if (_Count == 0)
+						++*_Empty_count;
+				}, _Chunk_size);
+
+				Assert::AreEqual(_Ct.size(), _Elements.load());
+				Assert::AreEqual(size_t{ 0 }, _Empty.load());
+			}
+		}
+
 		template<typename _IterCat>
 		void RunForEach()
 		{
@@ -249,6 +270,118 @@ namespace ParallelSTL_Tests
 			RunForEachThrow<input_iterator_tag>();		
 		}
 
+		template<int _Rank, typename _Loop>
+		void RunForEachBounds(const std::experimental::D4087::bounds<_Rank>& _Bnd, _Loop _Run)
+		{
+			using namespace std::experimental::D4087;
+			std::vector<std::atomic<int>> _Visits(_Bnd.size());
+			for (auto& _V : _Visits)
+				_V = 0;
+
+			_Run([&](const index<_Rank>& _Idx) {
+				ptrdiff_t _Pos = 0;
+				for (int _I = 0; _I < _Rank; ++_I)
+				{
+					Assert::IsTrue(_Idx[_I] >= 0 && _Idx[_I] < _Bnd[_I]);
+					_Pos = _Pos * _Bnd[_I] + _Idx[_I];
+				}
+				++_Visits[_Pos];
+			});
+
+			Assert::IsTrue(std::all_of(std::begin(_Visits), std::end(_Visits), [](const std::atomic<int>& _V) { return _V == 1; }));
+		}
+
+		TEST_METHOD(ForEachBounds)
+		{
+			using namespace std::experimental::D4087;
+			const bounds<2> _Bnds2[] = { { 1000, 1000 }, { 3, 5000 }, { 5000, 3 }, { 1, 1 } };
+			for (auto& _Bnd : _Bnds2)
+			{
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each(seq, std::begin(_Bnd), std::end(_Bnd), _Func); });
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each(par, std::begin(_Bnd), std::end(_Bnd), _Func); });
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each(par_vec, std::begin(_Bnd), std::end(_Bnd), _Func); });
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each(execution_policy(par), std::begin(_Bnd), std::end(_Bnd), _Func); });
+			}
+
+			const bounds<3> _Bnd3 = { 17, 300, 41 };
+			RunForEachBounds(_Bnd3, [&](std::function<void(const index<3>&)> _Func) { for_each(par, std::begin(_Bnd3), std::end(_Bnd3), _Func); });
+
+			// Parts of the bounds go through the generic loop
+			const bounds<2> _Bnd = { 100, 300 };
+			const std::pair<ptrdiff_t, ptrdiff_t> _Parts[] = { { 0, 150 }, { 150, 0 }, { 150, 150 } };
+			for (auto& _Part : _Parts)
+			{
+				std::atomic<int> _Count = 0;
+				for_each(par, std::begin(_Bnd) + _Part.first, std::end(_Bnd) - _Part.second, [&](const index<2>& _Idx) {
+					const ptrdiff_t _Pos = _Idx[0] * _Bnd[1] + _Idx[1];
+					Assert::IsTrue(_Pos >= _Part.first && _Pos < static_cast<ptrdiff_t>(_Bnd.size()) - _Part.second);
+					++_Count;
+				});
+				Assert::AreEqual(static_cast<int>(_Bnd.size() - _Part.first - _Part.second), _Count.load());
+			}
+		}
+
+		TEST_METHOD(ForEachTiled)
+		{
+			using namespace std::experimental::D4087;
+			const bounds<2> _Bnd = { 1000, 777 };
+			const bounds<2> _Tiles[] = { { 0, 0 }, { 64, 64 }, { 7, 0 }, { 0, 100 }, { 1, 1 }, { 5000, 5000 } };
+			for (auto& _Tile : _Tiles)
+			{
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each_tiled(seq, _Bnd, _Tile, _Func); });
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each_tiled(par, _Bnd, _Tile, _Func); });
+				RunForEachBounds(_Bnd, [&](std::function<void(const index<2>&)> _Func) { for_each_tiled(par_vec, _Bnd, _Tile, _Func); });
+			}
+
+			const bounds<3> _Bnd3 = { 9, 70, 300 };
+			RunForEachBounds(_Bnd3, [&](std::function<void(const index<3>&)> _Func) { for_each_tiled(par, _Bnd3, bounds<3>{ 2, 0, 33 }, _Func); });
+
+			for_each_tiled(par, bounds<2>{ 0, 10 }, bounds<2>(), [](const index<2>&) { Assert::Fail(); });
+
+			// Within a tile the inner dimension runs in order, a tile here is a whole row
+			std::vector<ptrdiff_t> _Last(_Bnd[0], -1);
+			for_each_tiled(par, _Bnd, bounds<2>{ 1, _Bnd[1] }, [&](const index<2>& _Idx) {
+				Assert::IsTrue(_Last[_Idx[0]] == _Idx[1] - 1);
+				_Last[_Idx[0]] = _Idx[1];
+			});
+		}
+
+		template<typename _ExPolicy>
+		void RunForEachArrayView(const _ExPolicy& _Policy)
+		{
+			using namespace std::experimental::D4087;
+			std::vector<int> _Vec(300 * 200);
+
+			// Contiguous rows
+			array_view<int, 2> _Av({ 300, 200 }, _Vec);
+			for_each(_Policy, _Av, [](int& _El) { ++_El; });
+			Assert::IsTrue(std::all_of(std::begin(_Vec), std::end(_Vec), [](int _El) { return _El == 1; }));
+
+			// A section skips the end of every row, a strided view every other column
+			for_each(_Policy, _Av.section({ 10, 20 }, { 100, 50 }), [](int& _El) { ++_El; });
+			for_each(_Policy, strided_array_view<int, 2>({ 300, 100 }, { 200, 2 }, _Vec.data()), [](int& _El) { _El += 10; });
+			for (size_t _I = 0; _I < _Vec.size(); ++_I)
+			{
+				const size_t _Row = _I / 200, _Col = _I % 200;
+				const bool _In_section = _Row >= 10 && _Row < 110 && _Col >= 20 && _Col < 70;
+				Assert::AreEqual(1 + (_In_section ? 1 : 0) + (_Col % 2 == 0 ? 10 : 0), _Vec[_I]);
+			}
+
+			std::atomic<int> _Count = 0;
+			for_each(_Policy, array_view<const int, 3>({ 3, 100, 200 }, _Vec), [&](const int&) { ++_Count; });
+			Assert::AreEqual(static_cast<int>(_Vec.size()), _Count.load());
+
+			for_each(_Policy, array_view<int, 2>({ 0, 200 }, _Vec), [](int&) { Assert::Fail(); });
+		}
+
+		TEST_METHOD(ForEachArrayView)
+		{
+			RunForEachArrayView(seq);
+			RunForEachArrayView(par);
+			RunForEachArrayView(par_vec);
+			RunForEachArrayView(execution_policy(par));
+		}
+
 		TEST_METHOD(ForEachPerfTest)
 		{
 			Logger::WriteMessage("-----------Begin performance tests for foreach----------");
@@ -1,6 +1,9 @@
 #include "stdafx.h"
 
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace std {
 	namespace experimental {
@@ -616,5 +619,72 @@ namespace ParallelSTL_Tests
 
 			Assert::AreEqual(true, _Exception);
 		}
+
+		TEST_METHOD(CombinableMoreThreadsThanSlots)
+		{
+			// Threads beyond the worker slots end up in the overflow list and must still be combined
+			combinable<size_t> data([]{ return size_t(0); });
+			const size_t _Num = get_worker_slot_count() * 2 + 1;
+
+			// Every thread keeps running until all of them have called local(), thus none of them can hand its slot
+			// over to a later thread and all of them are alive at once
+			std::mutex _Lock;
+			std::condition_variable _Arrived, _Released;
+			size_t _Arrived_count = 0;
+			bool _Release = false;
+
+			std::vector<std::thread> _Threads;
+			for (size_t _I = 0; _I < _Num; ++_I)
+			{
+				_Threads.emplace_back([&]{
+					data.local() += 10;
+
+					std::unique_lock<std::mutex> _Guard(_Lock);
+					if (++_Arrived_count == _Num)
+						_Arrived.notify_one();
+					_Released.wait(_Guard, [&]{ return _Release; });
+				});
+			}
+
+			auto _Plus = [](size_t _Val, size_t _Val2){ return _Val + _Val2; };
+			{
+				std::unique_lock<std::mutex> _Guard(_Lock);
+				_Arrived.wait(_Guard, [&]{ return _Arrived_count == _Num; });
+				Assert::AreEqual(_Num * 10, data.combine(_Plus));
+				_Release = true;
+			}
+			_Released.notify_all();
+
+			for (auto &_Thread : _Threads)
+				_Thread.join();
+
+			combinable<size_t> _Copy(data);
+			Assert::AreEqual(_Num * 10, data.combine(_Plus));
+			Assert::AreEqual(_Num * 10, _Copy.combine(_Plus));
+
+			data.clear();
+			Assert::AreEqual(size_t(0), data.combine(_Plus));
+		}
+
+		TEST_METHOD(CombinableRecycledSlotBlock)
+		{
+			// A combinable of another type may get the slot block next, old values must not read as constructed flags
+			const size_t _Size = get_worker_slot_count() * 64;
+			void *_Block = _Acquire_slot_block(64);
+			memset(_Block, 0xff, _Size);
+			_Release_slot_block(_Block, 64);
+
+			char *_Recycled = static_cast<char *>(_Acquire_slot_block(64));
+			Assert::IsTrue(std::all_of(_Recycled, _Recycled + _Size, [](char _Byte) { return _Byte == 0; }));
+			_Release_slot_block(_Recycled, 64);
+
+			{
+				combinable<long long> _Wide;
+				_Wide.local() = -1;
+			}
+			combinable<int> _Narrow;
+			_Narrow.local() = 11;
+			Assert::AreEqual(11, _Narrow.combine(std::plus<int>()));
+		}
 	};
 } //ParallelSTL_Tests
@@ -0,0 +1,76 @@
+#include "stdafx.h"
+
+namespace ParallelSTL_Tests
+{
+	TEST_CLASS(MatrixMultiplyTest)
+	{
+		// Small integers keep every sum exact, whatever the order of the additions
+		template<typename _Ty>
+		static std::vector<_Ty> MakeMatrix(size_t _Rows, size_t _Cols, int _Seed)
+		{
+			std::vector<_Ty> _Vec(_Rows * _Cols);
+			for (size_t _I = 0; _I < _Vec.size(); ++_I)
+				_Vec[_I] = static_cast<_Ty>(static_cast<int>((_I * 7 + _Seed) % 11) - 5);
+			return _Vec;
+		}
+
+		template<typename _Ty, typename _ExPolicy>
+		void RunMatrixMultiply(_ExPolicy&& _Policy, ptrdiff_t _M, ptrdiff_t _N, ptrdiff_t _K)
+		{
+			using namespace std::experimental::D4087;
+
+			const std::vector<_Ty> _A = MakeMatrix<_Ty>(_M, _K, 1), _B = MakeMatrix<_Ty>(_K, _N, 3);
+			std::vector<_Ty> _Expected(_M * _N), _C(_M * _N, static_cast<_Ty>(99));
+			for (ptrdiff_t _Row = 0; _Row < _M; ++_Row)
+				for (ptrdiff_t _Col = 0; _Col < _N; ++_Col)
+					for (ptrdiff_t _I = 0; _I < _K; ++_I)
+						_Expected[_Row * _N + _Col] += _A[_Row * _K + _I] * _B[_I * _N + _Col];
+
+			matrix_multiply(_Policy, array_view<const _Ty, 2>({ _M, _K }, _A), array_view<const _Ty, 2>({ _K, _N }, _B), array_view<_Ty, 2>({ _M, _N }, _C));
+			Assert::IsTrue(_Expected == _C);
+		}
+
+		template<typename _Ty>
+		void RunMatrixMultiplySizes()
+		{
+			// Multiples of the micro-kernel and of the blocks, edges of every kind and a K of several blocks
+			const ptrdiff_t _Sizes[][3] = { { 64, 128, 256 }, { 1, 1, 1 }, { 3, 5, 7 }, { 67, 131, 259 }, { 200, 9, 600 }, { 5, 300, 2 }, { 0, 10, 10 }, { 10, 10, 0 } };
+			for (auto& _Size : _Sizes)
+			{
+				RunMatrixMultiply<_Ty>(seq, _Size[0], _Size[1], _Size[2]);
+				RunMatrixMultiply<_Ty>(par, _Size[0], _Size[1], _Size[2]);
+				RunMatrixMultiply<_Ty>(par_vec, _Size[0], _Size[1], _Size[2]);
+				RunMatrixMultiply<_Ty>(execution_policy(par), _Size[0], _Size[1], _Size[2]);
+			}
+		}
+
+		TEST_METHOD(MatrixMultiply)
+		{
+			RunMatrixMultiplySizes<double>();
+			RunMatrixMultiplySizes<float>();
+			RunMatrixMultiplySizes<long long>();
+		}
+
+		// Views over parts of one larger array
+		TEST_METHOD(MatrixMultiplySections)
+		{
+			using namespace std::experimental::D4087;
+
+			std::vector<double> _Big = MakeMatrix<double>(100, 100, 5), _Result(40 * 30);
+			array_view<const double, 2> _Rows({ 40, 100 }, _Big);
+			array_view<const double, 2> _Right({ 100, 30 }, &_Big[0] + 3000);
+			matrix_multiply(par, _Rows, _Right, array_view<double, 2>({ 40, 30 }, _Result));
+
+			for (ptrdiff_t _Row = 0; _Row < 40; ++_Row)
+			{
+				for (ptrdiff_t _Col = 0; _Col < 30; ++_Col)
+				{
+					double _Sum = 0;
+					for (ptrdiff_t _I = 0; _I < 100; ++_I)
+						_Sum += _Big[_Row * 100 + _I] * _Big[3000 + _I * 30 + _Col];
+					Assert::AreEqual(_Sum, _Result[_Row * 30 + _Col]);
+				}
+			}
+		}
+	};
+} // namespace ParallelSTL_Tests
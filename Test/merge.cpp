@@ -107,6 +107,25 @@ namespace ParallelSTL_Tests
 			MergeImpl(par_vec);
 		}
 
+		// Segments of the merge path must keep equivalent elements of range 1 before those of range 2
+		TEST_METHOD(MergeStable)
+		{
+			typedef std::pair<int, size_t> item;
+			auto byKey = [](const item &left, const item &right) { return left.first < right.first; };
+
+			std::vector<item> range1(100000 + rand() % 10000), range2(30000 + rand() % 10000);
+			for (size_t i = 0; i < range1.size(); ++i)
+				range1[i] = item(static_cast<int>(i * 7 / range1.size()), i);
+			for (size_t i = 0; i < range2.size(); ++i)
+				range2[i] = item(static_cast<int>(i * 7 / range2.size()), range1.size() + i);
+
+			std::vector<item> expected(range1.size() + range2.size()), result(expected.size());
+			std::merge(range1.begin(), range1.end(), range2.begin(), range2.end(), expected.begin(), byKey);
+
+			Assert::IsTrue(merge(par, range1.begin(), range1.end(), range2.begin(), range2.end(), result.begin(), byKey) == result.end());
+			Assert::IsTrue(result == expected);
+		}
+
 		TEST_METHOD(ImplaceMergeSpecial)
 		{
 			InplaceMergeImpl(seq);
@@ -291,5 +291,33 @@ namespace ParallelSTL_Tests
 			mismatch(par, _InIter, _InIter, _FwdIter, _FwdIter);
 			mismatch(par, _InIter, _InIter, _FwdIter, _FwdIter);
 		}
+
+		// Contiguous arithmetic elements, par_vec runs the vector kernels
+		struct MismatchVectorKernelCheck
+		{
+			template<typename _Ty>
+			void operator()(size_t size, _Ty _Val, _Ty _Other) const
+			{
+				std::vector<_Ty> vec(size, _Other), vec2(size, _Other);
+				auto _Res = mismatch(par_vec, std::begin(vec), std::end(vec), std::begin(vec2));
+				Assert::IsTrue(_Res.first == std::end(vec) && _Res.second == std::end(vec2));
+
+				for (size_t pos : { size - 1, size / 2, size / 3, static_cast<size_t>(0) })
+				{
+					vec2[pos] = _Val;
+					_Res = mismatch(par_vec, std::begin(vec), std::end(vec), std::begin(vec2));
+					Assert::AreEqual(pos, static_cast<size_t>(std::distance(std::begin(vec), _Res.first)));
+					Assert::AreEqual(pos, static_cast<size_t>(std::distance(std::begin(vec2), _Res.second)));
+
+					auto _Res_ptr = mismatch(par_vec, vec.data(), vec.data() + size, vec2.data(), vec2.data() + size);
+					Assert::IsTrue(_Res_ptr.first == vec.data() + pos && _Res_ptr.second == vec2.data() + pos);
+				}
+			}
+		};
+
+		TEST_METHOD(MismatchVectorKernels)
+		{
+			utils::run_vector_kernels(MismatchVectorKernelCheck(), std::numeric_limits<float>::quiet_NaN(), 1.5f, 2.5, -0.0);
+		}
 	};
 }
@@ -88,6 +88,33 @@ namespace ParallelSTL_Tests
 			}
 		}
 
+		// Large enough for the sample-select rounds, with sorted, reversed and few distinct values
+		TEST_METHOD(NthElementSampleSelect)
+		{
+			const size_t size = 300000 + rand() % 10000;
+			for (int pattern = 0; pattern < 4; ++pattern)
+			{
+				std::vector<float> vec(size);
+				for (size_t i = 0; i < size; ++i)
+					vec[i] = pattern == 0 ? static_cast<float>(rand()) : pattern == 1 ? static_cast<float>(i) : pattern == 2 ? static_cast<float>(size - i) : static_cast<float>(i % 3);
+
+				std::vector<float> expected(vec);
+				std::sort(std::begin(expected), std::end(expected));
+
+				const size_t positions[] = { 0, size / 100, size / 2, size - size / 100, size - 1 };
+				for (auto pos : positions)
+				{
+					std::vector<float> vec_tmp(vec);
+					auto nth = std::begin(vec_tmp) + pos;
+					nth_element(par, std::begin(vec_tmp), nth, std::end(vec_tmp));
+
+					Assert::AreEqual(expected[pos], *nth);
+					Assert::IsTrue(std::all_of(std::begin(vec_tmp), nth, [&](float _Val) { return _Val <= *nth; }));
+					Assert::IsTrue(std::all_of(nth, std::end(vec_tmp), [&](float _Val) { return _Val >= *nth; }));
+				}
+			}
+		}
+
 		TEST_METHOD(NthElementEdgeCases)
 		{
 			std::vector<int> vec_empty;
@@ -57,9 +57,33 @@ namespace ParallelSTL_Tests
 		TEST_METHOD(Partition)
 		{
 			RunPartition<random_access_iterator_tag>();
+			RunPartition<bidirectional_iterator_tag>();
 			RunPartition<forward_iterator_tag>();
 		}
 
+		// Several blocks of the forward partition, with the partition point inside a block and at its boundaries
+		TEST_METHOD(PartitionList)
+		{
+			const size_t sizes[] = { static_cast<size_t>(100000 + rand() % 10000), 4096, 1 };
+			for (auto size : sizes)
+			{
+				for (size_t threshold = 0; threshold <= size; threshold += size / 4 + 1)
+				{
+					std::list<size_t> lst;
+					for (size_t i = 0; i < size; ++i)
+						lst.push_back((i * 2654435761u) % size);
+
+					auto pred = [threshold](size_t _Val) { return _Val < threshold; };
+					const size_t expected = std::count_if(lst.begin(), lst.end(), pred);
+					auto result = partition(par, lst.begin(), lst.end(), pred);
+
+					Assert::AreEqual(expected, static_cast<size_t>(std::distance(lst.begin(), result)));
+					Assert::IsTrue(std::all_of(lst.begin(), result, pred));
+					Assert::IsTrue(std::none_of(result, lst.end(), pred));
+				}
+			}
+		}
+
 		TEST_METHOD(PartitionEdgeCases)
 		{
 			std::vector<int> vec_empty;
@@ -118,6 +142,36 @@ namespace ParallelSTL_Tests
 			Assert::IsTrue(stable_partition(par, std::begin(vec), std::end(vec), [](int){ return true; }) == std::end(vec));
 			Assert::IsTrue(stable_partition(par, std::begin(vec), std::end(vec), [](int){ return false; }) == std::begin(vec));
 		}
+
+		template<typename _Container>
+		void RunStablePartitionBuffer(size_t size, size_t bufferSize)
+		{
+			_Container values;
+			for (size_t i = 0; i < size; ++i)
+				values.push_back(std::make_pair(static_cast<size_t>(rand()) % 100, i));
+
+			auto pred = [](const std::pair<size_t, size_t>& val) { return val.first < 30; };
+			const size_t trues = std::count_if(std::begin(values), std::end(values), pred);
+
+			auto mid = stable_partition(par, std::begin(values), std::end(values), pred, bufferSize);
+
+			auto byIndex = [](const std::pair<size_t, size_t>& left, const std::pair<size_t, size_t>& right) { return left.second < right.second; };
+			Assert::AreEqual(trues, static_cast<size_t>(std::distance(std::begin(values), mid)));
+			Assert::IsTrue(std::all_of(std::begin(values), mid, pred));
+			Assert::IsTrue(std::none_of(mid, std::end(values), pred));
+			Assert::IsTrue(std::is_sorted(std::begin(values), mid, byIndex));
+			Assert::IsTrue(std::is_sorted(mid, std::end(values), byIndex));
+		}
+
+		TEST_METHOD(StablePartitionBuffer)
+		{
+			const size_t size = 100000;
+			for (size_t bufferSize : { (std::numeric_limits<size_t>::max)(), size / 4, static_cast<size_t>(1000), static_cast<size_t>(0) })
+			{
+				RunStablePartitionBuffer<std::vector<std::pair<size_t, size_t>>>(size, bufferSize);
+				RunStablePartitionBuffer<std::list<std::pair<size_t, size_t>>>(size, bufferSize);
+			}
+		}
 	};
 
 	TEST_CLASS(ParitionCopyTest)
@@ -114,6 +114,86 @@ namespace ParallelSTL_Tests
 			RunReduceWithCallback<input_iterator_tag>();
 		}
 
+		template<typename _IterCat>
+		void RunReduceDeterministic()
+		{
+			{
+				ReduceAlgoTest<_IterCat> _Alg;
+				_Alg.set_result(reduce(par_deterministic, _Alg.begin_in(), _Alg.end_in()));
+			}
+
+			{
+				ReduceAlgoTest<_IterCat> _Alg(INITIAL_VALUE, true);
+				_Alg.set_result(reduce(par_deterministic, _Alg.begin_in(), _Alg.end_in(), INITIAL_VALUE, _Alg.callback()));
+			}
+
+			{
+				ReduceAlgoTest<_IterCat> _Alg(INITIAL_VALUE);
+				_Alg.set_result(reduce(execution_policy(par_deterministic), _Alg.begin_in(), _Alg.end_in(), INITIAL_VALUE));
+			}
+		}
+
+		TEST_METHOD(ReduceDeterministic)
+		{
+			RunReduceDeterministic<random_access_iterator_tag>();
+			RunReduceDeterministic<forward_iterator_tag>();
+			RunReduceDeterministic<input_iterator_tag>();
+		}
+
+		TEST_METHOD(ReduceDeterministicIsReproducible)
+		{
+			// Magnitudes far apart make floating point addition visibly non associative
+			std::vector<double> _Vec(1000 * 1000 + 7);
+			for (size_t _I = 0; _I < _Vec.size(); ++_I)
+				_Vec[_I] = (_I % 3 == 0) ? 1e12 / (_I + 1) : 1e-3 * (_I % 1000);
+
+			const double _Expected = reduce(par_deterministic, std::begin(_Vec), std::end(_Vec), 0.0);
+			for (int _Run = 0; _Run < 20; ++_Run)
+			{
+				const double _Val = reduce(par_deterministic, std::begin(_Vec), std::end(_Vec), 0.0);
+				Assert::IsTrue(memcmp(&_Expected, &_Val, sizeof(double)) == 0);
+			}
+		}
+
+		TEST_METHOD(ReduceArrayView)
+		{
+			using namespace std::experimental::D4087;
+			std::vector<long long> _Vec(512 * 384);
+			std::iota(std::begin(_Vec), std::end(_Vec), 1);
+			array_view<long long, 2> _Av({ 512, 384 }, _Vec);
+			const long long _Sum = std::accumulate(std::begin(_Vec), std::end(_Vec), 0ll);
+
+			Assert::AreEqual(_Sum, reduce(seq, _Av));
+			Assert::AreEqual(_Sum, reduce(par, _Av));
+			Assert::AreEqual(_Sum, reduce(par_vec, _Av));
+			Assert::AreEqual(_Sum + 5, reduce(par_deterministic, _Av, 5ll));
+			Assert::AreEqual(_Sum, reduce(execution_policy(par), array_view<const long long, 1>(_Vec)));
+			Assert::AreEqual(static_cast<long long>(_Vec.size()), reduce(par, _Av, 0ll, [](long long _Left, long long _Right) { return (std::max)(_Left, _Right); }));
+
+			// Every other column of a section
+			auto _Section = _Av.section({ 100, 10 }, { 200, 300 });
+			strided_array_view<long long, 2> _Columns({ 200, 150 }, { 384, 2 }, &_Section[{ 0, 0 }]);
+			long long _Expected = 0;
+			for (ptrdiff_t _Row = 0; _Row < 200; ++_Row)
+				for (ptrdiff_t _Col = 0; _Col < 300; _Col += 2)
+					_Expected += _Vec[(100 + _Row) * 384 + 10 + _Col];
+			Assert::AreEqual(_Expected, reduce(par, _Columns));
+			Assert::AreEqual(_Expected, reduce(par_deterministic, _Columns));
+
+			Assert::AreEqual(7ll, reduce(par, array_view<long long, 2>({ 0, 384 }, _Vec), 7ll));
+
+			std::vector<double> _Values(1000 * 1000 + 7);
+			for (size_t _I = 0; _I < _Values.size(); ++_I)
+				_Values[_I] = (_I % 3 == 0) ? 1e12 / (_I + 1) : 1e-3 * (_I % 1000);
+			array_view<double, 2> _Matrix({ 1000, 1000 }, _Values);
+			const double _Det = reduce(par_deterministic, _Matrix, 0.0);
+			for (int _Run = 0; _Run < 10; ++_Run)
+			{
+				const double _Val = reduce(par_deterministic, _Matrix, 0.0);
+				Assert::IsTrue(memcmp(&_Det, &_Val, sizeof(double)) == 0);
+			}
+		}
+
 		struct Element {
 			int _Val;
 			explicit Element(int _V) : _Val(_V) {}
@@ -161,6 +241,12 @@ namespace ParallelSTL_Tests
 
 			_Val = reduce(par, std::begin(vec), std::end(vec));
 			Assert::AreEqual(_Val, int{ 55 });
+
+			_El = reduce(par_deterministic, std::begin(vec_el2), std::end(vec_el2), Element(0), std::plus<>());
+			Assert::AreEqual(_El._Val, int{ 5 });
+
+			_Val = reduce(par_deterministic, std::begin(vec_empty), std::end(vec_empty), 0);
+			Assert::AreEqual(_Val, int{ 0 });
 		}
 
 		TEST_METHOD(ReduceSequential)
@@ -217,4 +303,67 @@ namespace ParallelSTL_Tests
 			}
 		}
 	};
+
+	TEST_CLASS(TransformReduceTest)
+	{
+		template<typename _ExPolicy>
+		void RunTransformReduce(_ExPolicy&& _Policy)
+		{
+			std::vector<size_t> vec(100000), vec2(100000);
+			std::iota(std::begin(vec), std::end(vec), size_t{ 0 });
+			std::fill(std::begin(vec2), std::end(vec2), size_t{ 3 });
+
+			auto _Square = [](size_t _Val) { return _Val * _Val; };
+
+			size_t _Expected = 0;
+			for (auto _Val : vec)
+				_Expected += _Square(_Val);
+
+			Assert::AreEqual(_Expected + 7, transform_reduce(_Policy, std::begin(vec), std::end(vec), _Square, size_t{ 7 }, std::plus<>()));
+
+			size_t _Expected_dot = std::inner_product(std::begin(vec), std::end(vec), std::begin(vec2), size_t{ 7 });
+			Assert::AreEqual(_Expected_dot, transform_reduce(_Policy, std::begin(vec), std::end(vec), std::begin(vec2), size_t{ 7 }));
+			Assert::AreEqual(_Expected_dot, transform_reduce(_Policy, std::begin(vec), std::end(vec), std::begin(vec2), size_t{ 7 }, std::plus<>(), std::multiplies<>()));
+
+			std::list<size_t> lst(std::begin(vec), std::end(vec));
+			Assert::AreEqual(_Expected + 7, transform_reduce(_Policy, std::begin(lst), std::end(lst), _Square, size_t{ 7 }, std::plus<>()));
+			Assert::AreEqual(_Expected_dot, transform_reduce(_Policy, std::begin(lst), std::end(lst), std::begin(vec2), size_t{ 7 }));
+		}
+
+		TEST_METHOD(TransformReduce)
+		{
+			RunTransformReduce(seq);
+			RunTransformReduce(par);
+			RunTransformReduce(par_vec);
+			RunTransformReduce(par_deterministic);
+			RunTransformReduce(execution_policy(par));
+		}
+
+		TEST_METHOD(TransformReduceEdgeCases)
+		{
+			std::vector<int> vec_empty;
+			std::vector<int> vec_one = { 3 };
+			std::vector<int> vec_one2 = { 4 };
+
+			Assert::AreEqual(5, transform_reduce(par, std::begin(vec_empty), std::end(vec_empty), [](int _Val) { return _Val * 2; }, 5, std::plus<>()));
+			Assert::AreEqual(5, transform_reduce(par, std::begin(vec_empty), std::end(vec_empty), std::begin(vec_empty), 5));
+
+			Assert::AreEqual(11, transform_reduce(par, std::begin(vec_one), std::end(vec_one), [](int _Val) { return _Val * 2; }, 5, std::plus<>()));
+			Assert::AreEqual(17, transform_reduce(par, std::begin(vec_one), std::end(vec_one), std::begin(vec_one2), 5));
+
+			// Transformed type differs from the element type
+			std::vector<int> vec = { 1, 2, 3, 4 };
+			double _Val = transform_reduce(par, std::begin(vec), std::end(vec), [](int _Val) { return _Val / 2.0; }, 0.0, std::plus<>());
+			Assert::AreEqual(5.0, _Val);
+		}
+
+		TEST_METHOD(TransformReduceSequential)
+		{
+			std::vector<int> vec = { 1, 2, 3, 4 }, vec2 = { 2, 2, 2, 2 };
+
+			Assert::AreEqual(30, transform_reduce(std::begin(vec), std::end(vec), [](int _Val) { return _Val * _Val; }, 0, std::plus<>()));
+			Assert::AreEqual(20, transform_reduce(std::begin(vec), std::end(vec), std::begin(vec2), 0));
+			Assert::AreEqual(20, transform_reduce(std::begin(vec), std::end(vec), std::begin(vec2), 0, std::plus<>(), std::multiplies<>()));
+		}
+	};
 } // namespace ParallelSTL_Tests
@@ -78,6 +78,22 @@ namespace ParallelSTL_Tests
 			RunRemove<random_access_iterator_tag>();
 			RunRemove<forward_iterator_tag>();
 		}
+
+		TEST_METHOD(RemoveIfKeepsElementsInPlace)
+		{
+			// The leading kept elements stay where they are and must not be moved onto themselves
+			std::vector<std::string> _Vec;
+			for (size_t _I = 0; _I < 10000; ++_I)
+				_Vec.push_back(std::string(32, static_cast<char>('a' + _I % 26)));
+
+			auto _Expected = _Vec;
+			auto _Pred = [](const std::string& _Val) { return _Val[0] == 'z'; };
+			_Expected.erase(std::remove_if(std::begin(_Expected), std::end(_Expected), _Pred), std::end(_Expected));
+
+			auto _Iter = remove_if(par, std::begin(_Vec), std::end(_Vec), _Pred);
+			Assert::AreEqual(_Expected.size(), static_cast<size_t>(std::distance(std::begin(_Vec), _Iter)));
+			Assert::IsTrue(std::equal(std::begin(_Expected), std::end(_Expected), std::begin(_Vec)));
+		}
 	};
 
 	TEST_CLASS(RemoveCopyTest)
@@ -206,4 +206,214 @@ namespace ParallelSTL_Tests
 			Assert::IsTrue(_It == std::end(vec_out));
 		}
 	};
+
+	TEST_CLASS(LookbackScanTest)
+	{
+		TEST_METHOD(ScanTileBoundaries)
+		{
+			// Sizes around the tile size of the single pass engine (32KB of size_t)
+			const size_t _Tile = 32 * 1024 / sizeof(size_t);
+			const size_t _Sizes[] = { 1, _Tile - 1, _Tile, _Tile + 1, 3 * _Tile, 3 * _Tile + 7, 100 * _Tile + 13 };
+
+			for (auto _Size : _Sizes) {
+				std::vector<size_t> vec(_Size), vec_out(_Size), expected(_Size);
+				for (size_t _I = 0; _I < _Size; ++_I)
+					vec[_I] = _I % 17;
+
+				std::partial_sum(std::begin(vec), std::end(vec), std::begin(expected));
+				auto _It = inclusive_scan(par, std::begin(vec), std::end(vec), std::begin(vec_out));
+				Assert::IsTrue(vec_out == expected);
+				Assert::IsTrue(_It == std::end(vec_out));
+
+				std::transform(std::begin(expected), std::end(expected), std::begin(vec), std::begin(expected), [](size_t _Sum, size_t _Val) { return _Sum - _Val + MARKER_VALUE; });
+				_It = exclusive_scan(par, std::begin(vec), std::end(vec), std::begin(vec_out), MARKER_VALUE);
+				Assert::IsTrue(vec_out == expected);
+				Assert::IsTrue(_It == std::end(vec_out));
+			}
+		}
+
+		TEST_METHOD(ScanNonCommutative)
+		{
+			// Order of the operands must be kept across tiles: compose affine maps x -> a * x + b
+			typedef std::pair<size_t, size_t> _Affine;
+			auto _Compose = [](const _Affine& _Lhs, const _Affine& _Rhs) { return _Affine(_Lhs.first * _Rhs.first, _Lhs.second * _Rhs.first + _Rhs.second); };
+
+			std::vector<_Affine> vec(200000), vec_out(200000), expected(200000);
+			for (size_t _I = 0; _I < vec.size(); ++_I)
+				vec[_I] = _Affine(_I % 3 + 1, _I % 5);
+
+			std::partial_sum(std::begin(vec), std::end(vec), std::begin(expected), _Compose);
+			inclusive_scan(par, std::begin(vec), std::end(vec), std::begin(vec_out), _Compose, _Affine(1, 0));
+			Assert::IsTrue(vec_out == expected);
+		}
+
+		TEST_METHOD(ScanException)
+		{
+			std::vector<size_t> vec(200000, 1), vec_out(200000);
+			std::atomic<size_t> _Calls(0);
+
+			try {
+				inclusive_scan(par, std::begin(vec), std::end(vec), std::begin(vec_out), [&_Calls](size_t _Val, size_t _Val2) -> size_t {
+					if (++_Calls == 50000)
+						throw std::runtime_error("scan");
+					return _Val + _Val2;
+				}, size_t{ 0 });
+				Assert::Fail();
+			}
+			catch (const exception_list& _Ex) {
+				Assert::IsTrue(_Ex.size() >= 1);
+			}
+		}
+	};
+
+	TEST_CLASS(TransformScanTest)
+	{
+		template<typename _ExPolicy>
+		void RunTransformScan(_ExPolicy&& _Policy)
+		{
+			std::vector<size_t> vec(100000), vec_out(100000), expected(100000);
+			std::iota(std::begin(vec), std::end(vec), size_t{ 0 });
+
+			auto _Twice = [](size_t _Val) { return _Val * 2; };
+
+			size_t _Sum = MARKER_VALUE;
+			for (size_t _I = 0; _I < vec.size(); ++_I) {
+				expected[_I] = _Sum;
+				_Sum += _Twice(vec[_I]);
+			}
+
+			auto _It = transform_exclusive_scan(_Policy, std::begin(vec), std::end(vec), std::begin(vec_out), _Twice, MARKER_VALUE, std::plus<>());
+			Assert::IsTrue(vec_out == expected);
+			Assert::IsTrue(_It == std::end(vec_out));
+
+			_Sum = MARKER_VALUE;
+			for (size_t _I = 0; _I < vec.size(); ++_I) {
+				_Sum += _Twice(vec[_I]);
+				expected[_I] = _Sum;
+			}
+
+			_It = transform_inclusive_scan(_Policy, std::begin(vec), std::end(vec), std::begin(vec_out), _Twice, std::plus<>(), MARKER_VALUE);
+			Assert::IsTrue(vec_out == expected);
+			Assert::IsTrue(_It == std::end(vec_out));
+
+			std::transform(std::begin(expected), std::end(expected), std::begin(expected), [](size_t _Val) { return _Val - MARKER_VALUE; });
+
+			_It = transform_inclusive_scan(_Policy, std::begin(vec), std::end(vec), std::begin(vec_out), _Twice, std::plus<>());
+			Assert::IsTrue(vec_out == expected);
+			Assert::IsTrue(_It == std::end(vec_out));
+
+			std::list<size_t> lst(std::begin(vec), std::end(vec)), lst_out(vec.size());
+			transform_inclusive_scan(_Policy, std::begin(lst), std::end(lst), std::begin(lst_out), _Twice, std::plus<>());
+			Assert::IsTrue(std::equal(std::begin(lst_out), std::end(lst_out), std::begin(expected)));
+		}
+
+		TEST_METHOD(TransformScan)
+		{
+			RunTransformScan(seq);
+			RunTransformScan(par);
+			RunTransformScan(par_vec);
+			RunTransformScan(execution_policy(par));
+		}
+
+		TEST_METHOD(TransformScanEdgeCases)
+		{
+			std::vector<size_t> vec_empty, vec_out_empty;
+			auto _Twice = [](size_t _Val) { return _Val * 2; };
+
+			Assert::IsTrue(transform_exclusive_scan(par, std::begin(vec_empty), std::end(vec_empty), std::begin(vec_out_empty), _Twice, size_t{ 0 }, std::plus<>()) == std::begin(vec_out_empty));
+			Assert::IsTrue(transform_inclusive_scan(par, std::begin(vec_empty), std::end(vec_empty), std::begin(vec_out_empty), _Twice, std::plus<>()) == std::begin(vec_out_empty));
+
+			std::vector<size_t> vec_one = { 2 }, vec_out_one = { 1 };
+
+			transform_exclusive_scan(par, std::begin(vec_one), std::end(vec_one), std::begin(vec_out_one), _Twice, MARKER_VALUE, std::plus<>());
+			Assert::AreEqual(size_t{ 1 }, vec_out_one[0]);
+
+			transform_inclusive_scan(par, std::begin(vec_one), std::end(vec_one), std::begin(vec_out_one), _Twice, std::plus<>(), MARKER_VALUE);
+			Assert::AreEqual(size_t{ 5 }, vec_out_one[0]);
+
+			// In place
+			std::vector<size_t> vec = { 2, 3, 4, 5 };
+			std::vector<size_t> expected = { 4, 10, 18, 28 };
+
+			transform_inclusive_scan(par, std::begin(vec), std::end(vec), std::begin(vec), _Twice, std::plus<>());
+			Assert::IsTrue(vec == expected);
+		}
+
+		template<typename _ExPolicy>
+		void RunTransformScanNoInit(_ExPolicy&& _Policy)
+		{
+			// Without an init the first transformed element starts the scan, 0 is neither the neutral element of
+			// multiplies nor of max
+			auto _Identity = [](int _Val) { return _Val; };
+			auto _Max = [](int _Val, int _Val2) { return (std::max)(_Val, _Val2); };
+
+			std::vector<int> vec(10), vec_out(10);
+			std::iota(std::begin(vec), std::end(vec), 1);
+
+			auto _It = transform_inclusive_scan(_Policy, std::begin(vec), std::end(vec), std::begin(vec_out), _Identity, std::multiplies<>());
+			Assert::AreEqual(1, vec_out.front());
+			Assert::AreEqual(3628800, vec_out.back());
+			Assert::IsTrue(_It == std::end(vec_out));
+
+			std::vector<int> vec_neg(100000), vec_neg_out(100000);
+			for (size_t _I = 0; _I < vec_neg.size(); ++_I)
+				vec_neg[_I] = -9 - static_cast<int>(_I % 1000);
+
+			transform_inclusive_scan(_Policy, std::begin(vec_neg), std::end(vec_neg), std::begin(vec_neg_out), _Identity, _Max);
+			Assert::AreEqual(-9, vec_neg_out.front());
+			Assert::AreEqual(-9, vec_neg_out.back());
+
+			std::list<int> lst(std::begin(vec_neg), std::begin(vec_neg) + 100), lst_out(100);
+			transform_inclusive_scan(_Policy, std::begin(lst), std::end(lst), std::begin(lst_out), _Identity, _Max);
+			Assert::AreEqual(-9, lst_out.back());
+		}
+
+		TEST_METHOD(TransformScanNoInit)
+		{
+			RunTransformScanNoInit(seq);
+			RunTransformScanNoInit(par);
+			RunTransformScanNoInit(par_vec);
+		}
+
+		template<typename _ExPolicy>
+		void RunInclusiveScanNoInit(_ExPolicy&& _Policy)
+		{
+			// Same for inclusive_scan with an operation and no init
+			auto _Max = [](int _Val, int _Val2) { return (std::max)(_Val, _Val2); };
+
+			std::vector<int> vec(10), vec_out(10);
+			std::iota(std::begin(vec), std::end(vec), 1);
+
+			auto _It = inclusive_scan(_Policy, std::begin(vec), std::end(vec), std::begin(vec_out), std::multiplies<>());
+			Assert::AreEqual(1, vec_out.front());
+			Assert::AreEqual(3628800, vec_out.back());
+			Assert::IsTrue(_It == std::end(vec_out));
+
+			std::vector<int> vec_ones(100000, 1), vec_ones_out(100000);
+			vec_ones[50000] = 2;
+			inclusive_scan(_Policy, std::begin(vec_ones), std::end(vec_ones), std::begin(vec_ones_out), std::multiplies<>());
+			Assert::AreEqual(1, vec_ones_out[49999]);
+			Assert::AreEqual(2, vec_ones_out.back());
+
+			std::vector<int> vec_neg(100000), vec_neg_out(100000);
+			for (size_t _I = 0; _I < vec_neg.size(); ++_I)
+				vec_neg[_I] = -9 - static_cast<int>(_I % 1000);
+
+			inclusive_scan(_Policy, std::begin(vec_neg), std::end(vec_neg), std::begin(vec_neg_out), _Max);
+			Assert::AreEqual(-9, vec_neg_out.back());
+
+			std::list<int> lst(std::begin(vec), std::end(vec)), lst_out(10);
+			inclusive_scan(_Policy, std::begin(lst), std::end(lst), std::begin(lst_out), std::multiplies<>());
+			Assert::AreEqual(3628800, lst_out.back());
+
+			Assert::IsTrue(inclusive_scan(_Policy, std::begin(vec), std::begin(vec), std::begin(vec_out), std::multiplies<>()) == std::begin(vec_out));
+		}
+
+		TEST_METHOD(InclusiveScanNoInit)
+		{
+			RunInclusiveScanNoInit(seq);
+			RunInclusiveScanNoInit(par);
+			RunInclusiveScanNoInit(par_vec);
+		}
+	};
 } // namespace ParallelSTL_Tests
@@ -117,6 +117,22 @@ namespace ParallelSTL_Tests
 			}
 		}
 
+		// Range 2 much larger than range 1 and long runs of equivalent elements across the parts
+		TEST_METHOD(skewedSetOperationsTest)
+		{
+			vector<int> a(100 + rand() % 100), b(200000 + rand() % 20000);
+
+			for (int i = 0; i < 5; i++)
+			{
+				generate(a.begin(), a.end(), [] { return std::rand() % 1000; });
+				generate(b.begin(), b.end(), [i] { return i % 2 == 0 ? std::rand() % 1000 : std::rand() % 3; });
+				sort(a.begin(), a.end());
+				sort(b.begin(), b.end());
+				genericSetOperationTest(par, a.begin(), a.end(), b.begin(), b.end(), a.size() + b.size());
+				genericSetOperationTest(par, b.begin(), b.end(), a.begin(), a.end(), a.size() + b.size());
+			}
+		}
+
 		TEST_METHOD(specialContainerSetOperationsTest)
 		{
 			vector<int> a(1000, 1), b(1, 0);
@@ -16,6 +16,45 @@ namespace ParallelSTL_Tests
 		Assert::IsTrue(std::is_sorted(numbers.begin(), numbers.end()));
 	}
 
+	// Large enough for the radix sort engine of sort(par)
+	template<typename _Ty, typename _ExecutionPolicy>
+	void RadixSortImpl(const _ExecutionPolicy& _Policy)
+	{
+		vector<_Ty> numbers(100000 + rand() % 10000);
+		for (size_t i = 0; i < numbers.size(); i++)
+			numbers[i] = static_cast<_Ty>(static_cast<long long>((i * 2654435761u) % 100003) - (std::is_signed<_Ty>::value ? 50000 : 0));
+
+		if (std::is_floating_point<_Ty>::value)
+			numbers[0] = static_cast<_Ty>(-0.5);
+
+		vector<_Ty> expected = numbers;
+		std::sort(expected.begin(), expected.end());
+
+		sort(_Policy, numbers.begin(), numbers.end()); // asc order
+		Assert::IsTrue(numbers == expected);
+
+		std::random_shuffle(numbers.begin(), numbers.end());
+		sort(_Policy, numbers.begin(), numbers.end(), std::greater<>()); // dsc order
+		Assert::IsTrue(std::equal(numbers.begin(), numbers.end(), expected.rbegin()));
+	}
+
+	template<typename _ExecutionPolicy>
+	void KeySortImpl(const _ExecutionPolicy& _Policy)
+	{
+		vector<pair<int, size_t>> records(100000 + rand() % 10000);
+		for (size_t i = 0; i < records.size(); i++)
+			records[i] = make_pair(static_cast<int>(i % 1000) - 500, i);
+
+		std::random_shuffle(records.begin(), records.end());
+
+		sort(_Policy, records.begin(), records.end(), [](const pair<int, size_t>& record) { return record.first; }); // asc order of the key
+		Assert::IsTrue(std::is_sorted(records.begin(), records.end(), [](const pair<int, size_t>& left, const pair<int, size_t>& right) { return left.first < right.first; }));
+
+		sort(_Policy, records.begin(), records.end(), [](const pair<int, size_t>& record) { return -static_cast<double>(record.second); }); // dsc order of the index
+		for (size_t i = 0; i < records.size(); i++)
+			Assert::AreEqual(records.size() - 1 - i, records[i].second);
+	}
+
 	template<typename _ExecutionPolicy>
 	void StableSortImpl(const _ExecutionPolicy& _Policy)
 	{
@@ -31,6 +70,56 @@ namespace ParallelSTL_Tests
 		Assert::IsTrue(std::is_sorted(numbers.begin(), numbers.end()));
 	}
 
+	// Move only and not default constructible, sorted with unbounded and bounded scratch storage
+	struct StableSortRecord
+	{
+		size_t key;
+		size_t order;
+		unique_ptr<size_t> payload;
+
+		StableSortRecord(size_t k, size_t o) : key(k), order(o), payload(new size_t(o))
+		{
+		}
+
+		StableSortRecord(StableSortRecord &&other) : key(other.key), order(other.order), payload(std::move(other.payload))
+		{
+		}
+
+		StableSortRecord &operator =(StableSortRecord &&other)
+		{
+			key = other.key;
+			order = other.order;
+			payload = std::move(other.payload);
+			return *this;
+		}
+	};
+
+	template<typename _ExecutionPolicy>
+	void StableSortBufferImpl(const _ExecutionPolicy& _Policy)
+	{
+		const size_t size = 100000 + rand() % 10000;
+		const size_t bufferSizes[] = { size, size / 8, 100, 0 };
+		for (auto bufferSize : bufferSizes)
+		{
+			vector<StableSortRecord> records;
+			records.reserve(size);
+			for (size_t i = 0; i < size; i++)
+				records.emplace_back((i * 2654435761u) % 1000, i);
+
+			auto byKey = [](const StableSortRecord &left, const StableSortRecord &right) { return left.key < right.key; };
+			if (bufferSize == size)
+				stable_sort(_Policy, records.begin(), records.end(), byKey);
+			else
+				stable_sort(_Policy, records.begin(), records.end(), byKey, bufferSize);
+
+			for (size_t i = 1; i < size; i++)
+			{
+				Assert::IsTrue(records[i - 1].key < records[i].key || (records[i - 1].key == records[i].key && records[i - 1].order < records[i].order));
+				Assert::IsTrue(records[i].payload && *records[i].payload == records[i].order);
+			}
+		}
+	}
+
 	template<typename _ExecutionPolicy>
 	void PartialSortImpl(const _ExecutionPolicy& _Policy)
 	{
@@ -48,6 +137,112 @@ namespace ParallelSTL_Tests
 		Assert::IsTrue(numbers[midPos - 1] <= *std::min_element(numbers.begin() + midPos, numbers.end()));
 	}
 
+	// Compares with std::partial_sort_copy for output sizes below, around and above the per chunk candidates
+	template<typename _ExecutionPolicy>
+	void PartialSortCopyImpl(const _ExecutionPolicy& _Policy)
+	{
+		vector<int> numbers(50000 + rand() % 10000);
+		for (size_t i = 0; i < numbers.size(); i++)
+			numbers[i] = static_cast<int>((i * 2654435761u) % 10007); // many duplicates
+		std::list<int> numbersList(numbers.begin(), numbers.end());
+
+		const size_t sizes[] = { 0, 1, 100, 3000, numbers.size() / 2, numbers.size() - 1, numbers.size(), numbers.size() + 10 };
+		for (auto size : sizes)
+		{
+			vector<int> expected(size, -1), result(size, -1), resultList(size, -1);
+
+			auto expectedEnd = std::partial_sort_copy(numbers.begin(), numbers.end(), expected.begin(), expected.end(), std::greater<int>());
+			auto resultEnd = partial_sort_copy(_Policy, numbers.begin(), numbers.end(), result.begin(), result.end(), std::greater<int>());
+			Assert::IsTrue(resultEnd - result.begin() == expectedEnd - expected.begin());
+			Assert::IsTrue(result == expected);
+
+			expectedEnd = std::partial_sort_copy(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+			auto resultListEnd = partial_sort_copy(_Policy, numbersList.begin(), numbersList.end(), resultList.begin(), resultList.end());
+			Assert::IsTrue(resultListEnd - resultList.begin() == expectedEnd - expected.begin());
+			Assert::IsTrue(resultList == expected);
+		}
+	}
+
+	// Calls nested in a parallel loop go over the global chore limit, some of them run their partitioned loop inline
+	template<typename _ExecutionPolicy>
+	void PartialSortCopyNestedImpl(const _ExecutionPolicy& _Policy)
+	{
+		vector<int> numbers(40000);
+		for (size_t i = 0; i < numbers.size(); i++)
+			numbers[i] = static_cast<int>((i * 2654435761u) % 10007);
+		std::list<int> numbersList(numbers.begin(), numbers.end());
+
+		vector<int> expected(30000);
+		std::partial_sort_copy(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+
+		vector<vector<int>> results(32, vector<int>(expected.size(), -1));
+		for_each(par, results.begin(), results.end(), [&](vector<int>& result) {
+			if ((&result - results.data()) & 1)
+				partial_sort_copy(_Policy, numbersList.begin(), numbersList.end(), result.begin(), result.end());
+			else
+				partial_sort_copy(_Policy, numbers.begin(), numbers.end(), result.begin(), result.end());
+		});
+
+		for (auto& result : results)
+			Assert::IsTrue(result == expected);
+	}
+
+	// Neither default constructible nor leaked, partial_sort_copy and the radix sort build it in uninitialized storage
+	struct CountedValue
+	{
+		static std::atomic<int> live;
+		int value;
+
+		explicit CountedValue(int v) : value(v) { ++live; }
+		CountedValue(const CountedValue& other) : value(other.value) { ++live; }
+		CountedValue& operator=(const CountedValue& other) { value = other.value; return *this; }
+		~CountedValue() { --live; }
+
+		bool operator<(const CountedValue& other) const { return value < other.value; }
+		bool operator==(const CountedValue& other) const { return value == other.value; }
+	};
+
+	std::atomic<int> CountedValue::live(0);
+
+	// Large enough for the radix sort engine, which scatters the records through uninitialized storage
+	template<typename _ExecutionPolicy>
+	void KeySortNoDefaultImpl(const _ExecutionPolicy& _Policy)
+	{
+		{
+			vector<CountedValue> records;
+			for (int i = 0; i < 100000; i++)
+				records.emplace_back(static_cast<int>((i * 2654435761u) % 100003) - 50000);
+
+			sort(_Policy, records.begin(), records.end(), [](const CountedValue& record) { return record.value; });
+			Assert::IsTrue(std::is_sorted(records.begin(), records.end()));
+		}
+		Assert::AreEqual(0, CountedValue::live.load());
+	}
+
+	template<typename _ExecutionPolicy>
+	void PartialSortCopyNoDefaultImpl(const _ExecutionPolicy& _Policy)
+	{
+		{
+			vector<CountedValue> numbers;
+			for (int i = 0; i < 30000; i++)
+				numbers.emplace_back(static_cast<int>((i * 2654435761u) % 10007));
+			std::list<CountedValue> numbersList(numbers.begin(), numbers.end());
+
+			for (size_t size : { size_t{ 10 }, size_t{ 5000 }, numbers.size() })
+			{
+				vector<CountedValue> expected(size, CountedValue(-1)), result(size, CountedValue(-1));
+				std::partial_sort_copy(numbers.begin(), numbers.end(), expected.begin(), expected.end());
+
+				partial_sort_copy(_Policy, numbers.begin(), numbers.end(), result.begin(), result.end());
+				Assert::IsTrue(result == expected);
+
+				partial_sort_copy(_Policy, numbersList.begin(), numbersList.end(), result.begin(), result.end());
+				Assert::IsTrue(result == expected);
+			}
+		}
+		Assert::AreEqual(0, CountedValue::live.load());
+	}
+
 	TEST_CLASS(sort_tests)
 	{
 		TEST_METHOD(Sort)
@@ -57,6 +252,31 @@ namespace ParallelSTL_Tests
 			SortImpl(par_vec);
 		}
 
+		TEST_METHOD(RadixSort)
+		{
+			RadixSortImpl<int>(par);
+			RadixSortImpl<unsigned int>(par);
+			RadixSortImpl<long long>(par);
+			RadixSortImpl<unsigned short>(par);
+			RadixSortImpl<float>(par);
+			RadixSortImpl<double>(par_vec);
+			RadixSortImpl<int>(seq);
+		}
+
+		TEST_METHOD(KeySort)
+		{
+			KeySortImpl(seq);
+			KeySortImpl(par);
+			KeySortImpl(par_vec);
+		}
+
+		TEST_METHOD(KeySortNoDefault)
+		{
+			KeySortNoDefaultImpl(seq);
+			KeySortNoDefaultImpl(par);
+			KeySortNoDefaultImpl(par_vec);
+		}
+
 		TEST_METHOD(StableSort)
 		{
 			StableSortImpl(seq);
@@ -64,12 +284,40 @@ namespace ParallelSTL_Tests
 			StableSortImpl(par_vec);
 		}
 
+		TEST_METHOD(StableSortBuffer)
+		{
+			StableSortBufferImpl(seq);
+			StableSortBufferImpl(par);
+			StableSortBufferImpl(par_vec);
+		}
+
 		TEST_METHOD(PartialSort)
 		{
 			PartialSortImpl(seq);
 			PartialSortImpl(par);
 			PartialSortImpl(par_vec);
 		}
+
+		TEST_METHOD(PartialSortCopy)
+		{
+			PartialSortCopyImpl(seq);
+			PartialSortCopyImpl(par);
+			PartialSortCopyImpl(par_vec);
+		}
+
+		TEST_METHOD(PartialSortCopyNoDefault)
+		{
+			PartialSortCopyNoDefaultImpl(seq);
+			PartialSortCopyNoDefaultImpl(par);
+			PartialSortCopyNoDefaultImpl(par_vec);
+		}
+
+		TEST_METHOD(PartialSortCopyNested)
+		{
+			PartialSortCopyNestedImpl(seq);
+			PartialSortCopyNestedImpl(par);
+			PartialSortCopyNestedImpl(par_vec);
+		}
 	};
 
 } // namespace ParallelSTL_Tests
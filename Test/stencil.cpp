@@ -0,0 +1,112 @@
+#include "stdafx.h"
+
+namespace ParallelSTL_Tests
+{
+	TEST_CLASS(StencilTest)
+	{
+		// Weighted sum of the window, every position of the window weighs differently
+		struct WeightedSum
+		{
+			ptrdiff_t _Radius;
+
+			long long operator()(const stencil_window<const long long>& _Window) const
+			{
+				long long _Sum = 0;
+				for (ptrdiff_t _Row = -_Radius; _Row <= _Radius; ++_Row)
+					for (ptrdiff_t _Col = -_Radius; _Col <= _Radius; ++_Col)
+						_Sum += _Window(_Row, _Col) * (1 + (_Row + _Radius) * 3 + _Col + _Radius);
+				return _Sum % 100003;
+			}
+		};
+
+		// _Passes passes over whole frames, one after the other
+		static std::vector<long long> Reference(const std::vector<long long>& _In, ptrdiff_t _Height, ptrdiff_t _Width, ptrdiff_t _Radius, size_t _Passes)
+		{
+			std::vector<long long> _Current(_In), _Next(_In);
+			const WeightedSum _Func = { _Radius };
+			for (size_t _Pass = 0; _Pass < _Passes; ++_Pass)
+			{
+				for (ptrdiff_t _Row = _Radius; _Row < _Height - _Radius; ++_Row)
+					for (ptrdiff_t _Col = _Radius; _Col < _Width - _Radius; ++_Col)
+						_Next[_Row * _Width + _Col] = _Func(stencil_window<const long long>(&_Current[_Row * _Width + _Col], _Width, 1));
+				std::swap(_Current, _Next);
+			}
+			return _Current;
+		}
+
+		template<typename _ExPolicy>
+		void RunStencil(_ExPolicy&& _Policy, ptrdiff_t _Height, ptrdiff_t _Width, ptrdiff_t _Radius, size_t _Passes)
+		{
+			using namespace std::experimental::D4087;
+
+			std::vector<long long> _In(_Height * _Width), _Out(_Height * _Width, -1);
+			for (size_t _I = 0; _I < _In.size(); ++_I)
+				_In[_I] = static_cast<long long>((_I * 2654435761u) % 1000);
+
+			const std::vector<long long> _Expected = Reference(_In, _Height, _Width, _Radius, _Passes);
+			const WeightedSum _Func = { _Radius };
+			if (_Passes == 1)
+				stencil(_Policy, array_view<const long long, 2>({ _Height, _Width }, _In), array_view<long long, 2>({ _Height, _Width }, _Out), _Radius, _Func);
+			else
+				stencil(_Policy, array_view<const long long, 2>({ _Height, _Width }, _In), array_view<long long, 2>({ _Height, _Width }, _Out), _Radius, _Passes, _Func);
+
+			// The border is not written
+			for (ptrdiff_t _Row = 0; _Row < _Height; ++_Row)
+			{
+				for (ptrdiff_t _Col = 0; _Col < _Width; ++_Col)
+				{
+					const bool _Interior = _Row >= _Radius && _Row < _Height - _Radius && _Col >= _Radius && _Col < _Width - _Radius;
+					Assert::AreEqual(_Interior ? _Expected[_Row * _Width + _Col] : -1LL, _Out[_Row * _Width + _Col]);
+				}
+			}
+		}
+
+		TEST_METHOD(Stencil)
+		{
+			// Frames smaller than the window, single tiles, tiles with edges and frames of many tiles
+			const ptrdiff_t _Sizes[][2] = { { 1, 1 }, { 3, 3 }, { 5, 7 }, { 64, 256 }, { 257, 513 }, { 37, 1000 }, { 1000, 9 } };
+			for (auto& _Size : _Sizes)
+			{
+				for (ptrdiff_t _Radius = 0; _Radius < 4; ++_Radius)
+				{
+					for (size_t _Passes : { 0, 1, 2, 5 })
+					{
+						RunStencil(seq, _Size[0], _Size[1], _Radius, _Passes);
+						RunStencil(par, _Size[0], _Size[1], _Radius, _Passes);
+						RunStencil(par_vec, _Size[0], _Size[1], _Radius, _Passes);
+						RunStencil(execution_policy(par), _Size[0], _Size[1], _Radius, _Passes);
+					}
+				}
+			}
+		}
+
+		// Every other column of larger arrays, and a function returning another type than the one of the input
+		TEST_METHOD(StencilStrided)
+		{
+			using namespace std::experimental::D4087;
+
+			const ptrdiff_t _Height = 50, _Width = 70;
+			std::vector<int> _Big(_Height * _Width * 2);
+			std::vector<double> _Result(_Height * _Width * 2, -7);
+			for (size_t _I = 0; _I < _Big.size(); ++_I)
+				_Big[_I] = static_cast<int>(_I % 97);
+
+			stencil(par, strided_array_view<const int, 2>({ _Height, _Width }, { 2 * _Width, 2 }, _Big.data()), strided_array_view<double, 2>({ _Height, _Width }, { 2 * _Width, 2 }, _Result.data()), 1,
+				[](const stencil_window<const int>& _Window) {
+				return (_Window(-1, 0) + _Window(1, 0) + _Window(0, -1) + _Window(0, 1) - 4 * _Window(0, 0)) / 2.0;
+			});
+
+			for (ptrdiff_t _Row = 0; _Row < _Height; ++_Row)
+			{
+				for (ptrdiff_t _Col = 0; _Col < _Width; ++_Col)
+				{
+					const int *_Center = &_Big[_Row * 2 * _Width + 2 * _Col];
+					const bool _Interior = _Row > 0 && _Row < _Height - 1 && _Col > 0 && _Col < _Width - 1;
+					const double _Expected = _Interior ? (_Center[-2 * _Width] + _Center[2 * _Width] + _Center[-2] + _Center[2] - 4 * _Center[0]) / 2.0 : -7;
+					Assert::AreEqual(_Expected, _Result[_Row * 2 * _Width + 2 * _Col]);
+					Assert::AreEqual(-7.0, _Result[_Row * 2 * _Width + 2 * _Col + 1]);
+				}
+			}
+		}
+	};
+} // namespace ParallelSTL_Tests
@@ -76,6 +76,15 @@ namespace ParallelSTL_Tests
 		stg.wait();
 	}
 
+	// Runs chores from a static constructor and destructor, which may come before the library's own statics are
+	// constructed or after they are destroyed when the library is linked statically
+	struct StaticInitUser
+	{
+		int result;
+		StaticInitUser() : result(fib(20)) {}
+		~StaticInitUser() { fib(10); }
+	} staticInitUser;
+
 	TEST_CLASS(taskgroup_tests)
 	{
 		TEST_METHOD(singletaskgroup)
@@ -119,6 +128,28 @@ namespace ParallelSTL_Tests
 			Assert::AreEqual(14, counter.load());
 		}
 
+		TEST_METHOD(taskgroup_manychores)
+		{
+			// more chores than the initial capacity of the workstealing queue
+			std::atomic<int> counter = 0;
+
+			auto doWork = [&] {
+				++counter;
+			};
+
+			std::vector<decltype(make_task(doWork))> chores;
+			chores.reserve(5000);
+
+			TaskGroup tg;
+			for (int i = 0; i < 5000; i++)
+			{
+				chores.push_back(make_task(doWork));
+				tg.run(chores.back());
+			}
+			tg.wait();
+			Assert::AreEqual(5000, counter.load());
+		}
+
 		TEST_METHOD(taskgroup_fib25)
 		{
 			Assert::AreEqual(75025, fib(25));
@@ -149,5 +180,44 @@ namespace ParallelSTL_Tests
 				Assert::AreEqual(1000, counter[i].load());
 			}
 		}
+
+		TEST_METHOD(taskgroup_outoforder)
+		{
+			// The outer group is waited first, then the inner one gets more chores queued below where it started
+			std::atomic<int> outerCounter(0), innerCounter(0);
+			auto outerWork = [&] { ++outerCounter; };
+			auto innerWork = [&] { ++innerCounter; };
+
+			std::vector<decltype(make_task(outerWork))> outerChores;
+			std::vector<decltype(make_task(innerWork))> innerChores;
+			outerChores.reserve(100);
+			innerChores.reserve(200);
+			for (int i = 0; i < 100; i++)
+				outerChores.push_back(make_task(outerWork));
+			for (int i = 0; i < 200; i++)
+				innerChores.push_back(make_task(innerWork));
+
+			TaskGroup outer;
+			for (int i = 0; i < 100; i++)
+				outer.run(outerChores[i]);
+			{
+				TaskGroup inner;
+				for (int i = 0; i < 100; i++)
+					inner.run(innerChores[i]);
+
+				outer.wait();
+				Assert::AreEqual(100, outerCounter.load());
+
+				for (int i = 100; i < 200; i++)
+					inner.run(innerChores[i]);
+				inner.wait();
+				Assert::AreEqual(200, innerCounter.load());
+			}
+		}
+
+		TEST_METHOD(taskgroup_staticinit)
+		{
+			Assert::AreEqual(6765, staticInitUser.result);
+		}
 	};
 } // namespace ParallelSTL_Tests
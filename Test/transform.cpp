@@ -115,5 +115,33 @@ namespace ParallelSTL_Tests
 			RunTransformTwoParamsPred<forward_iterator_tag>();
 			RunTransformTwoParamsPred<input_iterator_tag, output_iterator_tag>();
 		}
+
+		template<typename _ExPolicy>
+		void RunTransformArrayView(const _ExPolicy& _Policy)
+		{
+			using namespace std::experimental::D4087;
+			std::vector<float> _Src(256 * 300);
+			std::iota(std::begin(_Src), std::end(_Src), 0.0f);
+
+			std::vector<double> _Dest(_Src.size());
+			transform(_Policy, array_view<const float, 2>({ 256, 300 }, _Src), array_view<double, 2>({ 256, 300 }, _Dest), [](float _El) { return 2.0 * _El; });
+			for (size_t _I = 0; _I < _Src.size(); ++_I)
+				Assert::AreEqual(2.0 * _Src[_I], _Dest[_I]);
+
+			// The transposed source walks a column per row
+			std::vector<float> _Transposed(_Src.size());
+			transform(_Policy, strided_array_view<const float, 2>({ 300, 256 }, { 1, 300 }, _Src.data()), array_view<float, 2>({ 300, 256 }, _Transposed), [](float _El) { return _El; });
+			for (size_t _Row = 0; _Row < 300; ++_Row)
+				for (size_t _Col = 0; _Col < 256; ++_Col)
+					Assert::AreEqual(_Src[_Col * 300 + _Row], _Transposed[_Row * 256 + _Col]);
+		}
+
+		TEST_METHOD(TransformArrayView)
+		{
+			RunTransformArrayView(seq);
+			RunTransformArrayView(par);
+			RunTransformArrayView(par_vec);
+			RunTransformArrayView(execution_policy(par_vec));
+		}
 	};
 } // ParallelSTL_Tests
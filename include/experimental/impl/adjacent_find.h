@@ -18,40 +18,67 @@ namespace details {
 		_EXP_RETHROW
 	}
 
-	template<class _ExPolicy, class _FwdIt, class _BinPr, class _IterCat>
-	inline _FwdIt _Adjacent_find_impl(const _ExPolicy&, _FwdIt _First, _FwdIt _Last, _BinPr _Pred, _IterCat)
+	template<class _ExPolicy, class _FwdIt, class _BinPr>
+	typename std::iterator_traits<_FwdIt>::difference_type _Adjacent_find_helper(const _ExPolicy&, _FwdIt _First, typename std::iterator_traits<_FwdIt>::difference_type _Size, _BinPr _Pred, std::false_type)
 	{
 		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
 		typedef typename std::iterator_traits<_FwdIt>::difference_type difference_type;
 
-		if (_First != _Last)
-		{
-			auto _Size = std::distance(_First, _Last);
-			if (_Size < 2)
-				return _Last;
+		cancellation_token_with_position<difference_type> _Token(_Size);
 
-			cancellation_token_with_position<difference_type> _Token(_Size);
+		_Partitioner<_ExecutionPolicy>::_For_Each(_First, _Size - 1, _Pred,
+			[&_Token, &_First](_FwdIt _Begin, size_t _Count, _BinPr& _UserFunc){
+			auto _Dist = std::distance(_First, _Begin);
 
-			_Partitioner<_ExecutionPolicy>::_For_Each(_First, _Size - 1, _Pred,
-				[&_Token, &_First](_FwdIt _Begin, size_t _Count, _BinPr& _UserFunc){
-				auto _Dist = std::distance(_First, _Begin);
+			auto _Prev = _Begin;
+			++_Begin;
 
-				auto _Prev = _Begin;
-				++_Begin;
+			for (size_t _Curr_pos = 0; _Curr_pos < _Count; ++_Curr_pos, ++_Begin) {
+				if (_UserFunc(*_Prev, *_Begin)) {
+					_Token.cancel(_Dist + _Curr_pos);
+					break;
+				}
+				else if (_Token.is_cancelled(_Dist))
+					break;
 
-				for (size_t _Curr_pos = 0; _Curr_pos < _Count; ++_Curr_pos, ++_Begin) {
-					if (_UserFunc(*_Prev, *_Begin)) {
-						_Token.cancel(_Dist + _Curr_pos);
-						break;
-					}
-					else if (_Token.is_cancelled(_Dist))
-						break;
+				_Prev = _Begin;
+			}
+		});
 
-					_Prev = _Begin;
-				}
+		return _Token.get_position();
+	}
+
+	// par_vec over contiguous arithmetic elements, the vector kernel compares every block with itself shifted by one
+	template<class _ExPolicy, class _FwdIt, class _BinPr>
+	typename std::iterator_traits<_FwdIt>::difference_type _Adjacent_find_helper(const _ExPolicy&, _FwdIt _First, typename std::iterator_traits<_FwdIt>::difference_type _Size, _BinPr _Pred, std::true_type)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+		typedef typename std::iterator_traits<_FwdIt>::difference_type difference_type;
+		typedef typename std::iterator_traits<_FwdIt>::value_type value_type;
+
+		const value_type *_Base = std::addressof(*_First);
+		cancellation_token_with_position<difference_type> _Token(_Size);
+
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Base, _Size - 1, _Pred,
+			[&_Token, _Base](const value_type *_Begin, size_t _Count, _BinPr&){
+			_Vec_search_blocks<value_type>(static_cast<difference_type>(_Begin - _Base), _Count, _Token, [_Begin](size_t _Offset, size_t _Len){
+				return _Vec_adjacent_equal(_Begin + _Offset, _Len, _Vec_element<value_type>::value);
 			});
+		});
+
+		return _Token.get_position();
+	}
+
+	template<class _ExPolicy, class _FwdIt, class _BinPr, class _IterCat>
+	inline _FwdIt _Adjacent_find_impl(const _ExPolicy& _Policy, _FwdIt _First, _FwdIt _Last, _BinPr _Pred, _IterCat)
+	{
+		if (_First != _Last)
+		{
+			auto _Size = std::distance(_First, _Last);
+			if (_Size < 2)
+				return _Last;
 
-			auto _Pos = _Token.get_position();
+			auto _Pos = _Adjacent_find_helper(_Policy, _First, _Size, _Pred, _Use_vec_kernel2<_ExPolicy, _FwdIt, _FwdIt, _BinPr>());
 			if (_Pos != _Size) {
 				std::advance(_First, _Pos);
 				return _First;
@@ -73,7 +100,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type adjacent_fin
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Adjacent_find_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Adjacent_find_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _FwdIt>
@@ -81,7 +108,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type adjacent_fin
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Adjacent_find_impl(_Policy, _First, _Last, std::equal_to<>(), std::_Iter_cat(_First));
+	return details::_Adjacent_find_impl(_Policy, _First, _Last, std::equal_to<>(), details::_Iter_cat(_First));
 }
 _PSTL_NS1_END// std::experimental::parallel
 
@@ -8,12 +8,19 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <iterator>
 #include <type_traits>
 #include <deque>
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <functional>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #include "defines.h"
 #include <experimental/execution_policy>
@@ -21,13 +28,26 @@
 
 #include "algorithm_scheduler.h"
 #include "event.h"
+#include "array_view.h"
 
 _PSTL_NS1_BEGIN
 namespace details {
 
-#pragma warning(push)
-	// object allocated on the heap may not be aligned 64
-#pragma warning(disable: 4316)
+	// Worker slots back the thread-private storage of combinable. Every thread taking part in a parallel
+	// algorithm claims the lowest free slot index on first use and keeps it until it exits, thus indices
+	// stay dense and a combinable can address its values by index instead of hashing thread ids.
+
+	// Number of worker slots, fixed for the lifetime of the process
+	_EXP_IMPL unsigned int __cdecl get_worker_slot_count();
+
+	// Slot of the calling thread in [0, get_worker_slot_count()), or get_worker_slot_count() when all are taken
+	_EXP_IMPL unsigned int __cdecl get_current_worker_slot();
+
+	// Returns a 64 byte aligned block of get_worker_slot_count() * _Stride zeroed bytes. Blocks of the common
+	// one cache line stride are recycled, they are zeroed again when handed out to the next owner.
+	_EXP_IMPL void * __cdecl _Acquire_slot_block(size_t _Stride);
+
+	_EXP_IMPL void __cdecl _Release_slot_block(void *_Block, size_t _Stride);
 
 	/// <summary>
 	///     The <c>combinable&lt;T&gt;</c> object is intended to provide thread-private copies of data, to perform lock-free
@@ -40,6 +60,9 @@ namespace details {
 	///     The data type of the final merged result. The type must have a move constructor and/or default constructor.
 	/// </typeparam>
 	/// <remarks>
+	///     Values live in cache line padded slots indexed by the worker slot of the calling thread. A slot given
+	///     back by an exiting thread may be claimed by another one, which then continues the sub-computation of
+	///     its predecessor; this is invisible to associative and commutative combine functors.
 	///     For more information, see <see cref="Parallel Containers and Objects"/>.
 	/// </remarks>
 	template<typename _Ty>
@@ -47,23 +70,28 @@ namespace details {
 	{
 	private:
 
-		// Disable warning C4324: structure was padded due to __declspec(align())
-		// This padding is expected and necessary.
-#pragma warning(push)
-#pragma warning(disable: 4324)
-		__declspec(align(64))
+		struct _Slot
+		{
+			typename std::aligned_storage<sizeof(_Ty), std::alignment_of<_Ty>::value>::type _Storage;
+			bool _Constructed; // written by the owning thread only
+		};
+
+		static_assert(std::alignment_of<_Ty>::value <= 64, "combinable slots are aligned to a cache line");
+
+		static const size_t _Slot_stride = (sizeof(_Slot) + 63) & ~static_cast<size_t>(63);
+
+		// Threads which did not get a worker slot fall back to a list of nodes
 		struct _Node
 		{
-			size_t _Key;
+			unsigned int _Key;
 			_Ty _Value;
 			_Node* _Chain;
 
-			_Node(size_t _K, _Ty _FwdItialValue)
+			_Node(unsigned int _K, _Ty _FwdItialValue)
 				: _Key(_K), _Value(_FwdItialValue), _Chain(nullptr)
 			{
 			}
 		};
-#pragma warning(pop)
 
 		static _Ty _Default_init()
 		{
@@ -125,8 +153,9 @@ namespace details {
 		/// </remarks>
 		/// <seealso cref="Parallel Containers and Objects"/>
 		combinable(const combinable& _Copy)
-			: _Size(_Copy._Size), _Fn_initialize(_Copy._Fn_initialize)
+			: _Fn_initialize(_Copy._Fn_initialize)
 		{
+			_FwdItNew();
 			_FwdItCopy(_Copy);
 		}
 
@@ -141,11 +170,12 @@ namespace details {
 		/// </returns>
 		combinable& operator=(const combinable& _Copy)
 		{
-			clear();
-			delete [] _Buckets;
-			_Fn_initialize = _Copy._Fn_initialize;
-			_Size = _Copy._M_size;
-			_FwdItCopy(_Copy);
+			if (this != &_Copy)
+			{
+				clear();
+				_Fn_initialize = _Copy._Fn_initialize;
+				_FwdItCopy(_Copy);
+			}
 
 			return *this;
 		}
@@ -156,7 +186,7 @@ namespace details {
 		~combinable()
 		{
 			clear();
-			delete [] _Buckets;
+			_Release_slot_block(_Slots, _Slot_stride);
 		}
 
 		/// <summary>
@@ -186,13 +216,23 @@ namespace details {
 		/// <seealso cref="Parallel Containers and Objects"/>
 		_Ty& local(bool& _Exists)
 		{
+			unsigned int _Index = get_current_worker_slot();
+			if (_Index < _Size)
+			{
+				_Slot& _CurrentSlot = _GetSlot(_Index);
+				_Exists = _CurrentSlot._Constructed;
+				if (!_Exists)
+					_ConstructSlot(_CurrentSlot, _Index, _Fn_initialize());
+
+				return _Value(_CurrentSlot);
+			}
+
 			auto _Key = get_current_thread_id();
-			size_t _Index;
-			_Node* _ExistingNode = _FindLocalItem(_Key, &_Index);
+			_Node* _ExistingNode = _FindLocalItem(_Key);
 			if (_ExistingNode == nullptr)
 			{
 				_Exists = false;
-				_ExistingNode = _AddLocalItem(_Key, _Index);
+				_ExistingNode = _AddLocalItem(_Key);
 			}
 			else
 			{
@@ -208,17 +248,25 @@ namespace details {
 		/// </summary>
 		void clear()
 		{
-			for (size_t _Index = 0; _Index < _Size; ++_Index)
+			unsigned int _Top = _Top_slot.load(std::memory_order_relaxed);
+			for (unsigned int _Index = 0; _Index < _Top; ++_Index)
 			{
-				_Node* _CurrentNode = _Buckets[_Index];
-				while (_CurrentNode != nullptr)
+				_Slot& _CurrentSlot = _GetSlot(_Index);
+				if (_CurrentSlot._Constructed)
 				{
-					_Node* _NextNode = _CurrentNode->_Chain;
-					delete _CurrentNode;
-					_CurrentNode = _NextNode;
+					_Value(_CurrentSlot).~_Ty();
+					_CurrentSlot._Constructed = false;
 				}
 			}
-			memset((void*) _Buckets, 0, _Size * sizeof _Buckets[0]);
+			_Top_slot.store(0, std::memory_order_relaxed);
+
+			_Node* _CurrentNode = _Overflow.exchange(nullptr);
+			while (_CurrentNode != nullptr)
+			{
+				_Node* _NextNode = _CurrentNode->_Chain;
+				delete _CurrentNode;
+				_CurrentNode = _NextNode;
+			}
 		}
 
 		/// <summary>
@@ -238,43 +286,40 @@ namespace details {
 		template<typename _Function>
 		_Ty combine(_Function _Fn_combine) const
 		{
-			_Node* _CurrentNode = nullptr;
-			size_t _Index;
+			unsigned int _Top = _Top_slot.load(std::memory_order_relaxed);
+			unsigned int _Index = 0;
 
 			// Look for the first value in the set, and use (a copy of) that as the result.
 			// This eliminates a single call (of unknown cost) to _Fn_initialize.
-			for (_Index = 0; _Index < _Size; ++_Index)
-			{
-				_CurrentNode = _Buckets[_Index];
-				if (_CurrentNode != nullptr)
-				{
-					break;
-				}
-			}
+			while (_Index < _Top && !_GetSlot(_Index)._Constructed)
+				++_Index;
 
-			// No values... return the initializer value.
-			if (_CurrentNode == nullptr)
+			_Node* _CurrentNode = _Overflow.load();
+			if (_Index == _Top)
 			{
-				return _Fn_initialize();
-			}
+				// No values... return the initializer value.
+				if (_CurrentNode == nullptr)
+					return _Fn_initialize();
 
-			// Accumulate the rest of the items in the current bucket.
-			_Ty _Result = _CurrentNode->_Value;
-			for (_CurrentNode = _CurrentNode->_Chain; _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
-			{
-				_Result = _Fn_combine(_Result, _CurrentNode->_Value);
+				_Ty _Result = _CurrentNode->_Value;
+				for (_CurrentNode = _CurrentNode->_Chain; _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
+					_Result = _Fn_combine(_Result, _CurrentNode->_Value);
+
+				return _Result;
 			}
 
-			// Accumulate values from the rest of the buckets.
-			_ASSERTE(_Index < _Size);
-			for (++_Index; _Index < _Size; ++_Index)
+			// Accumulate the rest of the slots, then the threads which did not get one.
+			_Ty _Result = _Value(_GetSlot(_Index));
+			for (++_Index; _Index < _Top; ++_Index)
 			{
-				for (_CurrentNode = _Buckets[_Index]; _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
-				{
-					_Result = _Fn_combine(_Result, _CurrentNode->_Value);
-				}
+				const _Slot& _CurrentSlot = _GetSlot(_Index);
+				if (_CurrentSlot._Constructed)
+					_Result = _Fn_combine(_Result, _Value(_CurrentSlot));
 			}
 
+			for (; _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
+				_Result = _Fn_combine(_Result, _CurrentNode->_Value);
+
 			return _Result;
 		}
 
@@ -293,12 +338,17 @@ namespace details {
 		template<typename _Function>
 		void combine_each(_Function _Fn_combine) const
 		{
-			for (size_t _Index = 0; _Index < _Size; ++_Index)
+			unsigned int _Top = _Top_slot.load(std::memory_order_relaxed);
+			for (unsigned int _Index = 0; _Index < _Top; ++_Index)
 			{
-				for (_Node* _CurrentNode = _Buckets[_Index]; _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
-				{
-					_Fn_combine(_CurrentNode->_Value);
-				}
+				const _Slot& _CurrentSlot = _GetSlot(_Index);
+				if (_CurrentSlot._Constructed)
+					_Fn_combine(_Value(_CurrentSlot));
+			}
+
+			for (_Node* _CurrentNode = _Overflow.load(); _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
+			{
+				_Fn_combine(_CurrentNode->_Value);
 			}
 		}
 
@@ -307,98 +357,86 @@ namespace details {
 			return _Size;
 		}
 	private:
-		size_t _GetCombinableSize() const _NOEXCEPT
+		void _FwdItNew()
 		{
-			// Candidate primes... these must be sorted.  Note that this isn't a complete list of primes, and is
-			// capped at reasonable level (e.g., a size of 281 means you expect to have about that many threads).
-			static const unsigned long _Candidate_primes [] = {
-				11, 19, 37, 67, 73, 151, 281
-			};
-			const int _Num_candidate_primes = sizeof _Candidate_primes / sizeof _Candidate_primes[0];
-
-			size_t _CombinableSize = get_hardware_concurrency();
+			_Size = get_worker_slot_count();
+			_Slots = static_cast<char*>(_Acquire_slot_block(_Slot_stride));
+			_Top_slot.store(0, std::memory_order_relaxed);
+			_Overflow.store(nullptr, std::memory_order_relaxed);
+		}
 
-			// ConcRT gave us the number of vprocs.
-			_CombinableSize *= 2;
-			int _Index;
-			for (_Index = 0; _Index < _Num_candidate_primes; ++_Index)
+		void _FwdItCopy(const combinable& _Copy)
+		{
+			unsigned int _Top = _Copy._Top_slot.load(std::memory_order_relaxed);
+			for (unsigned int _Index = 0; _Index < _Top; ++_Index)
 			{
-				if (_CombinableSize < _Candidate_primes[_Index])
-					break;
+				const _Slot& _CurrentSlot = _Copy._GetSlot(_Index);
+				if (_CurrentSlot._Constructed)
+					_ConstructSlot(_GetSlot(_Index), _Index, _Value(_CurrentSlot));
 			}
 
-			if (_Index < _Num_candidate_primes)
-				_CombinableSize = _Candidate_primes[_Index];
-			else
-				_CombinableSize = _Candidate_primes[_Num_candidate_primes - 1];
-
-			return _CombinableSize;
+			for (_Node* _CurrentNode = _Copy._Overflow.load(); _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
+			{
+				_Node* _NewNode = new _Node(_CurrentNode->_Key, _CurrentNode->_Value);
+				_NewNode->_Chain = _Overflow.load(std::memory_order_relaxed);
+				_Overflow.store(_NewNode, std::memory_order_relaxed);
+			}
 		}
 
-		void _FwdItNew()
+		_Slot& _GetSlot(unsigned int _Index) const
 		{
-			_Size = _GetCombinableSize();
-			_Buckets = new _Node*[_Size];
-			memset((void*) _Buckets, 0, _Size * sizeof _Buckets[0]);
+			return *reinterpret_cast<_Slot*>(_Slots + _Index * _Slot_stride);
 		}
 
-		void _FwdItCopy(const combinable& _Copy)
+		static _Ty& _Value(const _Slot& _CurrentSlot)
 		{
-			_Buckets = new _Node*[_Size];
-			for (size_t _Index = 0; _Index < _Size; ++_Index)
-			{
-				_Buckets[_Index] = nullptr;
-				for (_Node* _CurrentNode = _Copy._Buckets[_Index]; _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
-				{
-					_Node* _NewNode = new _Node(_CurrentNode->_Key, _CurrentNode->_Value);
-					_NewNode->_Chain = _Buckets[_Index];
-					_Buckets[_Index] = _NewNode;
-				}
-			}
+			return *reinterpret_cast<_Ty*>(const_cast<void*>(static_cast<const void*>(&_CurrentSlot._Storage)));
 		}
 
-		_Node* _FindLocalItem(size_t _Key, size_t* _PIndex)
+		void _ConstructSlot(_Slot& _CurrentSlot, unsigned int _Index, const _Ty& _InitialValue)
 		{
-			_ASSERTE(_PIndex != nullptr);
+			new (&_CurrentSlot._Storage) _Ty(_InitialValue);
+			_CurrentSlot._Constructed = true;
 
-			*_PIndex = _Key % _Size;
+			// Readers run after the parallel region has been joined, relaxed ordering is enough
+			unsigned int _Top = _Top_slot.load(std::memory_order_relaxed);
+			while (_Top <= _Index && !_Top_slot.compare_exchange_weak(_Top, _Index + 1, std::memory_order_relaxed))
+				;
+		}
 
-			// Search at this index for an existing value.
-			_Node* _CurrentNode = _Buckets[*_PIndex];
-			while (_CurrentNode != nullptr)
+		_Node* _FindLocalItem(unsigned int _Key) const
+		{
+			for (_Node* _CurrentNode = _Overflow.load(); _CurrentNode != nullptr; _CurrentNode = _CurrentNode->_Chain)
 			{
 				if (_CurrentNode->_Key == _Key)
 				{
 					return _CurrentNode;
 				}
-
-				_CurrentNode = _CurrentNode->_Chain;
 			}
 
 			return nullptr;
 		}
 
-		_Node* _AddLocalItem(size_t _Key, size_t _Index)
+		_Node* _AddLocalItem(unsigned int _Key)
 		{
 			_Node* _NewNode = new _Node(_Key, _Fn_initialize());
-			_Node* _TopNode;
+			_Node* _TopNode = _Overflow.load();
 			do
 			{
-				_TopNode = _Buckets[_Index];
 				_NewNode->_Chain = _TopNode;
-			} while (_InterlockedCompareExchangePointer(reinterpret_cast<void * volatile *>(&_Buckets[_Index]), _NewNode, _TopNode) != _TopNode);
+			} while (!_Overflow.compare_exchange_weak(_TopNode, _NewNode));
 
 			return _NewNode;
 		}
 
 	private:
-		_Node *volatile * _Buckets;
+		char* _Slots; // _Size slots, _Slot_stride bytes apart
 		size_t _Size;
+		std::atomic<unsigned int> _Top_slot; // one past the highest constructed slot
+		std::atomic<_Node*> _Overflow;
 		std::function<_Ty()> _Fn_initialize;
 	};
 
-#pragma warning(pop) // C4316
-
 	// Helper that picks the lowest common iterator type from given iterator tags
 	template<class _IterTag0, class _IterTag1>
 	struct common_iterator_helper
@@ -487,29 +525,37 @@ namespace details {
 		std::tuple<_It...>,
 		typename iterator_traits<typename extract_iterator<_It...>::iterator>::difference_type>
 	{
+	public:
+		// The members of a dependent base are not found by unqualified lookup
+		typedef std::tuple<_It...> value_type;
+		typedef typename iterator_traits<typename extract_iterator<_It...>::iterator>::difference_type difference_type;
+		typedef value_type* pointer;
+		// The iterators are handed out by value, operator[] has no element to refer to
+		typedef value_type reference;
+
 	private:
-		template<typename _Tuple, size_t _Count>
+		template<typename _Tuple, int _Count>
 		struct iterate
 		{
 			static void increment(_Tuple& _T)
 			{
-				auto &_It = std::get<_Count>(_T);
-				++_It;
+				auto &_Iter = std::get<_Count>(_T);
+				++_Iter;
 				iterate<_Tuple, _Count - 1>::increment(_T);
 			}
 
 			static void decrement(_Tuple& _T)
 			{
-				auto &_It = std::get<_Count>(_T);
-				--_It;
+				auto &_Iter = std::get<_Count>(_T);
+				--_Iter;
 
 				iterate<_Tuple, _Count - 1>::decrement(_T);
 			}
 
 			static void offset(_Tuple& _T, difference_type _Off)
 			{
-				auto &_It = std::get<_Count>(_T);
-				_It += _Off;
+				auto &_Iter = std::get<_Count>(_T);
+				_Iter += _Off;
 
 				iterate<_Tuple, _Count - 1>::offset(_T, _Off);
 			}
@@ -539,7 +585,7 @@ namespace details {
 
 		composable_iterator_base() {}
 
-		reference operator*()
+		reference operator*() const
 		{	// return designated object
 			return _Myval;
 		}
@@ -548,7 +594,7 @@ namespace details {
 		{
 			static_assert(!std::is_same<_IterCat, std::output_iterator_tag>::value, "Not supported for output iterator.");
 			// return pointer to class object
-			return (_STD pointer_traits<pointer>::pointer_to(**this));
+			return (std::pointer_traits<pointer>::pointer_to(**this));
 		}
 
 		_Myiter& operator++()
@@ -623,9 +669,9 @@ namespace details {
 		{
 			static_assert(std::is_same<_IterCat, std::random_access_iterator_tag>::value, "Supported for random access iterator only.");
 
-			value_type _It = _Myval;
-			iterate<value_type, std::tuple_size<value_type>::value - 1>::offset(_It, _Off);
-			return _It;
+			value_type _Val = _Myval;
+			iterate<value_type, std::tuple_size<value_type>::value - 1>::offset(_Val, _Off);
+			return _Val;
 		}
 
 		bool operator==(const _Myiter& _Right) const
@@ -672,22 +718,24 @@ namespace details {
 	class composable_iterator :
 		public composable_iterator_base<typename common_iterator<_It...>::iterator_category, _It...>
 	{
+		typedef composable_iterator_base<typename common_iterator<_It...>::iterator_category, _It...> _Mybase;
 	public:
 		composable_iterator(const _It&... _Val) :
-			composable_iterator_base(_Val...) {}
+			_Mybase(_Val...) {}
 
-		composable_iterator() : composable_iterator_base() {}
+		composable_iterator() : _Mybase() {}
 	};
 
 	template<typename _It>
 	class composable_iterator<_It> :
 		public composable_iterator_base<typename std::iterator_traits<_It>::iterator_category, _It>
 	{
+		typedef composable_iterator_base<typename std::iterator_traits<_It>::iterator_category, _It> _Mybase;
 	public:
 		composable_iterator(const _It& _Val) :
-			composable_iterator_base(_Val) {}
+			_Mybase(_Val) {}
 
-		composable_iterator() : composable_iterator_base() {}
+		composable_iterator() : _Mybase() {}
 	};
 
 	template<typename ... _It>
@@ -787,7 +835,7 @@ namespace details {
 #pragma warning(push)
 #pragma warning(disable: 4324)			
 	template <typename _It, typename _UserData, typename _Callback>
-	class __declspec(align(64)) _Static_chore_noexcept :
+	class _EXP_ALIGN(64) _Static_chore_noexcept :
 		public _Contextaware_waitable_chore
 	{
 	protected:
@@ -818,9 +866,11 @@ namespace details {
 	};
 
 	template <typename _It, typename _UserData, typename _Callback>
-	class __declspec(align(64)) _Static_chore :
+	class _EXP_ALIGN(64) _Static_chore :
 		public _Static_chore_noexcept<_It, _UserData, _Callback>
 	{
+		typedef _Static_chore_noexcept<_It, _UserData, _Callback> _Mybase;
+
 		_Static_chore& operator=(const _Static_chore&) {}
 
 		std::exception_ptr _Exception;
@@ -830,15 +880,15 @@ namespace details {
 		}
 
 		_Static_chore(_It _First, size_t _Count, _UserData _Data, const _Callback& _Func) :
-			_Static_chore_noexcept(std::move(_First), _Count, std::move(_Data), _Func), _Exception(nullptr)
+			_Mybase(std::move(_First), _Count, std::move(_Data), _Func), _Exception(nullptr)
 		{
 		}
 
 		virtual void waitable_invoke() override
 		{
 			try {
-				_ASSERTE(_Count > 0);
-				_AlgoCallback(_Begin, _Count, _AlgoData);
+				_ASSERTE(this->_Count > 0);
+				this->_AlgoCallback(this->_Begin, this->_Count, this->_AlgoData);
 			}
 			catch (...) {
 				_Exception = std::current_exception();
@@ -862,8 +912,9 @@ namespace details {
 			std::list<std::exception_ptr> _ExList;
 			for (auto &_Chore : _Range)
 			{
+				// Copied, _For_each_with_cleanup looks at the exception of every chore after the wait
 				if (_Chore._Exception != nullptr)
-					_ExList.push_back(std::move(_Chore._Exception));
+					_ExList.push_back(_Chore._Exception);
 			}
 
 			if (!_ExList.empty())
@@ -973,6 +1024,9 @@ namespace details {
 	struct copy_partitioner_tag {};
 	struct remove_partitioner_tag {};
 
+	// User data of the partitioned loops whose callback only takes the chunk
+	struct _No_user_data {};
+
 
 	template<typename _PartTag, bool _IsNoExcept = std::is_base_of<parallel_vector_execution_policy, _PartTag>::value>
 	struct _Partitioner;
@@ -1022,22 +1076,32 @@ namespace details {
 				_Chores.emplace_back(_First, _Count, _Data, _Func);
 				_Chores.back().invoke();
 
-				std::iterator_traits<_Container::iterator>::value_type::wait(_Chores);
+				std::iterator_traits<typename _Container::iterator>::value_type::wait(_Chores);
 			}
 			std::advance(_First, _Count);
 			return _First;
 		}
 	public:
-		template<typename _FwdIt, typename _UserData, typename _Callback>
+		// The integral _Callback of the overload below would be a chunk size
+		template<typename _FwdIt, typename _UserData, typename _Callback, typename = typename std::enable_if<!std::is_integral<_Callback>::value>::type>
 		static _FwdIt _For_Each(_FwdIt _First, size_t _Count, _UserData _Data, const _Callback& _Func, size_t _Chunk_size = 0)
 		{
-			typedef std::conditional < _IsNoExcept, _Static_chore_noexcept<_FwdIt, _UserData, _Callback>,
+			typedef typename std::conditional < _IsNoExcept, _Static_chore_noexcept<_FwdIt, _UserData, _Callback>,
 				_Static_chore < _FwdIt, _UserData, _Callback >> ::type _ChoreType;
 			std::vector<_ChoreType> _Chores;
 
 			return _For_Each_impl(_Chores, std::move(_First), _Count, std::move(_Data), _Func, _Chunk_size);
 		}
 
+		// Without user data, _Func(_Begin, _Count) is called for every chunk
+		template<typename _FwdIt, typename _Callback>
+		static _FwdIt _For_Each(_FwdIt _First, size_t _Count, const _Callback& _Func, size_t _Chunk_size = 0)
+		{
+			return _For_Each(std::move(_First), _Count, _No_user_data(), [&_Func](_FwdIt _Begin, size_t _Chunk_count, _No_user_data&) {
+				_Func(std::move(_Begin), _Chunk_count);
+			}, _Chunk_size);
+		}
+
 		template<typename _FwdIt, typename _UserData, typename _Callback, typename _Cleanup_callback>
 		static _FwdIt _For_each_with_cleanup(_FwdIt _First, size_t _Count, _UserData _Data, const _Callback& _Func, _Cleanup_callback _Cleanup, size_t _Chunk_size = 0)
 		{
@@ -1080,8 +1144,10 @@ namespace details {
 				const unsigned int _HdConc = get_hardware_concurrency();
 				size_t _Chores_size = 1;
 
+				// On a single core the first step would take the whole range and leave an empty chore behind,
+				// the range is then run inline as the last chore
 				size_t _Count_tmp = _Count;
-				while (_Count_tmp > _Chunk_size)
+				while (_Count_tmp > _Chunk_size && _HdConc > 1)
 				{
 					size_t _Step = (std::max)(_Count_tmp / _HdConc, _Chunk_size);
 					_Count_tmp -= _Step;
@@ -1091,7 +1157,7 @@ namespace details {
 				_Tracker._AddPartitions(_Chores_size - 1);
 				_Chores.reserve(_Chores_size);
 
-				while (_Count > _Chunk_size)
+				while (_Count > _Chunk_size && _HdConc > 1)
 				{
 					size_t _Step = (std::max)(_Count / _HdConc, _Chunk_size);
 					_Chores.emplace_back(_First, _Step, _Data, _Func);
@@ -1102,23 +1168,31 @@ namespace details {
 
 				_Chores.emplace_back(_First, _Count, _Data, _Func);
 				_Chores.back().invoke();
-				std::iterator_traits<_Container::iterator>::value_type::wait(_Chores);
+				std::iterator_traits<typename _Container::iterator>::value_type::wait(_Chores);
 			}
 
 			std::advance(_First, _Count);
 			return _First;
 		}
 	public:
-		template<typename _FwdIt, typename _UserData, typename _Callback>
+		template<typename _FwdIt, typename _UserData, typename _Callback, typename = typename std::enable_if<!std::is_integral<_Callback>::value>::type>
 		static _FwdIt _For_Each(_FwdIt _First, size_t _Count, _UserData _Data, const _Callback& _Func, size_t _Chunk_size = 0)
 		{
-			typedef std::conditional < _IsNoExcept, _Static_chore_noexcept<_FwdIt, _UserData, _Callback>,
+			typedef typename std::conditional < _IsNoExcept, _Static_chore_noexcept<_FwdIt, _UserData, _Callback>,
 				_Static_chore < _FwdIt, _UserData, _Callback >> ::type _ChoreType;
 
 			std::vector<_ChoreType> _Chores;
 
 			return _For_Each_impl(_Chores, std::move(_First), _Count, std::move(_Data), _Func, _Chunk_size);
 		}
+
+		template<typename _FwdIt, typename _Callback>
+		static _FwdIt _For_Each(_FwdIt _First, size_t _Count, const _Callback& _Func, size_t _Chunk_size = 0)
+		{
+			return _For_Each(std::move(_First), _Count, _No_user_data(), [&_Func](_FwdIt _Begin, size_t _Chunk_count, _No_user_data&) {
+				_Func(std::move(_Begin), _Chunk_count);
+			}, _Chunk_size);
+		}
 	};
 
 	template<typename _OutIt, typename _DiffType = typename std::iterator_traits<_OutIt>::difference_type>
@@ -1151,7 +1225,7 @@ namespace details {
 			return _Out;
 		}
 
-		template <typename _It, typename _OutIt, typename _First_stage, typename _Second_stage> friend class _Copy_chore;
+		template <typename _It, typename _OutToken, typename _First_stage, typename _Second_stage> friend class _Copy_chore;
 	public:
 		void move(_Output_token& _Token)
 		{
@@ -1202,7 +1276,7 @@ namespace details {
 			return std::pair<_OutIt, _OutIt2>(_Out, _Out2);
 		}
 
-		template <typename _It, typename _OutIt, typename _First_stage, typename _Second_stage> friend class _Copy_chore;
+		template <typename _It, typename _OutToken, typename _First_stage, typename _Second_stage> friend class _Copy_chore;
 	public:
 		void move(_Output_token_double& _Token)
 		{
@@ -1219,12 +1293,213 @@ namespace details {
 		}
 	};
 
+	//
+	// Predicate mask of the filtering algorithms (copy_if, remove_if, unique): the filtering stage stores one bit per
+	// element in 64 bit words and counts the set bits, the copy stage then writes the selected elements. The chunks of
+	// the copy partitioner are whole words (_Mask_chunk_size), thus every word is written by a single chore.
+	//
+	typedef uint64_t _Mask_word;
+	const size_t _Mask_word_bits = 64;
+
+	inline size_t _Mask_chunk_size(size_t _Count)
+	{
+		const size_t _HdConc = get_hardware_concurrency();
+		const size_t _Chunk = (_Count + _HdConc - 1) / _HdConc;
+		return (std::max)(size_t{ 1 }, (_Chunk + _Mask_word_bits - 1) / _Mask_word_bits) * _Mask_word_bits;
+	}
+
+	inline size_t _Mask_popcount(_Mask_word _Bits)
+	{
+		_Bits = _Bits - ((_Bits >> 1) & 0x5555555555555555ull);
+		_Bits = (_Bits & 0x3333333333333333ull) + ((_Bits >> 2) & 0x3333333333333333ull);
+		_Bits = (_Bits + (_Bits >> 4)) & 0x0f0f0f0f0f0f0f0full;
+		return static_cast<size_t>((_Bits * 0x0101010101010101ull) >> 56);
+	}
+
+	// Index of the lowest set bit, _Bits must not be 0
+	inline unsigned int _Mask_lowest_bit(_Mask_word _Bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long _Index;
+#if defined(_M_X64) || defined(_M_ARM64)
+		_BitScanForward64(&_Index, _Bits);
+#else
+		if (!_BitScanForward(&_Index, static_cast<unsigned long>(_Bits)))
+		{
+			_BitScanForward(&_Index, static_cast<unsigned long>(_Bits >> 32));
+			_Index += 32;
+		}
+#endif
+		return _Index;
+#else
+		return static_cast<unsigned int>(__builtin_ctzll(_Bits));
+#endif
+	}
+
+	// Position in the mask, composed with the iterator over the filtered elements to follow the chunks
+	class _Mask_iterator : public std::iterator<std::random_access_iterator_tag, bool>
+	{
+		_Mask_word *_Words;
+		difference_type _Pos;
+	public:
+		_Mask_iterator() : _Words(nullptr), _Pos(0)
+		{
+		}
+
+		_Mask_iterator(_Mask_word *_W, difference_type _P) : _Words(_W), _Pos(_P)
+		{
+		}
+
+		// First word of a chunk
+		_Mask_word *word() const
+		{
+			_ASSERT(_Pos >= 0 && _Pos % _Mask_word_bits == 0);
+			return _Words + _Pos / _Mask_word_bits;
+		}
+
+		_Mask_iterator& operator++()
+		{
+			++_Pos;
+			return *this;
+		}
+
+		_Mask_iterator& operator--()
+		{
+			--_Pos;
+			return *this;
+		}
+
+		_Mask_iterator& operator+=(difference_type _Off)
+		{
+			_Pos += _Off;
+			return *this;
+		}
+
+		difference_type operator-(const _Mask_iterator& _Right) const
+		{
+			return _Pos - _Right._Pos;
+		}
+
+		bool operator==(const _Mask_iterator& _Right) const
+		{
+			return _Pos == _Right._Pos;
+		}
+
+		bool operator!=(const _Mask_iterator& _Right) const
+		{
+			return _Pos != _Right._Pos;
+		}
+	};
+
+	// Filtering stage of a chunk: sets the bits of the _Count elements from _First for which _Pred(iterator) holds,
+	// returns their number
+	template<class _InIt, class _Pr>
+	size_t _Fill_mask(_InIt _First, size_t _Count, _Mask_word *_Words, _Pr& _Pred)
+	{
+		size_t _Sum = 0;
+		for (; _Count > 0; ++_Words)
+		{
+			const size_t _Len = (std::min)(_Count, _Mask_word_bits);
+			_Mask_word _Bits = 0;
+			for (size_t _I = 0; _I < _Len; ++_I, ++_First)
+				_Bits |= static_cast<_Mask_word>(_Pred(_First) ? 1 : 0) << _I;
+
+			*_Words = _Bits;
+			_Sum += _Mask_popcount(_Bits);
+			_Count -= _Len;
+		}
+		return _Sum;
+	}
+
+	// How the copy stage writes the selected elements
+	struct _Copy_selected
+	{
+		template<class _OutIt, class _InIt>
+		static void element(_OutIt& _Dest, _InIt _It)
+		{
+			*_Dest = *_It;
+			++_Dest;
+		}
+
+		template<class _OutIt, class _InIt>
+		static void range(_OutIt& _Dest, _InIt _First, _InIt _Last)
+		{
+			_Dest = std::copy(_First, _Last, _Dest);
+		}
+	};
+
+	// Within one sequence, the destination never passes the source. Elements already in place are not moved onto
+	// themselves, which leaves some types (std::string) empty.
+	struct _Move_selected
+	{
+		template<class _FwdIt>
+		static void element(_FwdIt& _Dest, _FwdIt _It)
+		{
+			if (_Dest != _It)
+				*_Dest = std::move(*_It);
+			++_Dest;
+		}
+
+		template<class _FwdIt>
+		static void range(_FwdIt& _Dest, _FwdIt _First, _FwdIt _Last)
+		{
+			if (_Dest == _First)
+				std::advance(_Dest, std::distance(_First, _Last));
+			else
+				_Dest = std::move(_First, _Last, _Dest);
+		}
+	};
+
+	// Copy stage of a chunk: writes the elements from _First whose bit is set
+	template<class _Selected, class _InIt, class _OutIt, class _IterCat>
+	_OutIt _Compact_masked(_InIt _First, size_t _Count, const _Mask_word *_Words, _OutIt _Dest, _IterCat)
+	{
+		for (; _Count > 0; ++_Words)
+		{
+			const size_t _Len = (std::min)(_Count, _Mask_word_bits);
+			const _Mask_word _Bits = *_Words;
+			if (_Bits == 0)
+				std::advance(_First, _Len);
+			else
+			{
+				for (size_t _I = 0; _I < _Len; ++_I, ++_First)
+					if ((_Bits >> _I) & 1)
+						_Selected::element(_Dest, _First);
+			}
+			_Count -= _Len;
+		}
+		return _Dest;
+	}
+
+	// Random access input jumps from one set bit to the next and writes full words as one range (memmove for
+	// trivially copyable types)
+	template<class _Selected, class _InIt, class _OutIt>
+	_OutIt _Compact_masked(_InIt _First, size_t _Count, const _Mask_word *_Words, _OutIt _Dest, std::random_access_iterator_tag)
+	{
+		for (; _Count > 0; ++_Words, _First += _Mask_word_bits)
+		{
+			const size_t _Len = (std::min)(_Count, _Mask_word_bits);
+			_Mask_word _Bits = *_Words;
+			if (_Bits == ~_Mask_word{ 0 })
+				_Selected::range(_Dest, _First, _First + _Mask_word_bits);
+			else
+			{
+				for (; _Bits != 0; _Bits &= _Bits - 1)
+					_Selected::element(_Dest, _First + _Mask_lowest_bit(_Bits));
+			}
+
+			if ((_Count -= _Len) == 0)
+				break;
+		}
+		return _Dest;
+	}
+
 	// Disable warning C4324: structure was padded due to __declspec(align())
 	// This padding is expected and necessary.
 #pragma warning(push)
 #pragma warning(disable: 4324)
 	template <typename _It, typename _OutToken, typename _First_stage, typename _Second_stage>
-	class __declspec(align(64)) _Copy_chore : public _Contextaware_waitable_chore
+	class _EXP_ALIGN(64) _Copy_chore : public _Contextaware_waitable_chore
 	{
 	protected:
 		enum _ChoreInternalState {
@@ -1330,28 +1605,29 @@ namespace details {
 				throw exception_list(std::move(_ExList));
 		}
 
-		template <typename _It, typename _OutToken, typename _First_stage, typename _Second_stage>
+		template <typename _It2, typename _OutToken2, typename _First_stage2, typename _Second_stage2>
 		friend class _Remove_chore;
 	};
 
 	template <typename _It, typename _OutToken, typename _First_stage, typename _Second_stage>
-	class __declspec(align(64)) _Remove_chore :
+	class _EXP_ALIGN(64) _Remove_chore :
 		public _Copy_chore<_It, _OutToken, _First_stage, _Second_stage>
 	{
+		typedef _Copy_chore<_It, _OutToken, _First_stage, _Second_stage> _Mybase;
 	public:
 		_Remove_chore(_It _First, size_t _S, _OutToken _Dest, const _First_stage& _St1, const _Second_stage& _St2, bool _Is_first = false) :
-			_Copy_chore(_First, _S, _Dest, _St1, _St2, _Is_first)
+			_Mybase(_First, _S, _Dest, _St1, _St2, _Is_first)
 		{
 		}
 
 		virtual void waitable_invoke() override
 		{
 			try {
-				if (is_started())
-					_Stage1(_Begin, _Size, _Output);
+				if (this->is_started())
+					this->_Stage1(this->_Begin, this->_Size, this->_Output);
 
-				if (try_filter()) { // Check if the output buffer position was set
-					_Copy_chore* _Next = this;
+				if (this->try_filter()) { // Check if the output buffer position was set
+					_Mybase* _Next = this;
 					do {
 						// If none of the element was filtered there will be no copy to the buffer
 						// Skipping the stage2 handler
@@ -1370,7 +1646,7 @@ namespace details {
 				}
 			}
 			catch (...) {
-				_Exception = std::current_exception();
+				this->_Exception = std::current_exception();
 			}
 		}
 	};
@@ -1444,7 +1720,7 @@ namespace details {
 		{
 			typedef _Remove_chore<_FwdIt, _OutToken, _First_stage, _Second_stage> _ChoreType;
 
-			return _For_Each_impl<_ChoreType>(_First, _Count, _Dest, _Stage1, _Stage2, _Chunk_size);
+			return _Partitioner<copy_partitioner_tag, _IsNoExcept>::template _For_Each_impl<_ChoreType>(_First, _Count, _Dest, _Stage1, _Stage2, _Chunk_size);
 		}
 	};
 
@@ -1501,34 +1777,41 @@ namespace details {
 	{
 	};
 
+	// parallel_deterministic_execution_policy only changes how reductions combine, loops are partitioned as for par
+	template<bool _IsNoExcept>
+	struct _Partitioner<parallel_deterministic_execution_policy, _IsNoExcept> :
+		public _Partitioner<auto_partitioner_tag, _IsNoExcept>
+	{
+	};
+
 	// Abstracting loop helpers
 	template <typename _ExPolicy, typename _It, typename _IterCat = typename std::iterator_traits<_It>::iterator_category>
 	struct LoopHelper
 	{
 		template<typename _Fn>
-		static _It Loop(_It _It, size_t _Count, const _Fn& _Func)
+		static _It Loop(_It _First, size_t _Count, const _Fn& _Func)
 		{
 			for (; 0 < _Count; --_Count) {
-				_Func(*_It);
-				++_It;
+				_Func(*_First);
+				++_First;
 			}
 
-			return _It;
+			return _First;
 		}
 
 		template<typename _Fn, typename _CancellationToken>
-		static _It Loop(_It _It, size_t _Count, const _Fn& _Func, const _CancellationToken& _Token)
+		static _It Loop(_It _First, size_t _Count, const _Fn& _Func, const _CancellationToken& _Token)
 		{
 			for (; 0 < _Count; --_Count) {
-				_Func(*_It);
+				_Func(*_First);
 
 				if (_Token.is_cancelled())
-					return _It;
+					return _First;
 
-				++_It;
+				++_First;
 			}
 
-			return _It;
+			return _First;
 		}
 	};
 
@@ -1536,34 +1819,71 @@ namespace details {
 	struct LoopHelper<_ExPolicy, _It, std::random_access_iterator_tag>
 	{
 		template<typename _Fn>
-		static _It Loop(_It _It, size_t _Count, const _Fn& _Func)
+		static _It Loop(_It _First, size_t _Count, const _Fn& _Func)
 		{
 			for (size_t _I = 0; _I < _Count; ++_I)
-				_Func(_It[_I]);
+				_Func(_First[_I]);
 
-			std::advance(_It, _Count);
-			return _It;
+			std::advance(_First, _Count);
+			return _First;
 		}
 
 		template<typename _Fn, typename _CancellationToken>
-		static _It Loop(_It _It, size_t _Count, const _Fn& _Func, const _CancellationToken& _Token)
+		static _It Loop(_It _First, size_t _Count, const _Fn& _Func, const _CancellationToken& _Token)
 		{
 			size_t _I = 0;
 
 			for (; _I < _Count; ++_I) {
-				_Func(_It[_I]);
+				_Func(_First[_I]);
 
 				if (_Token.is_cancelled())	{
-					std::advance(_It, _I);
-					return _It;
+					std::advance(_First, _I);
+					return _First;
 				}
 			}
 
-			std::advance(_It, _I);
-			return _It;
+			std::advance(_First, _I);
+			return _First;
 		}
 	};
 
+	// Iterator category tag of an iterator, for dispatching on it
+#if defined(_MSC_VER)
+	using std::_Iter_cat;
+#else
+	template <typename _It>
+	inline typename std::iterator_traits<_It>::iterator_category _Iter_cat(const _It&)
+	{
+		return typename std::iterator_traits<_It>::iterator_category();
+	}
+#endif
+
+	// Raw pointer as an output range, without the checked iterator warnings of Visual C++
+#if defined(_MSC_VER)
+	template <typename _Ty>
+	inline stdext::unchecked_array_iterator<_Ty *> _Unchecked_array(_Ty *_Ptr)
+	{
+		return stdext::make_unchecked_array_iterator(_Ptr);
+	}
+#else
+	template <typename _Ty>
+	inline _Ty *_Unchecked_array(_Ty *_Ptr)
+	{
+		return _Ptr;
+	}
+#endif
+
+	// Whether the elements can be assigned through the iterator, output and forward iterators or stronger
+	template <typename _It>
+	struct _Is_mutable_iterator : std::integral_constant<bool,
+#if defined(_MSC_VER)
+		std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_It>::iterator_category>::value>
+#else
+		std::is_base_of<std::output_iterator_tag, typename std::iterator_traits<_It>::iterator_category>::value
+		|| std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_It>::iterator_category>::value>
+#endif
+	{};
+
 	// Contiguous Container Iterator Traits
 	// Please note, it will NOT identify all contiguous iterators. It only tries its best.
 	template <typename _ItrType>
@@ -1648,6 +1968,192 @@ namespace details {
 		}
 	};
 
+	//
+	// Vector kernels of the par_vec searches (src/vector_kernels.cpp): find, count, mismatch and adjacent_find
+	// comparing contiguous arithmetic elements with ==. They use AVX2 or SSE2, whichever the CPU supports, and
+	// the callers hand them blocks of _Vec_block_bytes between two checks of their cancellation token.
+	//
+	enum _Vec_element_kind { _Vec_none, _Vec_int8, _Vec_int16, _Vec_int32, _Vec_int64, _Vec_float, _Vec_double };
+
+	const size_t _Vec_block_bytes = 16 * 1024;
+
+	// Index of the first of the _Count elements equal to *_Val, _Count if there is none
+	_EXP_IMPL size_t __cdecl _Vec_find_equal(const void *_First, size_t _Count, const void *_Val, _Vec_element_kind _Kind);
+
+	// Number of the _Count elements equal to *_Val
+	_EXP_IMPL size_t __cdecl _Vec_count_equal(const void *_First, size_t _Count, const void *_Val, _Vec_element_kind _Kind);
+
+	// Index of the first element not equal to its counterpart from _First2, _Count if there is none
+	_EXP_IMPL size_t __cdecl _Vec_mismatch(const void *_First, const void *_First2, size_t _Count, _Vec_element_kind _Kind);
+
+	// Index of the first element equal to the next one, _Count if there is none. Reads _Count + 1 elements.
+	_EXP_IMPL size_t __cdecl _Vec_adjacent_equal(const void *_First, size_t _Count, _Vec_element_kind _Kind);
+
+	// Micro-kernel of matrix_multiply for double (impl/matrix_multiply.h, same dispatch as the searches): sets the
+	// _Gemm_mr x _Gemm_nr elements of _C, rows _Ldc apart, to the product of a packed panel of A and one of B, or with
+	// _Accumulate adds the product to them
+	const size_t _Gemm_mr = 4;
+	const size_t _Gemm_nr = 8;
+
+	_EXP_IMPL void __cdecl _Gemm_kernel_double(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate);
+
+	template<typename _Ty>
+	struct _Vec_element : std::integral_constant<_Vec_element_kind,
+		std::is_same<_Ty, float>::value ? _Vec_float :
+		std::is_same<_Ty, double>::value ? _Vec_double :
+		!std::is_integral<_Ty>::value || std::is_same<_Ty, bool>::value ? _Vec_none :
+		sizeof(_Ty) == 1 ? _Vec_int8 :
+		sizeof(_Ty) == 2 ? _Vec_int16 :
+		sizeof(_Ty) == 4 ? _Vec_int32 :
+		sizeof(_Ty) == 8 ? _Vec_int64 : _Vec_none>
+	{
+	};
+
+	// par_vec over contiguous elements the kernels know
+	template<typename _ExPolicy, typename _It>
+	struct _Use_vec_kernel : std::integral_constant<bool,
+		std::is_base_of<parallel_vector_execution_policy, typename std::decay<_ExPolicy>::type>::value &&
+		(std::is_pointer<_It>::value || _Contiguous_container_iterator_traits<_It>::value) &&
+		_Vec_element<typename std::iterator_traits<_It>::value_type>::value != _Vec_none>
+	{
+	};
+
+	// Two ranges of the same element type compared with the default predicate
+	template<typename _ExPolicy, typename _It, typename _It2, typename _Pr>
+	struct _Use_vec_kernel2 : std::integral_constant<bool,
+		_Use_vec_kernel<_ExPolicy, _It>::value && _Use_vec_kernel<_ExPolicy, _It2>::value &&
+		std::is_same<typename std::iterator_traits<_It>::value_type, typename std::iterator_traits<_It2>::value_type>::value &&
+		(std::is_same<_Pr, std::equal_to<> >::value || std::is_same<_Pr, std::equal_to<typename std::iterator_traits<_It>::value_type> >::value)>
+	{
+	};
+
+	// A value of another integral type is converted to the element type, if it does not convert back to itself no
+	// element can be equal to it. Any other type is left to the scalar loop.
+	template<typename _Elem, typename _Ty>
+	struct _Vec_key_convertible : std::integral_constant<bool,
+		std::is_same<_Elem, typename std::decay<_Ty>::type>::value ||
+		(std::is_integral<_Elem>::value && std::is_integral<typename std::decay<_Ty>::type>::value && !std::is_same<typename std::decay<_Ty>::type, bool>::value)>
+	{
+	};
+
+	template<typename _Elem, typename _Ty>
+	inline bool _Vec_key(const _Ty& _Val, _Elem& _Key)
+	{
+		_Key = static_cast<_Elem>(_Val);
+		return _Key == _Val;
+	}
+
+	// Runs the search _Search(offset, count) over [0, _Count) in blocks, stops at the first match and as soon as a
+	// match before the block has been found elsewhere. _Pos is the position of the elements in the whole range.
+	template<typename _Ty, typename _Diff, typename _Fn>
+	void _Vec_search_blocks(_Diff _Pos, size_t _Count, cancellation_token_with_position<_Diff>& _Token, const _Fn& _Search)
+	{
+		const size_t _Block = _Vec_block_bytes / sizeof(_Ty);
+
+		for (size_t _Offset = 0; _Offset < _Count; _Offset += _Block)
+		{
+			if (_Token.is_cancelled(_Pos + static_cast<_Diff>(_Offset)))
+				return;
+
+			const size_t _Len = (std::min)(_Block, _Count - _Offset);
+			const size_t _Found = _Search(_Offset, _Len);
+			if (_Found != _Len)
+			{
+				_Token.cancel(_Pos + static_cast<_Diff>(_Offset + _Found));
+				return;
+			}
+		}
+	}
+
+	// Uninitialized storage for up to _Capacity elements
+	template<typename _Ty>
+	class _Scratch_buffer
+	{
+		_Ty *_Data;
+		size_t _Capacity;
+	public:
+		// Asks for an eighth of the previous request each time the allocation fails, the capacity may end up as 0
+		explicit _Scratch_buffer(size_t _Request) : _Data(nullptr), _Capacity(0)
+		{
+			while (_Request > 0)
+			{
+				try
+				{
+					_Data = std::allocator<_Ty>().allocate(_Request);
+					_Capacity = _Request;
+					return;
+				}
+				catch (const std::bad_alloc&)
+				{
+					_Request /= 8;
+				}
+			}
+		}
+
+		~_Scratch_buffer()
+		{
+			if (_Data != nullptr)
+				std::allocator<_Ty>().deallocate(_Data, _Capacity);
+		}
+
+		_Scratch_buffer(const _Scratch_buffer &) = delete;
+		_Scratch_buffer &operator =(const _Scratch_buffer &) = delete;
+
+		_Ty *data() const
+		{
+			return _Data;
+		}
+
+		size_t capacity() const
+		{
+			return _Capacity;
+		}
+	};
+
+	// Destroys the elements constructed in [_Begin, _Begin + _Count) when leaving the scope
+	template<typename _Ty>
+	struct _Constructed_range
+	{
+		_Ty *_Begin;
+		size_t _Count;
+
+		explicit _Constructed_range(_Ty *_B) : _Begin(_B), _Count(0)
+		{
+		}
+
+		~_Constructed_range()
+		{
+			for (size_t _I = 0; _I < _Count; ++_I)
+				_Begin[_I].~_Ty();
+		}
+
+		_Constructed_range(const _Constructed_range &) = delete;
+		_Constructed_range &operator =(const _Constructed_range &) = delete;
+	};
+
+	// Elements constructed in scratch storage, every [first, first + second) range is written by a single task
+	// and destroyed when leaving the scope
+	template<typename _Ty>
+	struct _Constructed_ranges
+	{
+		_Ty *_Base;
+		std::vector<std::pair<size_t, size_t>> _Ranges;
+
+		_Constructed_ranges(_Ty *_B, size_t _Count) : _Base(_B), _Ranges(_Count, std::pair<size_t, size_t>(0, 0))
+		{
+		}
+
+		~_Constructed_ranges()
+		{
+			for (auto& _Range : _Ranges)
+				for (size_t _I = 0; _I < _Range.second; ++_I)
+					_Base[_Range.first + _I].~_Ty();
+		}
+
+		_Constructed_ranges(const _Constructed_ranges &) = delete;
+		_Constructed_ranges &operator =(const _Constructed_ranges &) = delete;
+	};
+
 	template<typename _ExPolicy, typename _Ty>
 	struct _enable_if_parallel :
 		public std::enable_if<
@@ -1667,6 +2173,109 @@ namespace details {
 		_Ty>
 	{
 	};
+
+	//
+	// Loops over array_view and strided_array_view: the outermost dimension is split between the threads and the
+	// elements of a part are walked row by row, a row runs along the innermost dimension from the address of its first
+	// element with the innermost stride. With one dimension the part itself is the row.
+	//
+	template<typename _View>
+	struct _Is_array_view : std::false_type
+	{
+	};
+
+	template<typename _Ty, int _Rank>
+	struct _Is_array_view<D4087::array_view<_Ty, _Rank> > : std::true_type
+	{
+	};
+
+	template<typename _Ty, int _Rank>
+	struct _Is_array_view<D4087::strided_array_view<_Ty, _Rank> > : std::true_type
+	{
+	};
+
+	template<typename _ExPolicy, typename _View, typename _Ty>
+	struct _enable_if_view :
+		public std::enable_if<
+		is_execution_policy<typename std::decay<_ExPolicy>::type>::value &&
+		_Is_array_view<typename std::decay<_View>::type>::value,
+		_Ty>
+	{
+	};
+
+	// Address of the first element, bounds and strides of a view
+	template<typename _Ty, int _Rank>
+	struct _View_layout
+	{
+		_Ty *_Data;
+		D4087::bounds<_Rank> _Bnd;
+		D4087::index<_Rank> _Stride;
+
+		template<typename _View>
+		explicit _View_layout(const _View& _Vw) : _Data(_Vw.size() > 0 ? &_Vw[D4087::index<_Rank>()] : nullptr), _Bnd(_Vw.bounds()), _Stride(_Vw.stride())
+		{
+		}
+
+		_Ty *_Row(const D4087::index<_Rank>& _Origin) const
+		{
+			_Ty *_Ptr = _Data;
+			for (int _I = 0; _I < _Rank; ++_I)
+				_Ptr += _Origin[_I] * _Stride[_I];
+			return _Ptr;
+		}
+	};
+
+	template<typename _View>
+	inline _View_layout<typename _View::value_type, _View::rank> _Make_view_layout(const _View& _Vw)
+	{
+		return _View_layout<typename _View::value_type, _View::rank>(_Vw);
+	}
+
+	// Calls _Row_fn(origin, length) for the rows of the outermost indices [_First, _First + _Count) in row-major order
+	template<int _Rank, typename _RowFn>
+	void _For_each_view_row(const D4087::bounds<_Rank>& _Bnd, ptrdiff_t _First, ptrdiff_t _Count, _RowFn& _Row_fn)
+	{
+		const ptrdiff_t _Length = _Rank == 1 ? _Count : _Bnd[_Rank - 1];
+		if (_Count <= 0 || _Length == 0)
+			return;
+
+		for (int _I = 1; _I < _Rank - 1; ++_I)
+		{
+			if (_Bnd[_I] == 0)
+				return;
+		}
+
+		D4087::index<_Rank> _Idx;
+		_Idx[0] = _First;
+		const D4087::index<_Rank>& _Origin = _Idx;
+		for (;;)
+		{
+			_Row_fn(_Origin, _Length);
+
+			// Carry through the dimensions between the outermost and the innermost one, done once all wrapped around
+			int _Dim = _Rank - 1;
+			while (_Dim-- > 0)
+			{
+				if (++_Idx[_Dim] < (_Dim == 0 ? _First + _Count : _Bnd[_Dim]))
+					break;
+				_Idx[_Dim] = _Dim == 0 ? _First : 0;
+			}
+
+			if (_Dim < 0)
+				return;
+		}
+	}
+
+	// Calls _Func(first, count, _Data&) for the parts the partitioner of _ExPolicy cuts [0, _Units) into
+	template<typename _ExPolicy, typename _UserData, typename _Callback>
+	void _For_each_view_part(ptrdiff_t _Units, _UserData _Data, const _Callback& _Func)
+	{
+		const D4087::bounds<1> _Unit_numbers(_Units);
+		_Partitioner<_ExPolicy>::_For_Each(_Unit_numbers.begin(), static_cast<size_t>(_Units), std::move(_Data),
+			[&_Func](D4087::bounds_iterator<1> _Begin, size_t _Count, _UserData& _Part_data) {
+			_Func((*_Begin)[0], static_cast<ptrdiff_t>(_Count), _Part_data);
+		});
+	}
 }
 _PSTL_NS1_END // std::experimental::experimental::parallel::details
 
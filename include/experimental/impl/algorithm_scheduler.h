@@ -13,7 +13,7 @@ namespace details {
 	{
 	protected:
 		friend _EXP_IMPL void __cdecl schedule_chore(_Threadpool_chore*);
-		void *_Work; // Windows::System::Threading::WorkItemHandler^ or PTP_WORK
+		void *_Work; // Windows::System::Threading::WorkItemHandler^, PTP_WORK or the owning _Thread_scheduler
 
 	public:
 		bool is_scheduled() const throw()
@@ -47,8 +47,26 @@ namespace details {
 
 	_EXP_IMPL void __cdecl schedule_chore(_Threadpool_chore*);
 
+	// Runs one pending chore on the calling thread if the scheduler has any. Waiters call it
+	// so that a blocked wait does not idle a worker of a fixed size pool.
+	// Returns false when nothing was run (always the case for the OS thread pools).
+	_EXP_IMPL bool __cdecl try_execute_chore();
+
 	_EXP_IMPL unsigned int __cdecl get_current_thread_id();
 
+	// Successful steals counted by the distance between the thief and the victim queue,
+	// the ratio of remote steals tells how much data is dragged across sockets
+	struct steal_statistics
+	{
+		size_t same_core_complex;
+		size_t same_socket;
+		size_t remote_socket;
+	};
+
+	_EXP_IMPL steal_statistics __cdecl get_steal_statistics();
+
+	_EXP_IMPL void __cdecl reset_steal_statistics();
+
 }
 _PSTL_NS1_END // std::experimental::parallel::details
 
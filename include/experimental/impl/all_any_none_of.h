@@ -30,7 +30,7 @@ namespace details {
 			_Partitioner<_ExecutionPolicy>::_For_Each(_First, std::distance(_First, _Last), _Pred,
 				[&_Token](_InIt _Begin, size_t _Count, _Pr& _UserPred){
 
-				LoopHelper<_ExecutionPolicy, _InIt>::Loop(_Begin, _Count, [&_Token, &_UserPred](const std::iterator_traits<_InIt>::reference _El){
+				LoopHelper<_ExecutionPolicy, _InIt>::Loop(_Begin, _Count, [&_Token, &_UserPred](const typename std::iterator_traits<_InIt>::reference _El){
 					if (_UserPred(_El))
 						_Token.cancel();
 				}, _Token);
@@ -72,7 +72,7 @@ namespace details {
 		if (_First != _Last) {
 			return _Any_of_impl(_Policy, _First, _Last, [_Pred](const typename std::iterator_traits<_InIt>::reference _El){
 				return !_Pred(_El);
-			}, std::_Iter_cat(_First)) == false;
+			}, details::_Iter_cat(_First)) == false;
 
 		}
 
@@ -97,7 +97,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type any_of(_ExPoli
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Any_of_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Any_of_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _InIt, class _Pr>
@@ -105,7 +105,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type none_of(_ExPol
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Any_of_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First)) == false;
+	return details::_Any_of_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First)) == false;
 }
 
 template <class _ExPolicy, class _InIt, class _Pr>
@@ -113,7 +113,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type all_of(_ExPoli
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_All_of_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_All_of_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 _PSTL_NS1_END // std::experimental::parallel
 
@@ -68,9 +68,12 @@ namespace std {
 					return to_pointer(t[0]);
 				}
 
-				template <typename T, typename ValueType>
+				template <typename T, typename ValueType, typename = void>
+				struct is_viewable : std::false_type
+				{};
 
-				struct is_viewable : std::integral_constant<bool,
+				template <typename T, typename ValueType>
+				struct is_viewable<T, ValueType, decltype(std::declval<T>().size(), std::declval<T>().data(), void())> : std::integral_constant<bool,
 					std::is_convertible<decltype(std::declval<T>().size()), ptrdiff_t>::value
 					&& std::is_convertible<decltype(std::declval<T>().data()), ValueType*>::value
 					&& std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::declval<T>().data())>>,
@@ -103,7 +106,7 @@ namespace std {
 				public:
 					static const int rank = Rank;
 					using index_type  = index<rank>;
-					using bounds_type = bounds<rank>;
+					using bounds_type = D4087::bounds<rank>;
 					using size_type   = size_t;
 					using value_type  = ValueType;
 					using pointer     = ValueType*;
@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <iterator>
 #include <type_traits>
+#include "defines.h"
 
 #define _CONSTEXPR
 
@@ -238,7 +239,7 @@ namespace std {
 				using value_type      = typename Base::value_type;
 
 				_CONSTEXPR index() _NOEXCEPT : Base(){}
-				template <typename = std::enable_if_t<rank == 1>>
+				template <int R = rank, typename = std::enable_if_t<R == 1>>
 				_CONSTEXPR index(value_type e0) _NOEXCEPT : Base(e0){}
 				_CONSTEXPR index(std::initializer_list<value_type> il) : Base(il){}
 
@@ -418,7 +419,7 @@ namespace std {
 
 				_CONSTEXPR bounds() _NOEXCEPT : Base(){}
 
-				template <typename = std::enable_if_t<rank == 1>>
+				template <int R = rank, typename = std::enable_if_t<R == 1>>
 				_CONSTEXPR bounds(value_type e0)
 					: Base(e0)
 				{
@@ -517,6 +518,10 @@ namespace std {
 					const details::arrow_proxy<index<Rank>>,
 					const index<Rank>>
 			{
+				typedef ptrdiff_t difference_type;
+				typedef const details::arrow_proxy<index<Rank>> pointer;
+				typedef const index<Rank> reference;
+
 				// Preconditions: bnd.contains(curr) unless bnd.size() == 0
 				explicit bounds_iterator(bounds<Rank> bnd, index<Rank> curr = index<Rank>{}) _NOEXCEPT
 					: bnd( std::move(bnd) )
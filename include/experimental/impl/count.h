@@ -71,13 +71,44 @@ namespace details {
 	}
 
 	template <class _ExPolicy, class _InIt, class _Ty, class _IterCat>
-	typename std::iterator_traits<_InIt>::difference_type _Count_impl(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat _Cat)
+	typename std::iterator_traits<_InIt>::difference_type _Count_helper(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat _Cat, std::false_type)
 	{
 		return _Count_if_impl(_Policy, _First, _Last, [&_Val](const typename std::iterator_traits<_InIt>::reference _El){
 			return _Val == _El;
 		}, _Cat);
 	}
 
+	// par_vec over contiguous arithmetic elements, every chunk is counted by the vector kernel
+	template <class _ExPolicy, class _InIt, class _Ty, class _IterCat>
+	typename std::iterator_traits<_InIt>::difference_type _Count_helper(const _ExPolicy&, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat, std::true_type)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+		typedef typename std::iterator_traits<_InIt>::value_type value_type;
+		typedef typename std::iterator_traits<_InIt>::difference_type difference_type;
+
+		value_type _Key;
+		if (_First == _Last || !_Vec_key(_Val, _Key))
+			return 0;
+
+		combinable<difference_type> _Combine;
+
+		_Partitioner<_ExecutionPolicy>::_For_Each(std::addressof(*_First), std::distance(_First, _Last), _Key,
+			[&_Combine](const value_type *_Begin, size_t _Count, value_type& _Key_val){
+			_Combine.local() += static_cast<difference_type>(_Vec_count_equal(_Begin, _Count, &_Key_val, _Vec_element<value_type>::value));
+		});
+
+		return _Combine.combine([](difference_type _Sum, difference_type _Val){
+			return _Sum + _Val;
+		});
+	}
+
+	template <class _ExPolicy, class _InIt, class _Ty, class _IterCat>
+	typename std::iterator_traits<_InIt>::difference_type _Count_impl(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat _Cat)
+	{
+		return _Count_helper(_Policy, _First, _Last, _Val, _Cat, std::integral_constant<bool,
+			_Use_vec_kernel<_ExPolicy, _InIt>::value && _Vec_key_convertible<typename std::iterator_traits<_InIt>::value_type, _Ty>::value>());
+	}
+
 	template <class _ExPolicy, class _InIt, class _Ty, class _IterCat>
 	typename _enable_if_parallel<_ExPolicy, typename std::iterator_traits<_InIt>::difference_type>::type _Count_impl(const _ExPolicy&, _InIt _First, _InIt _Last, const _Ty& _Val, std::input_iterator_tag _Cat)
 	{
@@ -96,7 +127,7 @@ inline typename details::_enable_if_policy<_ExPolicy, typename std::iterator_tra
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Count_if_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Count_if_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _InIt, class _Ty>
@@ -104,7 +135,7 @@ inline typename details::_enable_if_policy<_ExPolicy, typename std::iterator_tra
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Count_impl(_Policy, _First, _Last, _Val, std::_Iter_cat(_First));
+	return details::_Count_impl(_Policy, _First, _Last, _Val, details::_Iter_cat(_First));
 }
 _PSTL_NS1_END // std::experimental::parallel
 
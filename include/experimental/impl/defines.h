@@ -3,11 +3,18 @@
 #define _IMPL_DEFINES_H_
 
 // Export definitions
+#if defined(_MSC_VER)
 #ifdef _PSTL_DLL
 #define _EXP_IMPL __declspec(dllexport)
 #else
 #define _EXP_IMPL __declspec(dllimport)
 #endif
+#else
+#define _EXP_IMPL __attribute__((visibility("default")))
+#ifndef __cdecl
+#define __cdecl
+#endif
+#endif
 
 #if _MSC_VER  >= 1900
 #define _PSTL_NS1_BEGIN namespace std { namespace experimental { namespace parallel { inline namespace v1 {
@@ -17,4 +24,43 @@
 #define _PSTL_NS1_END }}}
 #endif
 
-#endif
\ No newline at end of file
+// Debug assertions
+#if defined(_MSC_VER)
+#include <crtdbg.h>
+#else
+#include <cassert>
+#ifndef _ASSERT
+#define _ASSERT(_Expr) assert(_Expr)
+#endif
+#ifndef _ASSERTE
+#define _ASSERTE(_Expr) assert(_Expr)
+#endif
+#endif
+
+// The headers spell noexcept as _NOEXCEPT, which the Visual C++ library defines (empty on VS2013)
+#if !defined(_MSC_VER) && !defined(_NOEXCEPT)
+#define _NOEXCEPT noexcept
+#endif
+
+// Alignment of types (VS2013 does not support alignas)
+#if defined(_MSC_VER)
+#define _EXP_ALIGN(_Bytes) __declspec(align(_Bytes))
+#else
+#define _EXP_ALIGN(_Bytes) alignas(_Bytes)
+#endif
+
+// Thread local storage (VS2013 does not support thread_local)
+#if defined(_MSC_VER)
+#define _PSTL_THREAD_LOCAL __declspec(thread)
+#else
+#define _PSTL_THREAD_LOCAL thread_local
+#endif
+
+// Scheduler backend selection. The Win32 thread pool (src/scheduler.cpp) is used by default on Windows,
+// define _PSTL_THREAD_SCHEDULER to build the portable std::thread based pool (src/scheduler_thread.cpp) instead.
+// Non-Windows targets always use the portable pool.
+#if !defined(_WIN32) && !defined(_PSTL_THREAD_SCHEDULER)
+#define _PSTL_THREAD_SCHEDULER 1
+#endif
+
+#endif
@@ -8,7 +8,7 @@
 _PSTL_NS1_BEGIN
 namespace details {
 	template<class _ExPolicy, class _InIt, class _InIt2, class _Diff, class _Pr>
-	bool _Equal_helper(const _ExPolicy&, _InIt _First, _InIt2 _First2, _Diff _Count, _Pr _Pred)
+	bool _Equal_helper(const _ExPolicy&, _InIt _First, _InIt2 _First2, _Diff _Count, _Pr _Pred, std::false_type)
 	{
 		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
 
@@ -18,7 +18,7 @@ namespace details {
 			[&_Token](details::composable_iterator<_InIt, _InIt2> _Begin, size_t _Count, _Pr& _UserPred){
 
 			LoopHelper<_ExecutionPolicy, composable_iterator<_InIt, _InIt2> >::Loop(_Begin, _Count,
-				[&_Token, &_UserPred](composable_iterator<_InIt, _InIt2>::reference _It){
+				[&_Token, &_UserPred](typename composable_iterator<_InIt, _InIt2>::reference _It){
 				if (!_UserPred(*std::get<0>(_It), *std::get<1>(_It)))
 					_Token.cancel();
 			}, _Token);
@@ -27,6 +27,39 @@ namespace details {
 		return !_Token.is_cancelled();
 	}
 
+	// par_vec over contiguous arithmetic elements, the vector kernel looks for a difference block by block
+	template<class _ExPolicy, class _InIt, class _InIt2, class _Diff, class _Pr>
+	bool _Equal_helper(const _ExPolicy&, _InIt _First, _InIt2 _First2, _Diff _Count, _Pr _Pred, std::true_type)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+		typedef typename std::iterator_traits<_InIt>::value_type value_type;
+
+		const value_type *_Base = std::addressof(*_First);
+		const value_type *_Base2 = std::addressof(*_First2);
+		cancellation_token _Token;
+
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Base, _Count, _Pred,
+			[&_Token, _Base, _Base2](const value_type *_Begin, size_t _Count, _Pr&){
+			const value_type *_Begin2 = _Base2 + (_Begin - _Base);
+			const size_t _Block = _Vec_block_bytes / sizeof(value_type);
+
+			for (size_t _Offset = 0; _Offset < _Count && !_Token.is_cancelled(); _Offset += _Block)
+			{
+				const size_t _Len = (std::min)(_Block, _Count - _Offset);
+				if (_Vec_mismatch(_Begin + _Offset, _Begin2 + _Offset, _Len, _Vec_element<value_type>::value) != _Len)
+					_Token.cancel();
+			}
+		});
+
+		return !_Token.is_cancelled();
+	}
+
+	template<class _ExPolicy, class _InIt, class _InIt2, class _Diff, class _Pr>
+	inline bool _Equal_helper(const _ExPolicy& _Policy, _InIt _First, _InIt2 _First2, _Diff _Count, _Pr _Pred)
+	{
+		return _Equal_helper(_Policy, _First, _First2, _Count, _Pred, _Use_vec_kernel2<_ExPolicy, _InIt, _InIt2, _Pr>());
+	}
+
 	//
 	// equal
 	//
@@ -117,7 +150,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type equal(_ExPolic
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Equal_impl(_Policy, _First, _Last, _First2, _Pred, std::_Iter_cat(_First));
+	return details::_Equal_impl(_Policy, _First, _Last, _First2, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _InIt, class _InIt2>
@@ -126,7 +159,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type equal(_ExPolic
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Equal_impl(_Policy, _First, _Last, _First2, std::equal_to<>(), std::_Iter_cat(_First));
+	return details::_Equal_impl(_Policy, _First, _Last, _First2, std::equal_to<>(), details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _InIt, class _InIt2, class _Pr>
@@ -135,7 +168,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type equal(_ExPolic
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Equal_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, std::_Iter_cat(_First));
+	return details::_Equal_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _InIt, class _InIt2>
@@ -144,7 +177,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type equal(_ExPolic
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Equal_impl(_Policy, _First, _Last, _First2, _Last2, std::equal_to<>(), std::_Iter_cat(_First));
+	return details::_Equal_impl(_Policy, _First, _Last, _First2, _Last2, std::equal_to<>(), details::_Iter_cat(_First));
 }
 _PSTL_NS1_END // std::experimental::parallel
 
@@ -6,20 +6,27 @@
 #include <functional>
 #include <atomic>
 #include "defines.h"
+#include "algorithm_scheduler.h"
 
 _PSTL_NS1_BEGIN
 namespace details {
+	// Manual reset event that never resets. Waiters spin for a short while before parking on a futex,
+	// set() only issues a wake syscall when somebody is actually parked.
 	class Event
 	{
-		intptr_t m_lock;
-		intptr_t m_cond;
-		bool m_isSet;
+		enum { EventNotSet = 0, EventSet = 1, EventWaiters = 2 };
+		std::atomic<int> m_state;
 	public:
 		Event(const Event &) = delete;
 		Event &operator =(const Event &) = delete;
 		_EXP_IMPL Event();
 		_EXP_IMPL void __cdecl wait();
 		_EXP_IMPL void __cdecl set();
+
+		bool is_set() const
+		{
+			return m_state.load(std::memory_order_acquire) == EventSet;
+		}
 	};
 
 	// The completin Event will never be reset
@@ -32,6 +39,11 @@ namespace details {
 
 		void wait()
 		{
+			// Run queued chores while the counted ones are still pending, a fixed size
+			// pool would otherwise lose a worker to every nested wait
+			while (m_counter.load(std::memory_order_acquire) != 0 && try_execute_chore())
+				;
+
 			m_event.wait();
 		}
 
@@ -66,14 +66,25 @@ namespace details {
 	{
 		_EXP_GENERIC_EXECUTION_POLICY(_Fill_impl, _Policy, _First, _Last, _Val, _Cat);
 	}
+
+	//
+	// fill of array_view and strided_array_view
+	//
+	template <class _ExPolicy, class _OutTy, int _Rank, class _Ty>
+	inline void _Fill_view_impl(const _ExPolicy& _Policy, const _View_layout<_OutTy, _Rank>& _Layout, const _Ty& _Val)
+	{
+		_For_each_view_impl(_Policy, _Layout, [&_Val](_OutTy& _El){
+			_El = _Val;
+		});
+	}
 } // details
 
 template <class _ExPolicy, class _OutIt, class _Diff, class _Ty>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type fill_n(_ExPolicy&& _Policy, _OutIt _First, _Diff _Count, const _Ty& _Val)
 {
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	return details::_Fill_n_impl(_Policy, _First, _Count, _Val, std::_Iter_cat(_First));
+	return details::_Fill_n_impl(_Policy, _First, _Count, _Val, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt, class _Ty>
@@ -81,7 +92,14 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type fill(_ExPolicy
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::_Fill_impl(_Policy, _First, _Last, _Val, std::_Iter_cat(_First));
+	details::_Fill_impl(_Policy, _First, _Last, _Val, details::_Iter_cat(_First));
+}
+
+// Assigns _Val to every element of the array_view or strided_array_view _Vw
+template <class _ExPolicy, class _View, class _Ty>
+inline typename details::_enable_if_view<_ExPolicy, _View, void>::type fill(_ExPolicy&& _Policy, const _View& _Vw, const _Ty& _Val)
+{
+	details::_Fill_view_impl(_Policy, details::_Make_view_layout(_Vw), _Val);
 }
 _PSTL_NS1_END // std::experimental::parallel
 
@@ -8,7 +8,7 @@
 _PSTL_NS1_BEGIN
 namespace details {
 	//
-	// find
+	// find_if
 	//
 	template<class _InIt, class _Pr, class _IterCat>
 	inline _InIt _Find_if_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _Pr _Pred, _IterCat)
@@ -65,6 +65,76 @@ namespace details {
 		_EXP_GENERIC_EXECUTION_POLICY(_Find_if_impl, _Policy, _First, _Last, _Pred, _Cat);
 	}
 
+	//
+	// find
+	//
+	template<class _InIt, class _Ty, class _IterCat>
+	inline _InIt _Find_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat)
+	{
+		_EXP_TRY
+			return std::find(_First, _Last, _Val);
+		_EXP_RETHROW
+	}
+
+	template<class _ExPolicy, class _InIt, class _Ty, class _IterCat>
+	inline _InIt _Find_helper(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat _Cat, std::false_type)
+	{
+		return _Find_if_impl(_Policy, _First, _Last, [&_Val](typename std::iterator_traits<_InIt>::reference _El){
+			return _El == _Val;
+		}, _Cat);
+	}
+
+	// par_vec over contiguous arithmetic elements, every chunk runs the vector kernel block by block
+	template<class _ExPolicy, class _InIt, class _Ty, class _IterCat>
+	_InIt _Find_helper(const _ExPolicy&, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat, std::true_type)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+		typedef typename std::iterator_traits<_InIt>::value_type value_type;
+		typedef typename std::iterator_traits<_InIt>::difference_type difference_type;
+
+		value_type _Key;
+		if (_First == _Last || !_Vec_key(_Val, _Key))
+			return _Last;
+
+		auto _Size = std::distance(_First, _Last);
+		const value_type *_Base = std::addressof(*_First);
+		cancellation_token_with_position<difference_type> _Token(_Size);
+
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Base, _Size, _Key,
+			[&_Token, _Base](const value_type *_Begin, size_t _Count, value_type& _Key_val){
+			_Vec_search_blocks<value_type>(static_cast<difference_type>(_Begin - _Base), _Count, _Token, [_Begin, &_Key_val](size_t _Offset, size_t _Len){
+				return _Vec_find_equal(_Begin + _Offset, _Len, &_Key_val, _Vec_element<value_type>::value);
+			});
+		});
+
+		auto _Pos = _Token.get_position();
+		if (_Pos != _Size) {
+			std::advance(_First, _Pos);
+			return _First;
+		}
+
+		return _Last;
+	}
+
+	template<class _ExPolicy, class _InIt, class _Ty, class _IterCat>
+	inline _InIt _Find_impl(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat _Cat)
+	{
+		return _Find_helper(_Policy, _First, _Last, _Val, _Cat, std::integral_constant<bool,
+			_Use_vec_kernel<_ExPolicy, _InIt>::value && _Vec_key_convertible<typename std::iterator_traits<_InIt>::value_type, _Ty>::value>());
+	}
+
+	template<class _ExPolicy, class _InIt, class _Ty>
+	inline typename _enable_if_parallel<_ExPolicy, _InIt>::type _Find_impl(const _ExPolicy&, _InIt _First, _InIt _Last, const _Ty& _Val, std::input_iterator_tag _Cat)
+	{
+		return _Find_impl(seq, _First, _Last, _Val, _Cat);
+	}
+
+	template<class _InIt, class _Ty, class _IterCat>
+	inline _InIt _Find_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, const _Ty& _Val, _IterCat _Cat)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Find_impl, _Policy, _First, _Last, _Val, _Cat);
+	}
+
 	//
 	// find_first_of
 	//
@@ -88,7 +158,7 @@ namespace details {
 			cancellation_token_with_position<difference_type> _Token(_Size);
 
 			_Partitioner<_ExecutionPolicy>::_For_Each(_First, _Size, _Pred,
-				[&_Token, &_First, &_First2, &_Last2](typename _InIt& _Begin, size_t _Count, _BinPr _UserPred){
+				[&_Token, &_First, &_First2, &_Last2](_InIt& _Begin, size_t _Count, _BinPr _UserPred){
 				auto _Dist = std::distance(_First, _Begin);
 
 				for (size_t _Curr_pos = 0; _Curr_pos < _Count; ++_Curr_pos, ++_Begin) {
@@ -209,9 +279,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _InIt>::type find(_ExPolic
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Find_if_impl(_Policy, _First, _Last, [&_Val](typename std::iterator_traits<_InIt>::reference _El){
-		return _El == _Val;
-	}, std::_Iter_cat(_First));
+	return details::_Find_impl(_Policy, _First, _Last, _Val, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _Pr>
@@ -219,7 +287,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _InIt>::type find_if(_ExPo
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Find_if_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Find_if_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _Pr>
@@ -229,7 +297,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _InIt>::type find_if_not(_
 
 	return details::_Find_if_impl(_Policy, _First, _Last, [_Pred](typename std::iterator_traits<_InIt>::reference _El){
 		return !_Pred(_El);
-	}, std::_Iter_cat(_First));
+	}, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _FwdIt, class _BinPr>
@@ -238,7 +306,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _InIt>::type find_first_of
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Find_first_of_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, std::_Iter_cat(_First));
+	return details::_Find_first_of_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _FwdIt>
@@ -253,7 +321,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type find_end(_Ex
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt2>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Find_end_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, std::_Iter_cat(_First));
+	return details::_Find_end_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _FwdIt, class _FwdIt2>
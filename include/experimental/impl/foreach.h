@@ -7,6 +7,7 @@
 #include <iterator>
 
 #include "algorithm_impl.h"
+#include "coordinate.h"
 
 _PSTL_NS1_BEGIN
 namespace details {
@@ -121,13 +122,175 @@ namespace details {
 	template<class _ExPolicy, class _InIt, class _Fn, class _IterTag>
 	inline void _For_each_impl(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, _Fn _Func, _IterTag)
 	{
-		_For_each_n_impl(_Policy, _First, std::distance(_First, _Last), _Func, std::_Iter_cat(_First));
+		_For_each_n_impl(_Policy, _First, std::distance(_First, _Last), _Func, details::_Iter_cat(_First));
 	}
 
 	template<class _ExPolicy, class _InIt, class _Fn>
 	inline typename _enable_if_parallel<_ExPolicy, void>::type _For_each_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _Fn _Func, std::input_iterator_tag)
 	{
-		_For_each_impl(seq, _First, _Last, _Func, std::_Iter_cat(_First));
+		_For_each_impl(seq, _First, _Last, _Func, details::_Iter_cat(_First));
+	}
+
+	//
+	// for_each over bounds: the index space is cut into rectangular tiles that are spread over the threads, every
+	// tile is visited in row-major order with the inner dimension in a plain loop. The bounds_iterator arithmetic of
+	// the generic loop would linearize and delinearize the index with divisions at every step instead.
+	//
+
+	// Index points of a default tile and the extent of its inner dimension
+	const ptrdiff_t _Bounds_tile_points = 16 * 1024;
+	const ptrdiff_t _Bounds_tile_row = 256;
+
+	template<int _Rank>
+	class _Bounds_tiles
+	{
+		D4087::bounds<_Rank> _Bnd;
+		D4087::bounds<_Rank> _Shape;
+		D4087::bounds<_Rank> _Count;
+
+		void _Count_tiles()
+		{
+			for (int _I = 0; _I < _Rank; ++_I)
+				_Count[_I] = (_Bnd[_I] + _Shape[_I] - 1) / _Shape[_I];
+		}
+	public:
+		// Dimensions _Tile leaves at 0 get the default: whole rows up to _Bounds_tile_row for the inner one, the outer
+		// ones share the rest of _Bounds_tile_points from the inside out. With _Min_tiles these are then halved from
+		// the outside in until there are enough tiles to keep the threads busy.
+		_Bounds_tiles(const D4087::bounds<_Rank>& _B, const D4087::bounds<_Rank>& _Tile, ptrdiff_t _Min_tiles) : _Bnd(_B)
+		{
+			ptrdiff_t _Points = _Bounds_tile_points;
+			for (int _I = _Rank; _I-- > 0;)
+			{
+				ptrdiff_t _Extent = _Tile[_I] > 0 ? _Tile[_I] : (_I == _Rank - 1 ? _Bounds_tile_row : _Points);
+				_Shape[_I] = (std::max)(ptrdiff_t{ 1 }, (std::min)(_Extent, _Bnd[_I]));
+				_Points = (std::max)(ptrdiff_t{ 1 }, _Points / _Shape[_I]);
+			}
+
+			_Count_tiles();
+			for (int _I = 0; _I < _Rank; ++_I)
+			{
+				if (_Tile[_I] > 0)
+					continue;
+
+				while (count() < _Min_tiles && _Shape[_I] > 1)
+				{
+					_Shape[_I] = (_Shape[_I] + 1) / 2;
+					_Count_tiles();
+				}
+			}
+		}
+
+		ptrdiff_t count() const
+		{
+			return _Bnd.size() == 0 ? 0 : static_cast<ptrdiff_t>(_Count.size());
+		}
+
+		// First index of the tile and the index past its last one in every dimension, the tiles are numbered in
+		// row-major order
+		void area(ptrdiff_t _Tile_pos, D4087::index<_Rank>& _Origin, D4087::index<_Rank>& _End) const
+		{
+			for (int _I = _Rank; _I-- > 0;)
+			{
+				_Origin[_I] = (_Tile_pos % _Count[_I]) * _Shape[_I];
+				_End[_I] = (std::min)(_Origin[_I] + _Shape[_I], _Bnd[_I]);
+				_Tile_pos /= _Count[_I];
+			}
+		}
+
+		// Calls _Func with every index of the tile
+		template<typename _Fn>
+		void visit(ptrdiff_t _Tile_pos, _Fn& _Func) const
+		{
+			D4087::index<_Rank> _Origin, _End;
+			area(_Tile_pos, _Origin, _End);
+
+			D4087::index<_Rank> _Idx = _Origin;
+			const D4087::index<_Rank>& _Arg = _Idx;
+			for (;;)
+			{
+				for (_Idx[_Rank - 1] = _Origin[_Rank - 1]; _Idx[_Rank - 1] < _End[_Rank - 1]; ++_Idx[_Rank - 1])
+					_Func(_Arg);
+
+				// Carry into the outer dimensions, done once all of them wrapped around
+				int _Dim = _Rank - 1;
+				while (_Dim-- > 0)
+				{
+					if (++_Idx[_Dim] < _End[_Dim])
+						break;
+					_Idx[_Dim] = _Origin[_Dim];
+				}
+
+				if (_Dim < 0)
+					return;
+			}
+		}
+	};
+
+	template<int _Rank, class _Fn>
+	inline void _For_each_tiled_impl(const sequential_execution_policy&, const D4087::bounds<_Rank>& _Bnd, const D4087::bounds<_Rank>& _Tile, _Fn _Func)
+	{
+		_EXP_TRY
+			const _Bounds_tiles<_Rank> _Tiles(_Bnd, _Tile, 0);
+			for (ptrdiff_t _Pos = 0; _Pos < _Tiles.count(); ++_Pos)
+				_Tiles.visit(_Pos, _Func);
+		_EXP_RETHROW
+	}
+
+	template<class _ExPolicy, int _Rank, class _Fn>
+	inline void _For_each_tiled_impl(const _ExPolicy&, const D4087::bounds<_Rank>& _Bnd, const D4087::bounds<_Rank>& _Tile, _Fn _Func)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		const _Bounds_tiles<_Rank> _Tiles(_Bnd, _Tile, 4 * static_cast<ptrdiff_t>(get_hardware_concurrency()));
+		if (_Tiles.count() == 0)
+			return;
+
+		// The tiles are handed out by their number, a one dimensional bounds_iterator counts them
+		const D4087::bounds<1> _Tile_numbers(_Tiles.count());
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Tile_numbers.begin(), static_cast<size_t>(_Tiles.count()), _Func,
+			[&_Tiles](D4087::bounds_iterator<1> _Begin, size_t _Count, _Fn& _UserFunc){
+			for (ptrdiff_t _Pos = (*_Begin)[0], _End = _Pos + static_cast<ptrdiff_t>(_Count); _Pos < _End; ++_Pos)
+				_Tiles.visit(_Pos, _UserFunc);
+		});
+	}
+
+	template<int _Rank, class _Fn>
+	inline void _For_each_tiled_impl(const execution_policy& _Policy, const D4087::bounds<_Rank>& _Bnd, const D4087::bounds<_Rank>& _Tile, _Fn _Func)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_For_each_tiled_impl, _Policy, _Bnd, _Tile, _Func);
+	}
+
+	// [_First, _Last) covers the whole of some bounds when it starts at the origin, _Last is then past the end and its
+	// index holds the bounds. With more than one dimension an index _Last inside the bounds has more indices before it
+	// than the product of its components (every full row before it counts the whole row, not just the component), thus
+	// comparing the distance with that product tells the two apart. With one dimension any range from the origin is whole.
+	template<int _Rank>
+	bool _Whole_bounds(const D4087::bounds_iterator<_Rank>& _First, const D4087::bounds_iterator<_Rank>& _Last, D4087::bounds<_Rank>& _Bnd)
+	{
+		const D4087::index<_Rank> _Origin = *_First, _Past_end = *_Last;
+
+		ptrdiff_t _Size = 1;
+		for (int _I = 0; _I < _Rank; ++_I)
+		{
+			if (_Origin[_I] != 0)
+				return false;
+
+			_Bnd[_I] = _Past_end[_I];
+			_Size *= _Past_end[_I];
+		}
+
+		return _Size > 0 && _Last - _First == _Size;
+	}
+
+	template<class _ExPolicy, int _Rank, class _Fn>
+	inline typename _enable_if_parallel<_ExPolicy, void>::type _For_each_impl(const _ExPolicy& _Policy, D4087::bounds_iterator<_Rank> _First, D4087::bounds_iterator<_Rank> _Last, _Fn _Func, std::random_access_iterator_tag _Cat)
+	{
+		D4087::bounds<_Rank> _Bnd;
+		if (_Whole_bounds(_First, _Last, _Bnd))
+			_For_each_tiled_impl(_Policy, _Bnd, D4087::bounds<_Rank>(), _Func);
+		else
+			_For_each_n_impl(_Policy, _First, std::distance(_First, _Last), _Func, _Cat);
 	}
 
 	template<class _InIt, class _Fn, class _IterTag>
@@ -135,6 +298,54 @@ namespace details {
 	{
 		_EXP_GENERIC_EXECUTION_POLICY(_For_each_impl, _Policy, _First, _Last, _Func, _Cat);
 	}
+
+	//
+	// for_each over array_view and strided_array_view
+	//
+	template<class _ExPolicy, class _Ty, int _Rank, class _Fn>
+	void _For_each_view_loop(const _View_layout<_Ty, _Rank>& _Layout, ptrdiff_t _First, ptrdiff_t _Count, _Fn& _Func)
+	{
+		const ptrdiff_t _Inner_stride = _Layout._Stride[_Rank - 1];
+		auto _Row_fn = [&](const D4087::index<_Rank>& _Origin, ptrdiff_t _Length) {
+			_Ty *_Ptr = _Layout._Row(_Origin);
+			if (_Inner_stride == 1)
+				_For_each_helper<_ExPolicy, std::random_access_iterator_tag>::Loop(_Ptr, static_cast<size_t>(_Length), std::ref(_Func));
+			else
+			{
+				for (ptrdiff_t _I = 0; _I < _Length; ++_I, _Ptr += _Inner_stride)
+					_Func(*_Ptr);
+			}
+		};
+
+		_For_each_view_row(_Layout._Bnd, _First, _Count, _Row_fn);
+	}
+
+	template<class _Ty, int _Rank, class _Fn>
+	inline void _For_each_view_impl(const sequential_execution_policy&, const _View_layout<_Ty, _Rank>& _Layout, _Fn _Func)
+	{
+		_EXP_TRY
+			_For_each_view_loop<sequential_execution_policy>(_Layout, 0, _Layout._Bnd[0], _Func);
+		_EXP_RETHROW
+	}
+
+	template<class _ExPolicy, class _Ty, int _Rank, class _Fn>
+	inline void _For_each_view_impl(const _ExPolicy&, const _View_layout<_Ty, _Rank>& _Layout, _Fn _Func)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		if (_Layout._Bnd.size() == 0)
+			return;
+
+		_For_each_view_part<_ExecutionPolicy>(_Layout._Bnd[0], _Func, [&_Layout](ptrdiff_t _First, ptrdiff_t _Count, _Fn& _UserFunc) {
+			_For_each_view_loop<_ExecutionPolicy>(_Layout, _First, _Count, _UserFunc);
+		});
+	}
+
+	template<class _Ty, int _Rank, class _Fn>
+	inline void _For_each_view_impl(const execution_policy& _Policy, const _View_layout<_Ty, _Rank>& _Layout, _Fn _Func)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_For_each_view_impl, _Policy, _Layout, _Func);
+	}
 } // details
 
 template <class _ExPolicy, class _InIt, class _Diff, class _Fn>
@@ -142,7 +353,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _InIt>::type for_each_n(_E
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_For_each_n_impl(_Policy, _First, _Count, _Func, std::_Iter_cat(_First));
+	return details::_For_each_n_impl(_Policy, _First, _Count, _Func, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _Fn>
@@ -150,7 +361,22 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type for_each(_ExPo
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_For_each_impl(_Policy, _First, _Last, _Func, std::_Iter_cat(_First));
+	return details::_For_each_impl(_Policy, _First, _Last, _Func, details::_Iter_cat(_First));
+}
+
+// Calls _Func with every element of the array_view or strided_array_view _Vw
+template<class _ExPolicy, class _View, class _Fn>
+inline typename details::_enable_if_view<_ExPolicy, _View, void>::type for_each(_ExPolicy&& _Policy, const _View& _Vw, _Fn _Func)
+{
+	details::_For_each_view_impl(_Policy, details::_Make_view_layout(_Vw), _Func);
+}
+
+// Calls _Func with every index of _Bnd. The tiles of _Tile's shape are spread over the threads and visited in row-major
+// order, a dimension _Tile leaves at 0 gets the default extent.
+template<class _ExPolicy, int _Rank, class _Fn>
+inline typename details::_enable_if_policy<_ExPolicy, void>::type for_each_tiled(_ExPolicy&& _Policy, const D4087::bounds<_Rank>& _Bnd, const D4087::bounds<_Rank>& _Tile, _Fn _Func)
+{
+	details::_For_each_tiled_impl(_Policy, _Bnd, _Tile, _Func);
 }
 _PSTL_NS1_END // std::experimental::parallel
 
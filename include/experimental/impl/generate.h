@@ -73,15 +73,15 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type generate(_ExPo
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::_Generate_impl(_Policy, _First, _Last, _Func, std::_Iter_cat(_First));
+	details::_Generate_impl(_Policy, _First, _Last, _Func, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _OutIt, class _Diff, class _Fn>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type generate_n(_ExPolicy&& _Policy, _OutIt _First, _Diff _Count, _Fn _Func)
 {
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	return details::_Generate_n_impl(_Policy, _First, _Count, _Func, std::_Iter_cat(_First));
+	return details::_Generate_n_impl(_Policy, _First, _Count, _Func, details::_Iter_cat(_First));
 }
 _PSTL_NS1_END // std::experimental::parallel
 
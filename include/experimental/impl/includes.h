@@ -89,7 +89,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type includes(_ExPo
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
 	return details::_Includes_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, _Cat);
 }
 
@@ -69,7 +69,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type is_partitioned
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Is_partitioned_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Is_partitioned_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 _PSTL_NS1_END // std::experimental::parallel
 
@@ -125,7 +125,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type is_sorted(_ExP
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Is_sorted_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Is_sorted_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt>
@@ -133,7 +133,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type is_sorted(_ExP
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Is_sorted_impl(_Policy, _First, _Last, std::less<>(), std::_Iter_cat(_First));
+	return details::_Is_sorted_impl(_Policy, _First, _Last, std::less<>(), details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt, class _Pr>
@@ -141,7 +141,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type is_sorted_un
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Is_sorted_until_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Is_sorted_until_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt>
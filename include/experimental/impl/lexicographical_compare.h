@@ -22,13 +22,13 @@ namespace details {
 	template<class _ExPolicy, class _InIt, class _InIt2, class _Pr, class _IterCat>
 	inline bool _Lexicographical_compare_impl(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, _InIt2 _First2, _InIt2 _Last2, _Pr _Pred, _IterCat _Cat)
 	{
-		typedef std::iterator_traits<_InIt>::difference_type difference_type;
+		typedef typename std::iterator_traits<_InIt>::difference_type difference_type;
 		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
 
 		if (_First != _Last && _First2 != _Last2) {
 
 			auto _Pair = _Mismatch_impl(_Policy, _First, _Last, _First2, _Last2,
-				[_Pred](std::iterator_traits<_InIt>::reference _Val, std::iterator_traits<_InIt2>::reference _Val2) {
+				[_Pred](typename std::iterator_traits<_InIt>::reference _Val, typename std::iterator_traits<_InIt2>::reference _Val2) {
 				return !(_Pred(_Val, _Val2) || _Pred(_Val2, _Val));
 			}, _Cat);
 
@@ -59,7 +59,7 @@ inline typename details::_enable_if_policy<_ExPolicy, bool>::type lexicographica
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
 	return details::_Lexicographical_compare_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, _Cat);
 }
 
@@ -0,0 +1,225 @@
+#pragma once
+
+#ifndef _IMPL_MATRIX_MULTIPLY_H_
+#define _IMPL_MATRIX_MULTIPLY_H_ 1
+
+#include "algorithm_impl.h"
+
+_PSTL_NS1_BEGIN
+namespace details {
+	//
+	// matrix_multiply: C is cut into tiles of _Mc rows by _Nc columns, the tiles are the parallel units. A tile walks K
+	// in steps of _Gemm_kc, copies the block of B it needs into panels of _Gemm_nr columns and the block of A into panels
+	// of _Gemm_mr rows (both padded with zeros), then the micro-kernel computes _Gemm_mr x _Gemm_nr elements of C at a
+	// time from one panel of each. The packed blocks of A and B stay in the L2 cache while they are reused.
+	//
+	const size_t _Gemm_kc = 256;
+	const size_t _Gemm_mc = 64;
+	const size_t _Gemm_nc = 128;
+
+	// Portable micro-kernel, _Ty needs + and * and value initializes to zero
+	template<typename _Ty>
+	void _Gemm_kernel(size_t _Kc, const _Ty *_A_panel, const _Ty *_B_panel, _Ty *_C, ptrdiff_t _Ldc, bool _Accumulate)
+	{
+		_Ty _Acc[_Gemm_mr][_Gemm_nr] = {};
+		for (size_t _K = 0; _K < _Kc; ++_K, _A_panel += _Gemm_mr, _B_panel += _Gemm_nr)
+		{
+			for (size_t _I = 0; _I < _Gemm_mr; ++_I)
+			{
+				_EXP_PRAGMA_VEC
+				for (size_t _J = 0; _J < _Gemm_nr; ++_J)
+					_Acc[_I][_J] += _A_panel[_I] * _B_panel[_J];
+			}
+		}
+
+		for (size_t _I = 0; _I < _Gemm_mr; ++_I, _C += _Ldc)
+		{
+			for (size_t _J = 0; _J < _Gemm_nr; ++_J)
+				_C[_J] = _Accumulate ? _C[_J] + _Acc[_I][_J] : _Acc[_I][_J];
+		}
+	}
+
+	inline void _Gemm_kernel(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+	{
+		_Gemm_kernel_double(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+	}
+
+	// Rows [0, _Rows) and columns [0, _Kc) of A into panels of _Gemm_mr rows stored column by column
+	template<typename _Ty>
+	void _Gemm_pack_a(const _Ty *_A, ptrdiff_t _Lda, size_t _Rows, size_t _Kc, _Ty *_Packed)
+	{
+		for (size_t _I = 0; _I < _Rows; _I += _Gemm_mr)
+		{
+			const size_t _Height = (std::min)(_Gemm_mr, _Rows - _I);
+			for (size_t _K = 0; _K < _Kc; ++_K)
+			{
+				for (size_t _R = 0; _R < _Gemm_mr; ++_R)
+					*_Packed++ = _R < _Height ? _A[(_I + _R) * _Lda + _K] : _Ty{};
+			}
+		}
+	}
+
+	// Rows [0, _Kc) and columns [0, _Cols) of B into panels of _Gemm_nr columns stored row by row
+	template<typename _Ty>
+	void _Gemm_pack_b(const _Ty *_B, ptrdiff_t _Ldb, size_t _Kc, size_t _Cols, _Ty *_Packed)
+	{
+		for (size_t _J = 0; _J < _Cols; _J += _Gemm_nr)
+		{
+			const size_t _Width = (std::min)(_Gemm_nr, _Cols - _J);
+			for (size_t _K = 0; _K < _Kc; ++_K)
+			{
+				const _Ty *_Row = _B + _K * _Ldb + _J;
+				for (size_t _C = 0; _C < _Gemm_nr; ++_C)
+					*_Packed++ = _C < _Width ? _Row[_C] : _Ty{};
+			}
+		}
+	}
+
+	template<typename _Ty>
+	class _Gemm
+	{
+		const _Ty *_A;
+		const _Ty *_B;
+		_Ty *_C;
+		ptrdiff_t _Lda, _Ldb, _Ldc;
+		size_t _M, _N, _K;
+		size_t _Mc, _Nc, _Col_tiles;
+
+		static size_t _Round_up(size_t _Val, size_t _Step)
+		{
+			return (_Val + _Step - 1) / _Step * _Step;
+		}
+	public:
+		// The tiles shrink, columns first, until there are _Min_tiles of them or they reach 16 x 32 elements
+		_Gemm(const D4087::array_view<const _Ty, 2>& _A_view, const D4087::array_view<const _Ty, 2>& _B_view, const D4087::array_view<_Ty, 2>& _C_view, size_t _Min_tiles) :
+			_A(_A_view.data()), _B(_B_view.data()), _C(_C_view.data()),
+			_Lda(_A_view.stride()[0]), _Ldb(_B_view.stride()[0]), _Ldc(_C_view.stride()[0]),
+			_M(_C_view.bounds()[0]), _N(_C_view.bounds()[1]), _K(_A_view.bounds()[1]),
+			_Mc(_Gemm_mc), _Nc(_Gemm_nc)
+		{
+			while (_Nc > 32 && tiles() < _Min_tiles)
+				_Nc /= 2;
+			while (_Mc > 16 && tiles() < _Min_tiles)
+				_Mc /= 2;
+			_Col_tiles = (_N + _Nc - 1) / _Nc;
+		}
+
+		size_t tiles() const
+		{
+			return ((_M + _Mc - 1) / _Mc) * ((_N + _Nc - 1) / _Nc);
+		}
+
+		size_t packed_a_size() const
+		{
+			return _Round_up((std::min)(_Mc, _M), _Gemm_mr) * (std::min)(_Gemm_kc, _K);
+		}
+
+		size_t packed_b_size() const
+		{
+			return _Round_up((std::min)(_Nc, _N), _Gemm_nr) * (std::min)(_Gemm_kc, _K);
+		}
+
+		// Computes the tile _Pos of C (row-major numbering), _Packed_a and _Packed_b hold packed_a_size() and
+		// packed_b_size() elements
+		void tile(size_t _Pos, _Ty *_Packed_a, _Ty *_Packed_b) const
+		{
+			const size_t _Row = _Pos / _Col_tiles * _Mc, _Col = _Pos % _Col_tiles * _Nc;
+			const size_t _Rows = (std::min)(_Mc, _M - _Row), _Cols = (std::min)(_Nc, _N - _Col);
+			_Ty *_C_tile = _C + _Row * _Ldc + _Col;
+
+			if (_K == 0)
+			{
+				for (size_t _I = 0; _I < _Rows; ++_I)
+					std::fill_n(_C_tile + _I * _Ldc, _Cols, _Ty{});
+				return;
+			}
+
+			for (size_t _Depth = 0; _Depth < _K; _Depth += _Gemm_kc)
+			{
+				const size_t _Kc = (std::min)(_Gemm_kc, _K - _Depth);
+				const bool _Accumulate = _Depth > 0;
+				_Gemm_pack_b(_B + _Depth * _Ldb + _Col, _Ldb, _Kc, _Cols, _Packed_b);
+				_Gemm_pack_a(_A + _Row * _Lda + _Depth, _Lda, _Rows, _Kc, _Packed_a);
+
+				for (size_t _J = 0; _J < _Cols; _J += _Gemm_nr)
+				{
+					for (size_t _I = 0; _I < _Rows; _I += _Gemm_mr)
+					{
+						const _Ty *_A_panel = _Packed_a + _I * _Kc, *_B_panel = _Packed_b + _J * _Kc;
+						_Ty *_C_block = _C_tile + _I * _Ldc + _J;
+						if (_I + _Gemm_mr <= _Rows && _J + _Gemm_nr <= _Cols)
+						{
+							_Gemm_kernel(_Kc, _A_panel, _B_panel, _C_block, _Ldc, _Accumulate);
+							continue;
+						}
+
+						// The edges of the tile are computed in full and only the elements inside C are written
+						_Ty _Edge[_Gemm_mr * _Gemm_nr];
+						_Gemm_kernel(_Kc, _A_panel, _B_panel, _Edge, static_cast<ptrdiff_t>(_Gemm_nr), false);
+
+						const size_t _Height = (std::min)(_Gemm_mr, _Rows - _I), _Width = (std::min)(_Gemm_nr, _Cols - _J);
+						for (size_t _R = 0; _R < _Height; ++_R)
+						{
+							for (size_t _Cl = 0; _Cl < _Width; ++_Cl)
+							{
+								_Ty &_El = _C_block[_R * _Ldc + _Cl];
+								_El = _Accumulate ? _El + _Edge[_R * _Gemm_nr + _Cl] : _Edge[_R * _Gemm_nr + _Cl];
+							}
+						}
+					}
+				}
+			}
+		}
+	};
+
+	template <class _Ty>
+	void _Matrix_multiply_impl(const sequential_execution_policy&, const D4087::array_view<const _Ty, 2>& _A, const D4087::array_view<const _Ty, 2>& _B, const D4087::array_view<_Ty, 2>& _C)
+	{
+		_EXP_TRY
+			const _Gemm<_Ty> _Mul(_A, _B, _C, 1);
+			std::vector<_Ty> _Packed_a(_Mul.packed_a_size()), _Packed_b(_Mul.packed_b_size());
+			for (size_t _Pos = 0; _Pos < _Mul.tiles(); ++_Pos)
+				_Mul.tile(_Pos, _Packed_a.data(), _Packed_b.data());
+		_EXP_RETHROW
+	}
+
+	template <class _ExPolicy, class _Ty>
+	void _Matrix_multiply_impl(const _ExPolicy&, const D4087::array_view<const _Ty, 2>& _A, const D4087::array_view<const _Ty, 2>& _B, const D4087::array_view<_Ty, 2>& _C)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		const _Gemm<_Ty> _Mul(_A, _B, _C, 4 * static_cast<size_t>(get_hardware_concurrency()));
+		if (_Mul.tiles() == 0)
+			return;
+
+		// Every chunk of tiles packs into buffers of its own
+		const D4087::bounds<1> _Tile_numbers(static_cast<ptrdiff_t>(_Mul.tiles()));
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Tile_numbers.begin(), _Mul.tiles(), _Mul,
+			[](D4087::bounds_iterator<1> _Begin, size_t _Count, _Gemm<_Ty>& _Part_mul){
+			std::vector<_Ty> _Packed_a(_Part_mul.packed_a_size()), _Packed_b(_Part_mul.packed_b_size());
+			for (size_t _Pos = static_cast<size_t>((*_Begin)[0]), _End = _Pos + _Count; _Pos < _End; ++_Pos)
+				_Part_mul.tile(_Pos, _Packed_a.data(), _Packed_b.data());
+		});
+	}
+
+	template <class _Ty>
+	inline void _Matrix_multiply_impl(const execution_policy& _Policy, const D4087::array_view<const _Ty, 2>& _A, const D4087::array_view<const _Ty, 2>& _B, const D4087::array_view<_Ty, 2>& _C)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Matrix_multiply_impl, _Policy, _A, _B, _C);
+	}
+} // details
+
+// Sets _C (M x N) to the product of _A (M x K) and _B (K x N), _C must not overlap _A or _B. The double version uses
+// SSE2 or AVX2 kernels picked for the CPU at run time.
+template <class _ExPolicy, class _Ty>
+inline typename details::_enable_if_policy<_ExPolicy, void>::type matrix_multiply(_ExPolicy&& _Policy,
+	const D4087::array_view<const typename std::remove_const<_Ty>::type, 2>& _A, const D4087::array_view<const typename std::remove_const<_Ty>::type, 2>& _B, const D4087::array_view<_Ty, 2>& _C)
+{
+	static_assert(!std::is_const<_Ty>::value, "The product is written to _C.");
+
+	_ASSERT(_A.bounds()[0] == _C.bounds()[0] && _A.bounds()[1] == _B.bounds()[0] && _B.bounds()[1] == _C.bounds()[1]);
+	details::_Matrix_multiply_impl(_Policy, _A, _B, _C);
+}
+_PSTL_NS1_END // std::experimental::parallel
+
+#endif // _IMPL_MATRIX_MULTIPLY_H_
@@ -55,33 +55,54 @@ namespace details {
 		return _Len;
 	}
 
-	// _Div_num of threads(tasks) merge two chunks in parallel, _Div_num should be power of 2, if not, the largest power of 2 that is
-	// smaller than _Div_num will be used
+	const size_t _Merge_min_part_size = 2048;
+
+	// Number of elements of range 1 among the first _Diagonal elements of the merged output. Equivalent elements
+	// are taken from range 1 first, as std::merge does, thus merging the ranges cut at any diagonal is stable.
+	template<typename _Random_iterator, typename _Random_buffer_iterator, typename _Function>
+	size_t _Merge_path_split(const _Random_iterator &_Begin1, size_t _Len1, const _Random_buffer_iterator &_Begin2, size_t _Len2, size_t _Diagonal, _Function &_Func)
+	{
+		size_t _Low = _Diagonal > _Len2 ? _Diagonal - _Len2 : 0, _High = (std::min)(_Diagonal, _Len1);
+		while (_Low < _High)
+		{
+			size_t _Mid = (_Low + _High) / 2;
+			if (_Func(_Begin2[_Diagonal - 1 - _Mid], _Begin1[_Mid]))
+				_High = _Mid;
+			else
+				_Low = _Mid + 1;
+		}
+		return _Low;
+	}
+
+	// Cuts the merged output into _Parts segments of the same size at evenly spaced diagonals of the merge path. Every
+	// segment finds where its diagonals cross the merge path and merges its pieces of both ranges, all in one pass.
 	template<typename _Random_iterator, typename _Random_buffer_iterator, typename _Random_output_iterator, typename _Function>
 	void _Parallel_merge(_Random_iterator _Begin1, size_t _Len1, _Random_buffer_iterator _Begin2, size_t _Len2, _Random_output_iterator _Output,
-		_Function &_Func, size_t _Div_num)
+		_Function &_Func, size_t _Parts)
 	{
-		// Turn to serial merge or continue splitting chunks base on "_Div_num"
-		if (_Div_num <= 1 || (_Len1 <= 1 && _Len2 <= 1))
+		const size_t _Total = _Len1 + _Len2;
+		_Parts = (std::min)(_Parts, _Total / _Merge_min_part_size);
+		if (_Parts <= 1)
 		{
 			std::merge(_Begin1, _Begin1 + _Len1, _Begin2, _Begin2 + _Len2, _Output, _Func);
+			return;
 		}
-		else
-		{
-			size_t _Mid_len1 = _Len1, _Mid_len2 = _Len2;
-			size_t _Mid = _Search_mid_point(_Begin1, _Mid_len1, _Begin2, _Mid_len2, _Func);
 
-			TaskGroup _Tg;
-			auto _Handle = make_task([&]
-			{
-				_Parallel_merge(_Begin1, _Mid_len1, _Begin2, _Mid_len2, _Output, _Func, _Div_num / 2);
-			});
-			_Tg.run(_Handle);
+		std::vector<size_t> _Diagonals(_Parts + 1);
+		for (size_t _I = 0; _I <= _Parts; ++_I)
+			_Diagonals[_I] = _Total * _I / _Parts;
 
-			_Parallel_merge(_Begin1 + _Mid_len1, _Len1 - _Mid_len1, _Begin2 + _Mid_len2, _Len2 - _Mid_len2, _Output + _Mid, _Func, _Div_num / 2);
+		_Partitioner<static_partitioner_tag>::_For_Each(_Diagonals.cbegin(), _Parts,
+			[&](std::vector<size_t>::const_iterator _CurItr, size_t _Count) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				const size_t _Start = _CurItr[0], _End = _CurItr[1];
+				const size_t _Start1 = _Merge_path_split(_Begin1, _Len1, _Begin2, _Len2, _Start, _Func);
+				const size_t _End1 = _Merge_path_split(_Begin1, _Len1, _Begin2, _Len2, _End, _Func);
 
-			_Tg.wait();
-		}
+				std::merge(_Begin1 + _Start1, _Begin1 + _End1, _Begin2 + (_Start - _Start1), _Begin2 + (_End - _End1), _Output + _Start, _Func);
+			}
+		}, 1);
 	}
 
 	// _Div_num of threads(tasks) merge two chunks in parallel, _Div_num should be power of 2, if not, the largest power of 2 that is
@@ -187,9 +208,9 @@ inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type merge(_ExPol
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _InIt2, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _InIt2, _OutIt>::iterator_category _Cat;
 	return details::_Merge_impl(_Policy, _First, _Last, _First2, _Last2, _Dest, _Pred, _Cat);
 }
 
@@ -204,7 +225,7 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type inplace_merge(
 {
 	static_assert(std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<_BidIt>::iterator_category>::value, "Required bidirectional iterator or stronger.");
 
-	details::_Inplace_merge_impl(_Policy, _First, _Mid, _Last, _Pred, std::_Iter_cat(_First));
+	details::_Inplace_merge_impl(_Policy, _First, _Mid, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _BidIt>
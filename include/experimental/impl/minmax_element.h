@@ -73,7 +73,7 @@ namespace details {
 	template <class _ExPolicy, class _FwdIt, class _Pr, class _IterCat>
 	_FwdIt _Max_element_impl(const _ExPolicy& _Policy, _FwdIt _First, _FwdIt _Last, _Pr _Pred, _IterCat _Cat)
 	{
-		return _Min_element_impl(_Policy, _First, _Last, [_Pred](std::iterator_traits<_FwdIt>::reference _Val, std::iterator_traits<_FwdIt>::reference _Val2) mutable {
+		return _Min_element_impl(_Policy, _First, _Last, [_Pred](typename std::iterator_traits<_FwdIt>::reference _Val, typename std::iterator_traits<_FwdIt>::reference _Val2) mutable {
 			return _Pred(_Val2, _Val);
 		}, _Cat);
 	}
@@ -154,7 +154,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type min_element(
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Min_element_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Min_element_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt>
@@ -168,7 +168,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type max_element(
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Max_element_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Max_element_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt>
@@ -182,7 +182,7 @@ inline typename details::_enable_if_policy<_ExPolicy, std::pair<_FwdIt, _FwdIt>
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Minmax_element_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Minmax_element_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt>
@@ -9,9 +9,9 @@ _PSTL_NS1_BEGIN
 namespace details {
 
 	template<class _ExPolicy, class _InIt, class _Diff, class _InIt2, class _Pr>
-	inline typename std::iterator_traits<_InIt>::difference_type _Mismatch_impl_helper(const _ExPolicy&, _InIt _First, _Diff _Size, _InIt2 _First2, _Pr _Pred)
+	inline typename std::iterator_traits<_InIt>::difference_type _Mismatch_impl_helper(const _ExPolicy&, _InIt _First, _Diff _Size, _InIt2 _First2, _Pr _Pred, std::false_type)
 	{
-		typedef std::iterator_traits<_InIt>::difference_type difference_type;
+		typedef typename std::iterator_traits<_InIt>::difference_type difference_type;
 		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
 
 		cancellation_token_with_position<difference_type> _Token(_Size);
@@ -34,6 +34,37 @@ namespace details {
 		return _Token.get_position();
 	}
 
+	// par_vec over contiguous arithmetic elements, every chunk runs the vector kernel block by block
+	template<class _ExPolicy, class _InIt, class _Diff, class _InIt2, class _Pr>
+	typename std::iterator_traits<_InIt>::difference_type _Mismatch_impl_helper(const _ExPolicy&, _InIt _First, _Diff _Size, _InIt2 _First2, _Pr _Pred, std::true_type)
+	{
+		typedef typename std::iterator_traits<_InIt>::difference_type difference_type;
+		typedef typename std::iterator_traits<_InIt>::value_type value_type;
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		const value_type *_Base = std::addressof(*_First);
+		const value_type *_Base2 = std::addressof(*_First2);
+		cancellation_token_with_position<difference_type> _Token(_Size);
+
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Base, _Size, _Pred,
+			[&_Token, _Base, _Base2](const value_type *_Begin, size_t _Partition_count, _Pr&){
+			const difference_type _Dist = _Begin - _Base;
+			const value_type *_Begin2 = _Base2 + _Dist;
+
+			_Vec_search_blocks<value_type>(_Dist, _Partition_count, _Token, [_Begin, _Begin2](size_t _Offset, size_t _Len){
+				return _Vec_mismatch(_Begin + _Offset, _Begin2 + _Offset, _Len, _Vec_element<value_type>::value);
+			});
+		});
+
+		return _Token.get_position();
+	}
+
+	template<class _ExPolicy, class _InIt, class _Diff, class _InIt2, class _Pr>
+	inline typename std::iterator_traits<_InIt>::difference_type _Mismatch_impl_helper(const _ExPolicy& _Policy, _InIt _First, _Diff _Size, _InIt2 _First2, _Pr _Pred)
+	{
+		return _Mismatch_impl_helper(_Policy, _First, _Size, _First2, _Pred, _Use_vec_kernel2<_ExPolicy, _InIt, _InIt2, _Pr>());
+	}
+
 	//
 	// mismatch
 	//
@@ -136,7 +167,7 @@ inline typename details::_enable_if_policy<_ExPolicy, std::pair<_InIt, _InIt2>>:
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
 	return details::_Mismatch_impl(_Policy, _First, _Last, _First2, _Pred, _Cat);
 }
 
@@ -152,7 +183,7 @@ inline typename details::_enable_if_policy<_ExPolicy, std::pair<_InIt, _InIt2>>:
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
 
-	details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
 	return details::_Mismatch_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, _Cat);
 }
 
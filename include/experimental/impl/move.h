@@ -44,9 +44,9 @@ template <class _ExPolicy, class _InIt, class _OutIt>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type move(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
 	return details::_Move_impl(_Policy, _First, _Last, _Dest, _Cat);
 }
 _PSTL_NS1_END // std::experimental::parallel
@@ -20,35 +20,93 @@ namespace details {
 		_EXP_RETHROW
 	}
 
+	// Sample-select: every round sorts a sample of the range, picks two splitters bracketing the rank of nth in the
+	// sample and moves them to both ends of the range. The larger of the outer buckets (smaller than the low splitter
+	// or greater than the high splitter) is split off by a first parallel partition, the second partition only goes
+	// over the remaining smaller side. The next round only looks at the bucket holding nth, which is a few percent of
+	// the range when nth lands between the splitters, as it does with high probability.
+	const size_t _Nth_element_sequential_size = 1 << 16;
+	const size_t _Nth_element_sample_size = 4096;
+	const size_t _Nth_element_sample_margin = 128; // twice the square root of the sample size
+	const int _Nth_element_max_rounds = 16;
+
 	template<class _ExPolicy, class _RanIt, class _Pred>
 	inline void _Nth_element_impl(const _ExPolicy& _Policy, _RanIt _First, _RanIt _Nth, _RanIt _Last, _Pred _Pr)
 	{
-		const size_t _Chunk_size = 2048;
-
-		if (_First == _Last)
-			return;
-
-		--_Last;
-
-#pragma warning(suppress: 6295)
-		for (; _Chunk_size > _Last - _First;) {
-			_RanIt _Pivot = _First + (_Last - _First) / 2;
-			std::swap(*_Pivot, *_Last);
-
-			_Pivot = partition(_Policy, _First, _Last, [_Last, _Pr](std::iterator_traits<_RanIt>::reference _Val) mutable {
-				return _Pr(_Val, *_Last);
+		typedef typename std::iterator_traits<_RanIt>::reference _Reference;
+
+		for (int _Round = 0; _Round < _Nth_element_max_rounds; ++_Round)
+		{
+			const size_t _Size = _Last - _First;
+			if (_Nth == _Last || _Size <= _Nth_element_sequential_size)
+				break;
+
+			// One sample in every stride, at a pseudo random offset so that periodic inputs don't bias the sample
+			const size_t _Stride = _Size / _Nth_element_sample_size;
+			std::vector<size_t> _Sample(_Nth_element_sample_size);
+			for (size_t _I = 0; _I < _Sample.size(); ++_I)
+				_Sample[_I] = _I * _Stride + ((_I + 1) * 2654435761u + _Round * 40503u) % _Stride;
+
+			std::sort(_Sample.begin(), _Sample.end(), [_First, &_Pr](size_t _Left, size_t _Right) {
+				return _Pr(_First[_Left], _First[_Right]);
 			});
 
-			std::swap(*_Last, *_Pivot);
-
-			if (_Pivot == _Nth)
+			const size_t _Rank = static_cast<size_t>(_Nth - _First) * _Sample.size() / _Size;
+			size_t _Low = _Sample[_Rank > _Nth_element_sample_margin ? _Rank - _Nth_element_sample_margin : 0];
+			size_t _High = _Sample[(std::min)(_Rank + _Nth_element_sample_margin, _Sample.size() - 1)];
+
+			// Low splitter at the front, high splitter at the back, out of reach of the partitions
+			std::iter_swap(_First, _First + _Low);
+			if (_High == 0)
+				_High = _Low;
+			std::iter_swap(_First + _High, _Last - 1);
+
+			auto _Below_low = [_First, _Pr](_Reference _Val) mutable { return _Pr(_Val, *_First); };
+			auto _Not_above_high = [_Last, _Pr](_Reference _Val) mutable { return !_Pr(*(_Last - 1), _Val); };
+
+			_RanIt _Low_end, _High_begin;
+			if (_Nth - _First < _Last - _Nth)
+			{
+				_High_begin = _Partition_impl(_Policy, _First + 1, _Last - 1, _Not_above_high, std::random_access_iterator_tag());
+				if (_Nth > _High_begin)
+				{
+					std::iter_swap(_High_begin, _Last - 1);
+					_First = _High_begin + 1;
+					continue;
+				}
+				_Low_end = _Partition_impl(_Policy, _First + 1, _High_begin, _Below_low, std::random_access_iterator_tag());
+			}
+			else
+			{
+				_Low_end = _Partition_impl(_Policy, _First + 1, _Last - 1, _Below_low, std::random_access_iterator_tag());
+				if (_Nth < _Low_end - 1)
+				{
+					std::iter_swap(_First, _Low_end - 1);
+					_Last = _Low_end - 1;
+					continue;
+				}
+				_High_begin = _Partition_impl(_Policy, _Low_end, _Last - 1, _Not_above_high, std::random_access_iterator_tag());
+			}
+
+			// [_First, _Low_end - 1) < low splitter <= [_Low_end, _High_begin) <= high splitter < (_High_begin, _Last)
+			std::iter_swap(_First, _Low_end - 1);
+			std::iter_swap(_High_begin, _Last - 1);
+
+			const bool _Equal_splitters = !_Pr(*(_Low_end - 1), *_High_begin);
+			if (_Nth < _Low_end - 1)
+				_Last = _Low_end - 1;
+			else if (_Nth > _High_begin)
+				_First = _High_begin + 1;
+			else if (_Nth == _Low_end - 1 || _Nth == _High_begin || _Equal_splitters)
 				return;
-			else if (_Nth < _Pivot)
-				_Last = _Pivot - 1;
-			else _First = _Pivot + 1;
+			else
+			{
+				_First = _Low_end;
+				_Last = _High_begin;
+			}
 		}
 
-		std::nth_element(_First, _Nth, _Last + 1, _Pr);
+		std::nth_element(_First, _Nth, _Last, _Pr);
 	}
 
 	template<class _RanIt, class _Pred>
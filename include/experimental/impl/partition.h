@@ -3,7 +3,11 @@
 #ifndef _IMPL_PARTITION_H_
 #define _IMPL_PARTITION_H_ 1
 
+#include <numeric>
+#include <limits>
+
 #include "algorithm_impl.h"
+#include "rotate.h"
 
 _PSTL_NS1_BEGIN
 namespace details
@@ -27,7 +31,7 @@ namespace details
 
 	public:
 
-		_PartitionRangeHelper(size_t _TotalSize, size_t _ChunkSize) : _M_Begin(0), _M_End(_TotalSize), _M_ChunkSize(_ChunkSize), _M_UsedSize(0), _M_TotalSize(_TotalSize) {}
+		_PartitionRangeHelper(size_t _TotalSize, size_t _ChunkSize) : _M_Begin(0), _M_End(_TotalSize), _M_UsedSize(0), _M_ChunkSize(_ChunkSize), _M_TotalSize(_TotalSize) {}
 
 		// It should only be called when the entire _Range has been acquired (_AcquireLeft or _AcquireRight returns empty _Range).
 		size_t _Boundary() const
@@ -162,6 +166,162 @@ namespace details
 	}
 
 
+	// Collects the iterators to the first element of consecutive blocks of _Block_size elements followed by _Last, the
+	// last block may be shorter and its length is returned
+	template <typename _FwdIt>
+	size_t _Index_blocks(_FwdIt _First, _FwdIt _Last, size_t _Block_size, std::vector<_FwdIt>& _Blocks, std::forward_iterator_tag)
+	{
+		_Blocks.assign(1, _First);
+		size_t _Last_len = 0;
+		for (_FwdIt _It = _First; _It != _Last;)
+		{
+			++_It;
+			if (++_Last_len == _Block_size && _It != _Last)
+			{
+				_Blocks.push_back(_It);
+				_Last_len = 0;
+			}
+		}
+		_Blocks.push_back(_Last);
+		return _Last_len;
+	}
+
+	template <typename _RanIt>
+	size_t _Index_blocks(_RanIt _First, _RanIt _Last, size_t _Block_size, std::vector<_RanIt>& _Blocks, std::random_access_iterator_tag)
+	{
+		const size_t _Size = _Last - _First;
+		const size_t _Block_num = _Size == 0 ? 1 : (_Size + _Block_size - 1) / _Block_size;
+		_Blocks.resize(_Block_num + 1);
+		for (size_t _B = 0; _B < _Block_num; ++_B)
+			_Blocks[_B] = _First + _B * _Block_size;
+		_Blocks[_Block_num] = _Last;
+		return _Size - (_Block_num - 1) * _Block_size;
+	}
+
+	template <typename _FwdIt>
+	size_t _Index_blocks(_FwdIt _First, _FwdIt _Last, size_t _Block_size, std::vector<_FwdIt>& _Blocks)
+	{
+		return _Index_blocks(_First, _Last, _Block_size, _Blocks, _Iter_cat(_First));
+	}
+
+	// Walks the elements of a forward range that are out of place after the blocks have been partitioned, the
+	// false elements left of the partition point or the true elements right of it, block by block.
+	template <typename _FwdIt>
+	class _Misplaced_cursor
+	{
+		const std::vector<_FwdIt> &_Blocks;
+		const std::vector<std::pair<size_t, size_t>> &_Ranges; // misplaced [first, second) offsets in every block
+		size_t _Block, _Left;
+		_FwdIt _Cur;
+
+		void _Skip_empty()
+		{
+			while (_Left == 0 && ++_Block < _Ranges.size())
+			{
+				_Left = _Ranges[_Block].second - _Ranges[_Block].first;
+				_Cur = _Blocks[_Block];
+				std::advance(_Cur, _Ranges[_Block].first);
+			}
+		}
+
+	public:
+		// Positions the cursor on the _Index-th misplaced element, _Prefix holds the exclusive sums of the counts
+		_Misplaced_cursor(const std::vector<_FwdIt> &_B, const std::vector<std::pair<size_t, size_t>> &_R, const std::vector<size_t> &_Prefix, size_t _Index)
+			: _Blocks(_B), _Ranges(_R)
+		{
+			_Block = (std::upper_bound(_Prefix.begin(), _Prefix.end(), _Index) - _Prefix.begin()) - 1;
+			const size_t _Skip = _Index - _Prefix[_Block];
+			_Left = _Ranges[_Block].second - _Ranges[_Block].first - _Skip;
+			_Cur = _Blocks[_Block];
+			std::advance(_Cur, _Ranges[_Block].first + _Skip);
+			_Skip_empty();
+		}
+
+		_FwdIt get() const
+		{
+			return _Cur;
+		}
+
+		void next()
+		{
+			++_Cur;
+			--_Left;
+			_Skip_empty();
+		}
+	};
+
+	// Partition of forward and bidirectional ranges: a first walk indexes the iterators of fixed size blocks, the
+	// blocks are partitioned in parallel, then the k-th false element left of the partition point is swapped with the
+	// k-th true element right of it, the swaps being split evenly between the tasks.
+	template <typename _FwdIt, typename _Pr>
+	_FwdIt _Parallel_forward_partition_impl(_FwdIt _First, _FwdIt _Last, _Pr _Pred, size_t _Block_size)
+	{
+		typedef std::pair<size_t, size_t> _Offsets;
+
+		std::vector<_FwdIt> _Blocks;
+		const size_t _Last_len = _Index_blocks(_First, _Last, _Block_size, _Blocks);
+		const size_t _Block_num = _Blocks.size() - 1;
+		const size_t _Size = (_Block_num - 1) * _Block_size + _Last_len;
+		if (_Block_num < 4 || get_hardware_concurrency() < 2)
+			return std::partition(_First, _Last, _Pred);
+
+		std::vector<size_t> _Trues(_Block_num);
+		_Partitioner<static_partitioner_tag>::_For_Each(_Blocks.cbegin(), _Block_num, _Pred,
+			[&_Blocks, &_Trues](typename std::vector<_FwdIt>::const_iterator _CurItr, size_t _Count, _Pr& _UserPred) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+				_Trues[_CurItr - _Blocks.cbegin()] = std::distance(_CurItr[0], std::partition(_CurItr[0], _CurItr[1], _UserPred));
+		}, 1);
+
+		const size_t _Mid = std::accumulate(_Trues.begin(), _Trues.end(), size_t{ 0 });
+
+		std::vector<_Offsets> _False_ranges(_Block_num), _True_ranges(_Block_num);
+		std::vector<size_t> _False_prefix(_Block_num + 1), _True_prefix(_Block_num + 1);
+		for (size_t _B = 0; _B < _Block_num; ++_B)
+		{
+			const size_t _Start = _B * _Block_size, _Len = _B + 1 < _Block_num ? _Block_size : _Last_len;
+			const size_t _Split = _Mid > _Start ? (std::min)(_Mid - _Start, _Len) : 0; // partition point inside the block
+
+			_False_ranges[_B] = _Offsets(_Trues[_B], (std::max)(_Trues[_B], _Split));
+			_True_ranges[_B] = _Offsets((std::min)(_Split, _Trues[_B]), _Trues[_B]);
+			_False_prefix[_B + 1] = _False_prefix[_B] + _False_ranges[_B].second - _False_ranges[_B].first;
+			_True_prefix[_B + 1] = _True_prefix[_B] + _True_ranges[_B].second - _True_ranges[_B].first;
+		}
+
+		const size_t _Swaps = _False_prefix[_Block_num];
+		const size_t _Jobs = (std::min)(static_cast<size_t>(get_hardware_concurrency()) * 4, (_Swaps + _Block_size - 1) / _Block_size);
+		if (_Jobs > 0)
+		{
+			std::vector<size_t> _Job_bounds(_Jobs + 1);
+			for (size_t _J = 0; _J <= _Jobs; ++_J)
+				_Job_bounds[_J] = _Swaps * _J / _Jobs;
+
+			_Partitioner<static_partitioner_tag>::_For_Each(_Job_bounds.cbegin(), _Jobs,
+				[&](std::vector<size_t>::const_iterator _CurItr, size_t _Count) {
+				for (; _Count > 0; --_Count, ++_CurItr)
+				{
+					_Misplaced_cursor<_FwdIt> _False(_Blocks, _False_ranges, _False_prefix, _CurItr[0]);
+					_Misplaced_cursor<_FwdIt> _True(_Blocks, _True_ranges, _True_prefix, _CurItr[0]);
+					for (size_t _I = _CurItr[0]; _I < _CurItr[1]; ++_I)
+					{
+						std::iter_swap(_False.get(), _True.get());
+						if (_I + 1 < _CurItr[1])
+						{
+							_False.next();
+							_True.next();
+						}
+					}
+				}
+			}, 1);
+		}
+
+		if (_Mid == _Size)
+			return _Last;
+
+		_FwdIt _Result = _Blocks[_Mid / _Block_size];
+		std::advance(_Result, _Mid % _Block_size);
+		return _Result;
+	}
+
 	//
 	// Partition
 	//
@@ -186,17 +346,16 @@ namespace details
 			return _First + _Parallel_partition_impl(_First, _Size, _Pred, _Chunk_size, _HdConc);
 	}
 
-	// FIXME currently the forward iterator defaults to sequential execution policy
 	template <class _ExPolicy, typename _FwdIt, typename _Pr>
-	inline typename _enable_if_parallel<_ExPolicy, _FwdIt>::type _Partition_impl(const _ExPolicy&, _FwdIt _First, _FwdIt _Last, _Pr _Pred, std::forward_iterator_tag _Cat)
+	inline typename _enable_if_parallel<_ExPolicy, _FwdIt>::type _Partition_impl(const _ExPolicy&, _FwdIt _First, _FwdIt _Last, _Pr _Pred, std::forward_iterator_tag)
 	{
-		return _Partition_impl(seq, _First, _Last, _Pred, _Cat);
+		return _Parallel_forward_partition_impl(_First, _Last, _Pred, 1024);
 	}
 
 	template <class _ExPolicy, typename _FwdIt, typename _Pr>
-	inline typename _enable_if_parallel<_ExPolicy, _FwdIt>::type _Partition_impl(const _ExPolicy&, _FwdIt _First, _FwdIt _Last, _Pr _Pred, std::bidirectional_iterator_tag _Cat)
+	inline typename _enable_if_parallel<_ExPolicy, _FwdIt>::type _Partition_impl(const _ExPolicy&, _FwdIt _First, _FwdIt _Last, _Pr _Pred, std::bidirectional_iterator_tag)
 	{
-		return _Partition_impl(seq, _First, _Last, _Pred, _Cat);
+		return _Parallel_forward_partition_impl(_First, _Last, _Pred, 1024);
 	}
 
 	template <typename _FwdIt, typename _Pr, class _IterCat>
@@ -208,67 +367,248 @@ namespace details
 	//
 	// stable_partition
 	//
-	template<class _BidIt, class _Pr, class _IterCat>
-	inline _BidIt _Stable_partition_impl(const sequential_execution_policy&, _BidIt _First, _BidIt _Last, _Pr _Pred, _IterCat)
+	// The range is indexed in blocks. With scratch storage for the whole range the predicate is evaluated once per
+	// element in parallel, recording a flag and counting the true elements of every block; an exclusive scan of the
+	// counts gives where the true and the false elements of each block go, they are move constructed there into the
+	// storage in parallel and moved back block by block.
+	// With less storage (explicit bound or failed allocation) every task stably partitions its blocks with its own slice
+	// of the storage, then adjacent blocks are combined in a tree, the false elements of the left side trading places
+	// with the true elements of the right side through a rotation, the large ones being parallel.
+	const size_t _Stable_partition_block_size = 2048;
+	const size_t _Stable_partition_parallel_rotate_size = 1 << 15;
+
+	// Sequential stable partition of the _Size elements of [_First, _Last) with scratch storage for _Capacity elements:
+	// the false elements are moved out to the storage while the true ones are compacted, larger ranges are split in
+	// halves which are combined with a rotation.
+	template<class _BidIt, class _Pr, class _Ty>
+	_BidIt _Stable_partition_buffered(_BidIt _First, _BidIt _Last, size_t _Size, _Pr& _Pred, _Ty *_Buffer, size_t _Capacity)
 	{
-		_EXP_TRY
-			return std::stable_partition(_First, _Last, _Pred);
-		_EXP_RETHROW
+		if (_Size == 0)
+			return _First;
+
+		if (_Size == 1)
+			return _Pred(*_First) ? _Last : _First;
+
+		if (_Size <= _Capacity)
+		{
+			_Constructed_range<_Ty> _Falses(_Buffer);
+			_BidIt _Out = _First;
+			for (; _First != _Last; ++_First)
+			{
+				if (_Pred(*_First))
+				{
+					if (_Out != _First)
+						*_Out = std::move(*_First);
+					++_Out;
+				}
+				else
+				{
+					::new (static_cast<void *>(_Buffer + _Falses._Count)) _Ty(std::move(*_First));
+					++_Falses._Count;
+				}
+			}
+
+			std::move(_Buffer, _Buffer + _Falses._Count, _Out);
+			return _Out;
+		}
+
+		_BidIt _Mid = _First;
+		std::advance(_Mid, _Size / 2);
+		_BidIt _Left = _Stable_partition_buffered(_First, _Mid, _Size / 2, _Pred, _Buffer, _Capacity);
+		_BidIt _Right = _Stable_partition_buffered(_Mid, _Last, _Size - _Size / 2, _Pred, _Buffer, _Capacity);
+		return std::rotate(_Left, _Mid, _Right);
 	}
 
-	template<class _BidIt, class _Pr>
-	inline _BidIt _Stable_partition_impl_helper(_BidIt _First, _BidIt _Last, size_t _Count, _Pr _Pred, size_t _Div)
+	// _Buffer holds room for all the _Size elements of the blocks
+	template<class _BidIt, class _Pr, class _Ty>
+	_BidIt _Flag_scan_stable_partition(const std::vector<_BidIt>& _Blocks, size_t _Size, _Pr& _Pred, _Ty *_Buffer)
 	{
-		if (_Div < 2)
-			return std::stable_partition(_First, _Last, _Pred);
-		else {
-			auto _Mid = _First;
-			size_t _Mid_point = _Count / 2;
-			_Count -= _Mid_point;
+		typedef typename std::vector<_BidIt>::const_iterator _Block_iter;
+
+		const size_t _Block_num = _Blocks.size() - 1;
+		std::vector<unsigned char> _Flags(_Size);
+		std::vector<size_t> _Trues(_Block_num + 1);
+
+		_Partitioner<static_partitioner_tag>::_For_Each(_Blocks.cbegin(), _Block_num, _Pred,
+			[&_Blocks, &_Flags, &_Trues](_Block_iter _CurItr, size_t _Count, _Pr& _UserPred) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				const size_t _B = _CurItr - _Blocks.cbegin();
+				unsigned char *_Flag = _Flags.data() + _B * _Stable_partition_block_size;
+				size_t _Sum = 0;
+				for (_BidIt _It = _CurItr[0]; _It != _CurItr[1]; ++_It, ++_Flag)
+				{
+					*_Flag = static_cast<unsigned char>(_UserPred(*_It) ? 1 : 0);
+					_Sum += *_Flag;
+				}
+				_Trues[_B] = _Sum;
+			}
+		}, 1);
 
-			std::advance(_Mid, _Mid_point);
+		// Exclusive scan, the true elements of block _B start at _Trues[_B] and its false elements after all the true ones
+		size_t _Sum = 0;
+		for (auto& _Count : _Trues)
+		{
+			const size_t _Block_trues = _Count;
+			_Count = _Sum;
+			_Sum += _Block_trues;
+		}
 
-			_BidIt _Right;
+		const size_t _Mid = _Trues[_Block_num];
+		if (_Mid == 0)
+			return _Blocks.front();
+		if (_Mid == _Size)
+			return _Blocks.back();
 
-			auto _Handle = make_task([_Pred, _Div, _Count, _Mid, _Last, &_Right]{
-				_Right = _Stable_partition_impl_helper(_Mid, _Last, _Count, _Pred, _Div / 2);
-			});
+		_Constructed_ranges<_Ty> _Scattered(_Buffer, _Block_num * 2);
+		_Partitioner<static_partitioner_tag>::_For_Each(_Blocks.cbegin(), _Block_num,
+			[&_Blocks, &_Flags, &_Trues, &_Scattered, _Mid, _Buffer](_Block_iter _CurItr, size_t _Count) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				const size_t _B = _CurItr - _Blocks.cbegin();
+				auto& _True_range = _Scattered._Ranges[_B * 2];
+				auto& _False_range = _Scattered._Ranges[_B * 2 + 1];
+				_True_range.first = _Trues[_B];
+				_False_range.first = _Mid + _B * _Stable_partition_block_size - _Trues[_B];
+
+				const unsigned char *_Flag = _Flags.data() + _B * _Stable_partition_block_size;
+				for (_BidIt _It = _CurItr[0]; _It != _CurItr[1]; ++_It, ++_Flag)
+				{
+					auto& _Range = *_Flag ? _True_range : _False_range;
+					::new (static_cast<void *>(_Buffer + _Range.first + _Range.second)) _Ty(std::move(*_It));
+					++_Range.second;
+				}
+			}
+		}, 1);
 
-			TaskGroup _Tg;
-			_Tg.run(_Handle);
+		// The storage is now complete, track it by destination block while moving it back
+		_Scattered._Ranges.resize(_Block_num);
+		for (size_t _B = 0; _B < _Block_num; ++_B)
+			_Scattered._Ranges[_B] = std::pair<size_t, size_t>(_B * _Stable_partition_block_size, (std::min)(_Stable_partition_block_size, _Size - _B * _Stable_partition_block_size));
 
-			auto _Left = _Stable_partition_impl_helper(_First, _Mid, _Mid_point, _Pred, _Div / 2);
-			_Tg.wait();
+		_Partitioner<static_partitioner_tag>::_For_Each(_Blocks.cbegin(), _Block_num,
+			[&_Blocks, &_Scattered, _Buffer](_Block_iter _CurItr, size_t _Count) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				auto& _Range = _Scattered._Ranges[_CurItr - _Blocks.cbegin()];
+				_Ty *_Src = _Buffer + _Range.first;
+				std::move(_Src, _Src + _Range.second, _CurItr[0]);
+				for (; _Range.second > 0; --_Range.second)
+					(_Src++)->~_Ty();
+			}
+		}, 1);
+
+		_BidIt _Result = _Blocks[_Mid / _Stable_partition_block_size];
+		std::advance(_Result, _Mid % _Stable_partition_block_size);
+		return _Result;
+	}
 
-			return std::rotate(_Left, _Mid, _Right);
+	// Combines the stably partitioned blocks [_Lo, _Hi), returns their partition point and number of true elements
+	template<class _ExPolicy, class _BidIt>
+	std::pair<_BidIt, size_t> _Stable_partition_combine(const _ExPolicy& _Policy, const std::vector<_BidIt>& _Blocks, const std::vector<size_t>& _Trues, size_t _Lo, size_t _Hi)
+	{
+		if (_Hi - _Lo == 1)
+		{
+			_BidIt _Mid = _Blocks[_Lo];
+			std::advance(_Mid, _Trues[_Lo]);
+			return std::make_pair(_Mid, _Trues[_Lo]);
 		}
+
+		const size_t _Split = _Lo + (_Hi - _Lo) / 2;
+		std::pair<_BidIt, size_t> _Right;
+		auto _Handle = make_task([&_Policy, &_Blocks, &_Trues, &_Right, _Split, _Hi] {
+			_Right = _Stable_partition_combine(_Policy, _Blocks, _Trues, _Split, _Hi);
+		});
+
+		TaskGroup _Tg;
+		_Tg.run(_Handle);
+
+		auto _Left = _Stable_partition_combine(_Policy, _Blocks, _Trues, _Lo, _Split);
+		_Tg.wait();
+
+		// Only the last block may be short and it is always on the right side
+		const size_t _Rotated = (_Split - _Lo) * _Stable_partition_block_size - _Left.second + _Right.second;
+		_BidIt _Mid = _Rotated >= _Stable_partition_parallel_rotate_size ?
+			_Rotate_impl(_Policy, _Left.first, _Blocks[_Split], _Right.first, details::_Iter_cat(_Left.first)) :
+			std::rotate(_Left.first, _Blocks[_Split], _Right.first);
+
+		return std::make_pair(_Mid, _Left.second + _Right.second);
 	}
 
-	template<class _ExPolicy, class _BidIt, class _Pr, class _IterCat>
-	inline _BidIt _Stable_partition_impl(const _ExPolicy&, _BidIt _First, _BidIt _Last, _Pr _Pred, _IterCat)
+	// _Buffer holds room for _Capacity elements, less than the size of the blocks
+	template<class _ExPolicy, class _BidIt, class _Pr, class _Ty>
+	_BidIt _Bounded_stable_partition(const _ExPolicy& _Policy, const std::vector<_BidIt>& _Blocks, size_t _Last_len, _Pr& _Pred, _Ty *_Buffer, size_t _Capacity)
 	{
-		typedef std::iterator_traits<_BidIt>::difference_type difference_type;
-		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
-		typedef composable_iterator<_BidIt, std::vector<difference_type>::iterator > _Iter_type;
+		const size_t _Block_num = _Blocks.size() - 1;
+		// The jobs follow the blocks, not the storage: _Stable_partition_buffered works with any slice, even an empty one
+		const size_t _Jobs = (std::min)(_Block_num, static_cast<size_t>(get_hardware_concurrency()) * 4);
+		const size_t _Slice = _Capacity / _Jobs;
+
+		std::vector<size_t> _Job_bounds(_Jobs + 1);
+		for (size_t _J = 0; _J <= _Jobs; ++_J)
+			_Job_bounds[_J] = _Block_num * _J / _Jobs;
+
+		std::vector<size_t> _Trues(_Block_num);
+		_Partitioner<static_partitioner_tag>::_For_Each(_Job_bounds.cbegin(), _Jobs, _Pred,
+			[&](std::vector<size_t>::const_iterator _CurItr, size_t _Count, _Pr& _UserPred) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				_Ty *_Slice_begin = _Buffer + (_CurItr - _Job_bounds.cbegin()) * _Slice;
+				for (size_t _B = _CurItr[0]; _B < _CurItr[1]; ++_B)
+				{
+					const size_t _Len = _B + 1 < _Block_num ? _Stable_partition_block_size : _Last_len;
+					_Trues[_B] = std::distance(_Blocks[_B], _Stable_partition_buffered(_Blocks[_B], _Blocks[_B + 1], _Len, _UserPred, _Slice_begin, _Slice));
+				}
+			}
+		}, 1);
 
-		if (_First != _Last) {
-			auto _Size = std::distance(_First, _Last);
-			return _Stable_partition_impl_helper(_First, _Last, _Size, _Pred, _Size == 1 ? 1 : get_hardware_concurrency());
-		}
+		return _Stable_partition_combine(_Policy, _Blocks, _Trues, 0, _Block_num).first;
+	}
+
+	template<class _BidIt, class _Pr, class _IterCat>
+	inline _BidIt _Stable_partition_impl(const sequential_execution_policy&, _BidIt _First, _BidIt _Last, _Pr _Pred, size_t _Buffer_size, _IterCat)
+	{
+		_EXP_TRY
+			// Unbounded, skip the walk over the range
+			if (_Buffer_size == (std::numeric_limits<size_t>::max)())
+				return std::stable_partition(_First, _Last, _Pred);
+
+			const size_t _Size = std::distance(_First, _Last);
+			if (_Buffer_size >= _Size)
+				return std::stable_partition(_First, _Last, _Pred);
 
-		return _First;
+			_Scratch_buffer<typename std::iterator_traits<_BidIt>::value_type> _Buffer(_Buffer_size);
+			return _Stable_partition_buffered(_First, _Last, _Size, _Pred, _Buffer.data(), _Buffer.capacity());
+		_EXP_RETHROW
 	}
 
-	template<class _ExPolicy, class _BidIt, class _OutIt, class _Pr>
-	inline typename _enable_if_parallel<_ExPolicy, _BidIt>::type _Stable_partition_impl(const _ExPolicy&, _BidIt _First, _BidIt _Last, _Pr _Pred, std::input_iterator_tag _Cat)
+	template<class _ExPolicy, class _BidIt, class _Pr, class _IterCat>
+	inline _BidIt _Stable_partition_impl(const _ExPolicy& _Policy, _BidIt _First, _BidIt _Last, _Pr _Pred, size_t _Buffer_size, _IterCat _Cat)
 	{
-		return _Stable_partition_impl(seq, _First, _Last, _Pred, _Cat);
+		std::vector<_BidIt> _Blocks;
+		const size_t _Last_len = _Index_blocks(_First, _Last, _Stable_partition_block_size, _Blocks);
+		const size_t _Block_num = _Blocks.size() - 1;
+		if (_Block_num < 2 || get_hardware_concurrency() < 2)
+			return _Stable_partition_impl(seq, _First, _Last, _Pred, _Buffer_size, _Cat);
+
+		const size_t _Size = (_Block_num - 1) * _Stable_partition_block_size + _Last_len;
+		_Scratch_buffer<typename std::iterator_traits<_BidIt>::value_type> _Buffer((std::min)(_Size, _Buffer_size));
+		if (_Buffer.capacity() >= _Size)
+			return _Flag_scan_stable_partition(_Blocks, _Size, _Pred, _Buffer.data());
+
+		return _Bounded_stable_partition(_Policy, _Blocks, _Last_len, _Pred, _Buffer.data(), _Buffer.capacity());
+	}
+
+	template<class _ExPolicy, class _BidIt, class _Pr>
+	inline typename _enable_if_parallel<_ExPolicy, _BidIt>::type _Stable_partition_impl(const _ExPolicy&, _BidIt _First, _BidIt _Last, _Pr _Pred, size_t _Buffer_size, std::input_iterator_tag _Cat)
+	{
+		return _Stable_partition_impl(seq, _First, _Last, _Pred, _Buffer_size, _Cat);
 	}
 
 	template<class _BidIt, class _Pr, class _IterCat>
-	inline _BidIt _Stable_partition_impl(const execution_policy& _Policy, _BidIt _First, _BidIt _Last, _Pr _Pred, _IterCat _Cat)
+	inline _BidIt _Stable_partition_impl(const execution_policy& _Policy, _BidIt _First, _BidIt _Last, _Pr _Pred, size_t _Buffer_size, _IterCat _Cat)
 	{
-		_EXP_GENERIC_EXECUTION_POLICY(_Stable_partition_impl, _Policy, _First, _Last, _Pred, _Cat);
+		_EXP_GENERIC_EXECUTION_POLICY(_Stable_partition_impl, _Policy, _First, _Last, _Pred, _Buffer_size, _Cat);
 	}
 
 	//
@@ -285,9 +625,8 @@ namespace details
 	template<class _ExPolicy, class _InIt, class _OutIt, class _OutIt2, class _Pr, class _IterCat>
 	inline std::pair<_OutIt, _OutIt2> _Partition_copy_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _OutIt2 _Dest2, _Pr _Pred, _IterCat)
 	{
-		typedef std::iterator_traits<_InIt>::difference_type difference_type;
-		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
-		typedef composable_iterator<_InIt, std::vector< std::pair<difference_type, difference_type> >::iterator > _Iter_type;
+		typedef typename std::iterator_traits<_InIt>::difference_type difference_type;
+		typedef composable_iterator<_InIt, typename std::vector< std::pair<difference_type, difference_type> >::iterator > _Iter_type;
 		typedef _Output_token_double<_OutIt, _OutIt2> _Output_token;
 
 		if (_First != _Last) {
@@ -302,7 +641,7 @@ namespace details
 				difference_type _Sum_false = 0;
 
 				LoopHelper<_ExPolicy, _Iter_type>::Loop(_Begin, _Partition_count,
-					[_Pred, &_Sum_true, &_Sum_false](_Iter_type::reference _It){
+					[_Pred, &_Sum_true, &_Sum_false](typename _Iter_type::reference _It){
 
 					auto _Filter = std::get<1>(_It);
 
@@ -324,7 +663,7 @@ namespace details
 				auto _Out = _Dest.get();
 
 				LoopHelper<_ExPolicy, _Iter_type>::Loop(_Begin, _Partition_count,
-					[&_Out](_Iter_type::reference _It){
+					[&_Out](typename _Iter_type::reference _It){
 
 					auto _Filter = std::get<1>(_It);
 
@@ -361,7 +700,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type partition(_E
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Partition_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Partition_impl(_Policy, _First, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _BidIt, class _Pr>
@@ -369,17 +708,27 @@ inline typename details::_enable_if_policy<_ExPolicy, _BidIt>::type stable_parti
 {
 	static_assert(std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<_BidIt>::iterator_category>::value, "Required bidirectional iterator or stronger.");
 
-	return details::_Stable_partition_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	return details::_Stable_partition_impl(_Policy, _First, _Last, _Pred, (std::numeric_limits<size_t>::max)(), details::_Iter_cat(_First));
+}
+
+// Extension: stable_partition using at most _Buffer_size elements of scratch storage. Smaller buffers trade memory for
+// additional element moves, 0 partitions without any buffer.
+template<class _ExPolicy, class _BidIt, class _Pr>
+inline typename details::_enable_if_policy<_ExPolicy, _BidIt>::type stable_partition(_ExPolicy&& _Policy, _BidIt _First, _BidIt _Last, _Pr _Pred, size_t _Buffer_size)
+{
+	static_assert(std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<_BidIt>::iterator_category>::value, "Required bidirectional iterator or stronger.");
+
+	return details::_Stable_partition_impl(_Policy, _First, _Last, _Pred, _Buffer_size, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _OutIt, class _OutIt2, class _Pr>
 inline typename details::_enable_if_policy<_ExPolicy, std::pair<_OutIt, _OutIt2> >::type partition_copy(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _OutIt2 _Dest2, _Pr _Pred)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt2>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt2>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt, _OutIt2>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _OutIt, _OutIt2>::iterator_category _Cat;
 	return details::_Partition_copy_impl(_Policy, _First, _Last, _Dest, _Dest2, _Pred, _Cat);
 }
 _PSTL_NS1_END // std::experimental::parallel
@@ -63,6 +63,130 @@ namespace details {
 		}
 	};
 
+	template<typename _ExPolicy, typename _IterCat>
+	struct _Transform_reduce_helper
+	{
+		template<typename _Ty, typename _InIt, typename _UnaryOp, typename _BinOp>
+		static _Ty Loop(_InIt _First, size_t _Count, _UnaryOp& _Unary_op, _BinOp& _Binary_op)
+		{
+			_Ty _Val = _Unary_op(*_First);
+			++_First;
+			--_Count;
+
+			for (size_t _I = 0; _I < _Count; ++_First, ++_I)
+				_Val = _Binary_op(_Val, _Unary_op(*_First));
+
+			return _Val;
+		}
+	};
+
+	// pragma par
+	template<>
+	struct _Transform_reduce_helper < parallel_execution_policy, std::random_access_iterator_tag >
+	{
+		template<typename _Ty, typename _InIt, typename _UnaryOp, typename _BinOp>
+		static _Ty Loop(_InIt _First, size_t _Count, _UnaryOp& _Unary_op, _BinOp& _Binary_op)
+		{
+			_Ty _Val = _Unary_op(*_First);
+			++_First;
+			--_Count;
+
+			_EXP_PRAGMA_PAR
+				for (size_t _I = 0; _I < _Count; ++_I)
+					_Val = _Binary_op(_Val, _Unary_op(_First[_I]));
+
+			return _Val;
+		}
+	};
+
+	// pragma par_vec
+	template<>
+	struct _Transform_reduce_helper < parallel_vector_execution_policy, std::random_access_iterator_tag >
+	{
+		template<typename _Ty, typename _InIt, typename _UnaryOp, typename _BinOp>
+		static _Ty Loop(_InIt _First, size_t _Count, _UnaryOp& _Unary_op, _BinOp& _Binary_op)
+		{
+			_Ty _Val = _Unary_op(*_First);
+			++_First;
+			--_Count;
+
+#pragma loop(ivdep)
+			for (size_t _I = 0; _I < _Count; ++_I)
+				_Val = _Binary_op(_Val, _Unary_op(_First[_I]));
+
+			return _Val;
+		}
+	};
+
+	// Turns the binary transform of two ranges into a unary transform of their composable_iterator
+	template<typename _BinOp>
+	struct _Zip_transform
+	{
+		_BinOp _Op;
+
+		explicit _Zip_transform(_BinOp _Fn) : _Op(_Fn)
+		{
+		}
+
+		template<typename _Tuple>
+		auto operator()(const _Tuple& _It) -> decltype(std::declval<_BinOp&>()(*std::get<0>(_It), *std::get<1>(_It)))
+		{
+			return _Op(*std::get<0>(_It), *std::get<1>(_It));
+		}
+	};
+
+	// Deterministic reduction: the range is cut into leaves whose size only depends on the length of the range,
+	// every leaf is folded left to right and the leaf results are combined by a fixed pairwise tree in index order.
+	// The scheduling has no influence on the order of operations, thus the result is reproducible bit by bit.
+	const size_t _Deterministic_min_leaf_size = 2048;
+	const size_t _Deterministic_max_leaf_count = 4096;
+
+	inline size_t _Deterministic_leaf_size(size_t _Count)
+	{
+		return (std::max)(_Deterministic_min_leaf_size, (_Count + _Deterministic_max_leaf_count - 1) / _Deterministic_max_leaf_count);
+	}
+
+	// _Leaf_fn(_InIt, size_t) returns the left fold of a non-empty leaf
+	template <class _InIt, class _Ty, class _BinPr, class _LeafFn>
+	_Ty _Deterministic_tree_reduce(_InIt _First, size_t _Count, size_t _Leaf_size, _Ty _Init, _BinPr _BinOp, _LeafFn _Leaf_fn)
+	{
+		const size_t _Leaf_count = (_Count + _Leaf_size - 1) / _Leaf_size;
+
+		std::vector<_InIt> _Leaves;
+		_Leaves.reserve(_Leaf_count);
+		for (size_t _I = 0; _I < _Leaf_count; ++_I)
+		{
+			_Leaves.push_back(_First);
+			if (_I + 1 < _Leaf_count)
+				std::advance(_First, _Leaf_size);
+		}
+
+		// _Ty may not be default constructible
+		std::vector<_Ty> _Partials(_Leaf_count, _Init);
+
+		typedef typename std::vector<_InIt>::iterator _LeafIt;
+		_LeafIt _Leaves_begin = _Leaves.begin();
+		_Partitioner<parallel_execution_policy>::_For_Each(_Leaves_begin, _Leaf_count, _Leaf_fn,
+			[&_Partials, _Leaves_begin, _Leaf_size, _Count](_LeafIt _Begin, size_t _Num, _LeafFn& _Fn) {
+			for (size_t _Leaf = static_cast<size_t>(_Begin - _Leaves_begin), _Last = _Leaf + _Num; _Leaf < _Last; ++_Leaf, ++_Begin)
+				_Partials[_Leaf] = _Fn(*_Begin, (std::min)(_Leaf_size, _Count - _Leaf * _Leaf_size));
+		});
+
+		for (size_t _Stride = 1; _Stride < _Leaf_count; _Stride *= 2)
+		{
+			for (size_t _I = 0; _I + _Stride < _Leaf_count; _I += 2 * _Stride)
+				_Partials[_I] = _BinOp(_Partials[_I], _Partials[_I + _Stride]);
+		}
+
+		return _BinOp(_Init, _Partials[0]);
+	}
+
+	template <class _InIt, class _Ty, class _BinPr, class _LeafFn>
+	_Ty _Deterministic_tree_reduce(_InIt _First, size_t _Count, _Ty _Init, _BinPr _BinOp, _LeafFn _Leaf_fn)
+	{
+		return _Deterministic_tree_reduce(_First, _Count, _Deterministic_leaf_size(_Count), _Init, _BinOp, _Leaf_fn);
+	}
+
 	//
 	// reduce
 	//
@@ -87,7 +211,7 @@ namespace details {
 
 		_Partitioner<_ExecutionPolicy>::_For_Each(_First, std::distance(_First, _Last), _BinOp,
 			[&_Combine](_InIt _Begin, size_t _Count, _BinPr& _UserBinOp) {
-			_Ty _Val = _Reduce_helper<_ExecutionPolicy, _IterCat>::Loop<_Ty>(_Begin, _Count, _UserBinOp);
+			_Ty _Val = _Reduce_helper<_ExecutionPolicy, _IterCat>::template Loop<_Ty>(_Begin, _Count, _UserBinOp);
 
 			bool _Exists;
 			auto &_Sum = _Combine.local(_Exists);
@@ -105,32 +229,266 @@ namespace details {
 		return _Reduce_impl(seq, _First, _Last, _Init, _Pred, _Cat);
 	}
 
+	template <class _InIt, class _Ty, class _BinPr, class _IterCat>
+	_Ty _Reduce_impl(const parallel_deterministic_execution_policy&, _InIt _First, _InIt _Last, _Ty _Init, _BinPr _BinOp, _IterCat)
+	{
+		if (_First == _Last)
+			return _Init;
+
+		// The leaves are folded without the loop pragmas, those allow the compiler to reassociate
+		return _Deterministic_tree_reduce(_First, static_cast<size_t>(std::distance(_First, _Last)), _Init, _BinOp,
+			[_BinOp](_InIt _Begin, size_t _Count) mutable {
+			return _Reduce_helper<sequential_execution_policy, _IterCat>::template Loop<_Ty>(_Begin, _Count, _BinOp);
+		});
+	}
+
+	// A single pass over an input range is sequential, hence deterministic
+	template <class _InIt, class _Ty, class _BinPr>
+	inline _Ty _Reduce_impl(const parallel_deterministic_execution_policy&, _InIt _First, _InIt _Last, _Ty _Init, _BinPr _Pred, std::input_iterator_tag _Cat)
+	{
+		return _Reduce_impl(seq, _First, _Last, _Init, _Pred, _Cat);
+	}
+
 	template <class _InIt, class _Ty, class _BinPr, class _IterCat>
 	inline _Ty _Reduce_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _Ty _Init, _BinPr _Pred, _IterCat _Cat)
 	{
 		_EXP_GENERIC_EXECUTION_POLICY(_Reduce_impl, _Policy, _First, _Last, _Init, _Pred, _Cat);
 	}
+
+	//
+	// transform_reduce
+	//
+	template <class _InIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	_Ty _Transform_reduce_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op, _IterCat)
+	{
+		_EXP_TRY
+			return transform_reduce(_First, _Last, _Unary_op, _Init, _Binary_op);
+		_EXP_RETHROW
+	}
+
+	template <class _ExPolicy, class _InIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	_Ty _Transform_reduce_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op, _IterCat)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		if (_First == _Last)
+			return _Init;
+
+		// There is not requirement for _Ty to be default constructible thus combinable needs to be initialized with _Init value
+		combinable<_Ty> _Combine([_Init]{ return _Init; });
+
+		// The transformed elements are folded as they are read, there is no intermediate range
+		_Partitioner<_ExecutionPolicy>::_For_Each(_First, std::distance(_First, _Last), std::make_pair(_Unary_op, _Binary_op),
+			[&_Combine](_InIt _Begin, size_t _Count, std::pair<_UnaryOp, _BinOp>& _UserOps) {
+			_Ty _Val = _Transform_reduce_helper<_ExecutionPolicy, _IterCat>::template Loop<_Ty>(_Begin, _Count, _UserOps.first, _UserOps.second);
+
+			bool _Exists;
+			auto &_Sum = _Combine.local(_Exists);
+			if (_Exists)
+				_Sum = _UserOps.second(_Sum, _Val);
+			else _Sum = _Val;
+		});
+
+		return _Binary_op(_Init, _Combine.combine(_Binary_op));
+	}
+
+	template <class _ExPolicy, class _InIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline typename _enable_if_parallel<_ExPolicy, _Ty>::type _Transform_reduce_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op, std::input_iterator_tag _Cat)
+	{
+		return _Transform_reduce_impl(seq, _First, _Last, _Unary_op, _Init, _Binary_op, _Cat);
+	}
+
+	template <class _InIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	_Ty _Transform_reduce_impl(const parallel_deterministic_execution_policy&, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op, _IterCat)
+	{
+		if (_First == _Last)
+			return _Init;
+
+		return _Deterministic_tree_reduce(_First, static_cast<size_t>(std::distance(_First, _Last)), _Init, _Binary_op,
+			[_Unary_op, _Binary_op](_InIt _Begin, size_t _Count) mutable {
+			return _Transform_reduce_helper<sequential_execution_policy, _IterCat>::template Loop<_Ty>(_Begin, _Count, _Unary_op, _Binary_op);
+		});
+	}
+
+	template <class _InIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline _Ty _Transform_reduce_impl(const parallel_deterministic_execution_policy&, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op, std::input_iterator_tag _Cat)
+	{
+		return _Transform_reduce_impl(seq, _First, _Last, _Unary_op, _Init, _Binary_op, _Cat);
+	}
+
+	template <class _InIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _Ty _Transform_reduce_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op, _IterCat _Cat)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Transform_reduce_impl, _Policy, _First, _Last, _Unary_op, _Init, _Binary_op, _Cat);
+	}
+
+	//
+	// reduce of array_view and strided_array_view
+	//
+
+	// Folds the elements of the outermost indices [_First, _First + _Count) in row-major order, there is one at least
+	template<class _ExPolicy, class _Ty, class _ValTy, int _Rank, class _BinPr>
+	_Ty _Reduce_view_loop(const _View_layout<_ValTy, _Rank>& _Layout, ptrdiff_t _First, ptrdiff_t _Count, _BinPr& _BinOp)
+	{
+		D4087::index<_Rank> _Start;
+		_Start[0] = _First;
+
+		// _Ty may not be default constructible, the fold starts with the first element
+		_Ty _Val = *_Layout._Row(_Start);
+		bool _First_row = true;
+
+		const ptrdiff_t _Inner_stride = _Layout._Stride[_Rank - 1];
+		auto _Row_fn = [&](const D4087::index<_Rank>& _Origin, ptrdiff_t _Length) {
+			_ValTy *_Ptr = _Layout._Row(_Origin);
+			if (_First_row)
+			{
+				_Ptr += _Inner_stride;
+				--_Length;
+				_First_row = false;
+			}
+
+			if (_Inner_stride == 1)
+			{
+				if (_Length > 0)
+					_Val = _BinOp(_Val, _Reduce_helper<_ExPolicy, std::random_access_iterator_tag>::template Loop<_Ty>(_Ptr, static_cast<size_t>(_Length), _BinOp));
+			}
+			else
+			{
+				for (ptrdiff_t _I = 0; _I < _Length; ++_I, _Ptr += _Inner_stride)
+					_Val = _BinOp(_Val, *_Ptr);
+			}
+		};
+
+		_For_each_view_row(_Layout._Bnd, _First, _Count, _Row_fn);
+		return _Val;
+	}
+
+	template <class _ValTy, int _Rank, class _Ty, class _BinPr>
+	_Ty _Reduce_view_impl(const sequential_execution_policy&, const _View_layout<_ValTy, _Rank>& _Layout, _Ty _Init, _BinPr _BinOp)
+	{
+		if (_Layout._Bnd.size() == 0)
+			return _Init;
+
+		_EXP_TRY
+			return _BinOp(_Init, _Reduce_view_loop<sequential_execution_policy, _Ty>(_Layout, 0, _Layout._Bnd[0], _BinOp));
+		_EXP_RETHROW
+	}
+
+	template <class _ExPolicy, class _ValTy, int _Rank, class _Ty, class _BinPr>
+	_Ty _Reduce_view_impl(const _ExPolicy&, const _View_layout<_ValTy, _Rank>& _Layout, _Ty _Init, _BinPr _BinOp)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		if (_Layout._Bnd.size() == 0)
+			return _Init;
+
+		combinable<_Ty> _Combine([_Init]{ return _Init; });
+
+		_For_each_view_part<_ExecutionPolicy>(_Layout._Bnd[0], _BinOp, [&_Combine, &_Layout](ptrdiff_t _First, ptrdiff_t _Count, _BinPr& _UserBinOp) {
+			_Ty _Val = _Reduce_view_loop<_ExecutionPolicy, _Ty>(_Layout, _First, _Count, _UserBinOp);
+
+			bool _Exists;
+			auto &_Sum = _Combine.local(_Exists);
+			if (_Exists)
+				_Sum = _UserBinOp(_Sum, _Val);
+			else _Sum = _Val;
+		});
+
+		return _BinOp(_Init, _Combine.combine(_BinOp));
+	}
+
+	// The leaves are runs of the outermost dimension holding about as many elements as the leaves of a range of the
+	// same size, they only depend on the bounds
+	template <class _ValTy, int _Rank, class _Ty, class _BinPr>
+	_Ty _Reduce_view_impl(const parallel_deterministic_execution_policy&, const _View_layout<_ValTy, _Rank>& _Layout, _Ty _Init, _BinPr _BinOp)
+	{
+		const size_t _Size = _Layout._Bnd.size();
+		if (_Size == 0)
+			return _Init;
+
+		const size_t _Units = static_cast<size_t>(_Layout._Bnd[0]), _Unit_size = _Size / _Units;
+		const size_t _Leaf_units = (_Deterministic_leaf_size(_Size) + _Unit_size - 1) / _Unit_size;
+
+		const D4087::bounds<1> _Unit_numbers(_Layout._Bnd[0]);
+		return _Deterministic_tree_reduce(_Unit_numbers.begin(), _Units, _Leaf_units, _Init, _BinOp,
+			[&_Layout, _BinOp](D4087::bounds_iterator<1> _Begin, size_t _Count) mutable {
+			return _Reduce_view_loop<sequential_execution_policy, _Ty>(_Layout, (*_Begin)[0], static_cast<ptrdiff_t>(_Count), _BinOp);
+		});
+	}
+
+	template <class _ValTy, int _Rank, class _Ty, class _BinPr>
+	inline _Ty _Reduce_view_impl(const execution_policy& _Policy, const _View_layout<_ValTy, _Rank>& _Layout, _Ty _Init, _BinPr _BinOp)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Reduce_view_impl, _Policy, _Layout, _Init, _BinOp);
+	}
 }  //details
 
-template <class _ExPolicy, class _InIt, class _Ty = std::iterator_traits<_InIt>::value_type, class _BinPr>
+template <class _ExPolicy, class _InIt, class _Ty = typename std::iterator_traits<_InIt>::value_type, class _BinPr>
 inline typename details::_enable_if_policy<_ExPolicy, _Ty>::type reduce(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _Ty _Init, _BinPr _BinOp)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 
-	return details::_Reduce_impl(_Policy, _First, _Last, _Init, _BinOp, std::_Iter_cat(_First));
+	return details::_Reduce_impl(_Policy, _First, _Last, _Init, _BinOp, details::_Iter_cat(_First));
 }
 
-template <class _ExPolicy, class _InIt, class _Ty = std::iterator_traits<_InIt>::value_type>
+template <class _ExPolicy, class _InIt, class _Ty = typename std::iterator_traits<_InIt>::value_type>
 inline typename details::_enable_if_policy<_ExPolicy, _Ty>::type reduce(_ExPolicy&& _Policy, _InIt _First, _InIt _Last)
 {
 	return reduce(_Policy, _First, _Last, _Ty{}, std::plus<>());
 }
 
-template <class _ExPolicy, class _InIt, class _Ty = std::iterator_traits<_InIt>::value_type>
+template <class _ExPolicy, class _InIt, class _Ty = typename std::iterator_traits<_InIt>::value_type>
 inline typename details::_enable_if_policy<_ExPolicy, _Ty>::type reduce(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _Ty _Init)
 {
 	return reduce(_Policy, _First, _Last, _Init, std::plus<>());
 }
+
+template <class _ExPolicy, class _InIt, class _UnaryOp, class _Ty, class _BinOp>
+inline typename details::_enable_if_policy<_ExPolicy, _Ty>::type transform_reduce(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op)
+{
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
+
+	return details::_Transform_reduce_impl(_Policy, _First, _Last, _Unary_op, _Init, _Binary_op, details::_Iter_cat(_First));
+}
+
+// Reduces _Transform_op(*(_First + i), *(_First2 + i)) with _Reduce_op, e.g. a dot product with the defaults
+template <class _ExPolicy, class _InIt, class _InIt2, class _Ty, class _BinOp, class _BinOp2>
+inline typename details::_enable_if_policy<_ExPolicy, _Ty>::type transform_reduce(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _InIt2 _First2, _Ty _Init, _BinOp _Reduce_op, _BinOp2 _Transform_op)
+{
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
+
+	typename details::common_iterator<_InIt, _InIt2>::iterator_category _Cat;
+	auto _Last2 = _First2; // composable_iterator compares the first iterator only
+
+	return details::_Transform_reduce_impl(_Policy, details::make_composable_iterator(_First, _First2), details::make_composable_iterator(_Last, _Last2),
+		details::_Zip_transform<_BinOp2>(_Transform_op), _Init, _Reduce_op, _Cat);
+}
+
+template <class _ExPolicy, class _InIt, class _InIt2, class _Ty>
+inline typename details::_enable_if_policy<_ExPolicy, _Ty>::type transform_reduce(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _InIt2 _First2, _Ty _Init)
+{
+	return transform_reduce(_Policy, _First, _Last, _First2, _Init, std::plus<>(), std::multiplies<>());
+}
+
+// Reduces the elements of the array_view or strided_array_view _Vw
+template <class _ExPolicy, class _View, class _Ty, class _BinPr>
+inline typename details::_enable_if_view<_ExPolicy, _View, _Ty>::type reduce(_ExPolicy&& _Policy, const _View& _Vw, _Ty _Init, _BinPr _BinOp)
+{
+	return details::_Reduce_view_impl(_Policy, details::_Make_view_layout(_Vw), _Init, _BinOp);
+}
+
+template <class _ExPolicy, class _View, class _Ty>
+inline typename details::_enable_if_view<_ExPolicy, _View, _Ty>::type reduce(_ExPolicy&& _Policy, const _View& _Vw, _Ty _Init)
+{
+	return reduce(_Policy, _Vw, _Init, std::plus<>());
+}
+
+template <class _ExPolicy, class _View>
+inline typename details::_enable_if_view<_ExPolicy, _View, typename std::remove_cv<typename _View::value_type>::type>::type reduce(_ExPolicy&& _Policy, const _View& _Vw)
+{
+	return reduce(_Policy, _Vw, typename std::remove_cv<typename _View::value_type>::type{}, std::plus<>());
+}
 _PSTL_NS1_END // std::experimental::parallel
 
 #endif // _IMPL_REDUCE_H_
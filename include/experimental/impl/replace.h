@@ -25,7 +25,7 @@ namespace details {
 			[_Pred, &_New](typename std::iterator_traits<_FwdIt>::reference _El){
 			if (_Pred(_El))
 				_El = _New;
-		}, std::_Iter_cat(_First));
+		}, details::_Iter_cat(_First));
 	}
 
 	template <class _FwdIt, class _Pr, class _Ty>
@@ -139,9 +139,9 @@ template <class _ExPolicy, class _InIt, class _OutIt, class _Pr, class _Ty>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type replace_copy_if(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _Pr _Pred, const _Ty& _New)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
 	return details::_Replace_copy_if_impl(_Policy, _First, _Last, _Dest, _Pred, _New, _Cat);
 }
 
@@ -149,9 +149,9 @@ template <class _ExPolicy, class _InIt, class _OutIt, class _Ty>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type replace_copy(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, const _Ty& _Old, const _Ty& _New)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
 	return details::_Replace_copy_impl(_Policy, _First, _Last, _Dest, _Old, _New, _Cat);
 }
 _PSTL_NS1_END // std::experimental::parallel
@@ -62,13 +62,13 @@ namespace details {
 		std::get<1>(*_For_each_n_impl(_Policy, make_composable_iterator(_First, _Rev_last), _Count / 2,
 			[](typename composable_iterator<_BidIt, std::reverse_iterator<_BidIt> >::reference _It){
 			swap(*std::get<0>(_It), *std::get<1>(_It));
-		}, std::_Iter_cat(_First)));
+		}, details::_Iter_cat(_First)));
 	}
 
-	template <class _BidIt, class _IterTag>
+	template <class _BidIt>
 	void _Reverse_impl(const execution_policy& _Policy, _BidIt _First, _BidIt _Last)
 	{
-		_EXP_GENERIC_EXECUTION_POLICY(_Lexicographical_compare_impl, _Policy, _First, _Last, _Cat);
+		_EXP_GENERIC_EXECUTION_POLICY(_Reverse_impl, _Policy, _First, _Last);
 	}
 } // details
 
@@ -76,9 +76,9 @@ template <class _ExPolicy, class _BidIt, class _OutIt>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type reverse_copy(_ExPolicy&& _Policy, _BidIt _First, _BidIt _Last, _OutIt _Dest)
 {
 	static_assert(std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<_BidIt>::iterator_category>::value, "Required bidirectional iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_BidIt, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_BidIt, _OutIt>::iterator_category _Cat;
 	return details::_Reverse_copy_impl(_Policy, _First, _Last, _Dest, _Cat);
 }
 template <class _ExPolicy, class _BidIt>
@@ -89,16 +89,16 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type rotate(_ExPo
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Rotate_impl(_Policy, _First, _Mid, _Last, std::_Iter_cat(_First));
+	return details::_Rotate_impl(_Policy, _First, _Mid, _Last, details::_Iter_cat(_First));
 }
 
 template <class _ExPolicy, class _FwdIt, class _OutIt>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type rotate_copy(_ExPolicy&& _Policy, _FwdIt _First, _FwdIt _Mid, _FwdIt _Last, _OutIt _Dest)
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_FwdIt, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_FwdIt, _OutIt>::iterator_category _Cat;
 	return details::_Rotate_copy_impl(_Policy, _First, _Mid, _Last, _Dest, _Cat);
 }
 _PSTL_NS1_END // std::experimental::parallel
@@ -8,7 +8,17 @@
 _PSTL_NS1_BEGIN
 namespace details {
 
-	template<typename _OutIt, typename _InitType, typename _BinOp>
+	// Transform of the plain scans
+	struct _Scan_identity
+	{
+		template<typename _Ty>
+		_Ty&& operator()(_Ty&& _Val) const
+		{
+			return std::forward<_Ty>(_Val);
+		}
+	};
+
+	template<typename _OutIt, typename _InitType, typename _BinOp, typename _UnaryOp = _Scan_identity>
 	class _Output_scan_token
 	{
 		typedef typename std::iterator_traits<_OutIt>::difference_type _DiffType;
@@ -18,8 +28,9 @@ namespace details {
 		_InitType _Local_sum;
 		_InitType _Partial_sum;
 		_BinOp _BinOperation;
+		_UnaryOp _UnaryOperation;
 	public:
-		_Output_scan_token(_OutIt _It, _InitType _Sum, _BinOp _Op) : _Begin(_It), _Iter_pos(0), _Partial_sum(_Sum), _BinOperation(_Op)
+		_Output_scan_token(_OutIt _It, _InitType _Sum, _BinOp _Op, _UnaryOp _Transform = _UnaryOp()) : _Begin(_It), _Iter_pos(0), _Partial_sum(_Sum), _BinOperation(_Op), _UnaryOperation(_Transform)
 		{
 		}
 
@@ -45,6 +56,11 @@ namespace details {
 			return _BinOperation;
 		}
 
+		_UnaryOp get_transform() const
+		{
+			return _UnaryOperation;
+		}
+
 		_OutIt get_result() const
 		{
 			_OutIt _Out = _Begin;
@@ -56,17 +72,18 @@ namespace details {
 		void filter(_InIt _Begin, size_t _Partition_count)
 		{
 			auto _Opration = get_operation();
-			_InitType _Val = *_Begin;
+			auto _Transform = get_transform();
+			_InitType _Val = _Transform(*_Begin);
 
 			LoopHelper<_ExPolicy, _InIt>::Loop(++_Begin, _Partition_count - 1,
-				[&_Opration, &_Val](std::iterator_traits<_InIt>::reference _It) {
-				_Val = _Opration(_Val, _It);
+				[&_Opration, &_Transform, &_Val](typename std::iterator_traits<_InIt>::reference _It) {
+				_Val = _Opration(_Val, _Transform(_It));
 			});
 
 			set(_Partition_count, _Val);
 		}
 
-		template <typename _It, typename _OutIt, typename _First_stage, typename _Second_stage> friend class _Copy_chore;
+		template <typename _It, typename _OutToken, typename _First_stage, typename _Second_stage> friend class _Copy_chore;
 	public:
 		void move(_Output_scan_token& _Token)
 		{
@@ -81,92 +98,297 @@ namespace details {
 		}
 	};
 
+	// Single pass scan with decoupled look-back. The range is cut in tiles small enough to stay in cache,
+	// workers claim tiles in order, publish the tile aggregate, then walk back over the predecessors until
+	// one of them has its inclusive prefix. The second pass over a tile reads from cache, so the input
+	// is streamed from memory once instead of twice as with the copy partitioner.
+	// A tile only waits on tiles with a lower index that are already claimed by a running worker, so the
+	// walk back always terminates at tile 0 at the latest.
+	const size_t _Lookback_tile_bytes = 32 * 1024;
+	const size_t _Lookback_min_tile_size = 256;
+	const unsigned int _Lookback_spin_count = 64;
+
+#pragma warning(push)
+#pragma warning(disable: 4324) // structure was padded due to __declspec(align())
+	template<typename _Ty>
+	struct _EXP_ALIGN(64) _Lookback_tile_status
+	{
+		enum _Tile_state {
+			_Empty = 0,
+			_Aggregate_ready = 1,
+			_Prefix_ready = 2
+		};
+
+		std::atomic<int> _State;
+		_Ty _Aggregate;
+		_Ty _Inclusive_prefix;
+
+		_Lookback_tile_status() : _State(_Empty)
+		{
+		}
+	};
+#pragma warning(pop) // C4324
+
+	template<typename _ExPolicy, bool _Inclusive, typename _InIt, typename _OutIt, typename _UnaryOp, typename _Ty, typename _BinOp>
+	class _Lookback_scan
+	{
+		typedef _Lookback_tile_status<_Ty> _Status;
+
+		_InIt _First;
+		_OutIt _Dest;
+		size_t _Count;
+		size_t _Tile_size;
+		size_t _Tile_count;
+		_UnaryOp _Unary_op;
+		_Ty _Init;
+		_BinOp _Op;
+		std::unique_ptr<_Status[]> _Tiles;
+		std::atomic<size_t> _Next_tile;
+		std::atomic<bool> _Cancelled;
+
+		_Lookback_scan& operator=(const _Lookback_scan&);
+
+		template<typename _Val>
+		static void _Scan_step(_OutIt& _Out, _Ty& _Prefix, _BinOp& _Opration, _Val&& _Value, std::false_type)
+		{
+			*_Out = _Prefix;
+			_Prefix = _Opration(_Prefix, std::forward<_Val>(_Value));
+		}
+
+		template<typename _Val>
+		static void _Scan_step(_OutIt& _Out, _Ty& _Prefix, _BinOp& _Opration, _Val&& _Value, std::true_type)
+		{
+			_Prefix = _Opration(_Prefix, std::forward<_Val>(_Value));
+			*_Out = _Prefix;
+		}
+
+		// Returns false if the scan was cancelled by an exception on another tile
+		bool _Look_back(size_t _Tile, _Ty& _Prefix)
+		{
+			bool _Has_suffix = false;
+
+			for (size_t _Pred = _Tile; _Pred-- > 0;) {
+				_Status& _Pred_status = _Tiles[_Pred];
+
+				int _State;
+				for (unsigned int _Spin = 0; (_State = _Pred_status._State.load(std::memory_order_acquire)) == _Status::_Empty; ++_Spin) {
+					if (_Cancelled.load(std::memory_order_relaxed))
+						return false;
+
+					if (_Spin >= _Lookback_spin_count)
+						yield();
+				}
+
+				if (_State == _Status::_Prefix_ready) {
+					_Prefix = _Has_suffix ? _Op(_Pred_status._Inclusive_prefix, _Prefix) : _Pred_status._Inclusive_prefix;
+					return true;
+				}
+
+				_Prefix = _Has_suffix ? _Op(_Pred_status._Aggregate, _Prefix) : _Pred_status._Aggregate;
+				_Has_suffix = true;
+			}
+
+			_ASSERT(false); // tile 0 always publishes its prefix
+			return false;
+		}
+
+		bool _Scan_tile(size_t _Tile)
+		{
+			const size_t _Offset = _Tile * _Tile_size;
+			const size_t _Size = (std::min)(_Tile_size, _Count - _Offset);
+			_Status& _Status_ref = _Tiles[_Tile];
+			auto _Unary = _Unary_op;
+			auto _Opration = _Op;
+
+			_InIt _Begin = _First;
+			std::advance(_Begin, _Offset);
+			_OutIt _Out = _Dest;
+			std::advance(_Out, _Offset);
+
+			// Pass 1: tile aggregate, brings the tile into cache
+			_Ty _Aggregate = _Unary(*_Begin);
+			LoopHelper<_ExPolicy, _InIt>::Loop(std::next(_Begin), _Size - 1,
+				[&_Opration, &_Unary, &_Aggregate](typename std::iterator_traits<_InIt>::reference _It) {
+				_Aggregate = _Opration(_Aggregate, _Unary(_It));
+			});
+
+			_Ty _Prefix = _Init;
+			if (_Tile != 0) {
+				_Status_ref._Aggregate = _Aggregate;
+				_Status_ref._State.store(_Status::_Aggregate_ready, std::memory_order_release);
+
+				if (!_Look_back(_Tile, _Prefix))
+					return false;
+			}
+
+			_Status_ref._Inclusive_prefix = _Opration(_Prefix, _Aggregate);
+			_Status_ref._State.store(_Status::_Prefix_ready, std::memory_order_release);
+
+			// Pass 2: output, the input is read from cache
+			LoopHelper<_ExPolicy, _InIt>::Loop(_Begin, _Size,
+				[&_Opration, &_Unary, &_Prefix, &_Out](typename std::iterator_traits<_InIt>::reference _It) {
+				_Scan_step(_Out, _Prefix, _Opration, _Unary(_It), std::integral_constant<bool, _Inclusive>());
+				++_Out;
+			});
+
+			return true;
+		}
+
+		void _Worker()
+		{
+			for (;;) {
+				if (_Cancelled.load(std::memory_order_relaxed))
+					return;
+
+				const size_t _Tile = _Next_tile.fetch_add(1, std::memory_order_relaxed);
+				if (_Tile >= _Tile_count)
+					return;
+
+				try {
+					if (!_Scan_tile(_Tile))
+						return;
+				}
+				catch (...) {
+					// Successors spinning on this tile would never see it published
+					_Cancelled.store(true, std::memory_order_relaxed);
+					throw;
+				}
+			}
+		}
+	public:
+		_Lookback_scan(_InIt _F, size_t _N, _OutIt _D, _UnaryOp _Unary, _Ty _I, _BinOp _Binary) :
+			_First(_F), _Dest(_D), _Count(_N), _Unary_op(_Unary), _Init(_I), _Op(_Binary), _Next_tile(0), _Cancelled(false)
+		{
+			_Tile_size = (std::max)(_Lookback_tile_bytes / sizeof(typename std::iterator_traits<_InIt>::value_type), _Lookback_min_tile_size);
+			_Tile_count = (_Count + _Tile_size - 1) / _Tile_size;
+			_Tiles.reset(new _Status[_Tile_count]);
+		}
+
+		_OutIt run()
+		{
+			const size_t _Workers = (std::min)(static_cast<size_t>(get_hardware_concurrency()), _Tile_count);
+
+			// Every chore runs a claim loop, the chore range only sets how many of them there are
+			_Partitioner<static_partitioner_tag>::_For_Each(_First, _Workers, this, [](_InIt, size_t, _Lookback_scan *_Scan) {
+				_Scan->_Worker();
+			}, 1);
+
+			_OutIt _Result = _Dest;
+			std::advance(_Result, _Count);
+			return _Result;
+		}
+	};
+
+	// The look-back engine needs cheap random access to both ranges and is only worth it when the input
+	// is laid out contiguously, otherwise the two stage copy partitioner is used
+	template<typename _InIt, typename _OutIt>
+	struct _Use_lookback_scan : std::integral_constant<bool,
+		(std::is_pointer<_InIt>::value || _Contiguous_container_iterator_traits<_InIt>::value) &&
+		std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value>
+	{
+	};
+
+	template<typename _ExPolicy, bool _Inclusive, typename _InIt, typename _OutIt, typename _UnaryOp, typename _Ty, typename _BinOp>
+	inline _OutIt _Lookback_scan_impl(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op)
+	{
+		return _Lookback_scan<_ExPolicy, _Inclusive, _InIt, _OutIt, _UnaryOp, _Ty, _BinOp>(_First, std::distance(_First, _Last), _Dest, _Unary_op, _Init, _Op).run();
+	}
+
 	//
-	// exclusive_scan
+	// transform_exclusive_scan, exclusive_scan is the transform with _Scan_identity
 	//
-	template<class _InIt, class _OutIt, class _Ty, class _BinOp, class _IterCat>
-	inline _OutIt _Exclusive_scan_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, _IterCat)
+	template<class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_exclusive_scan_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, _IterCat)
 	{
 		_EXP_TRY
-			return exclusive_scan(_First, _Last, _Dest, _Init, _Op);
+			return transform_exclusive_scan(_First, _Last, _Dest, _Unary_op, _Init, _Op);
 		_EXP_RETHROW
 	}
 
-	template<class _ExPolicy, class _InIt, class _OutIt, class _Ty, class _BinOp, class _IterCat>
-	inline _OutIt _Exclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, _IterCat)
+	// Two stage engine: filter computes the partition sums, the copy stage reads the input again to write the output
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline _OutIt _Exclusive_scan_engine(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, std::false_type)
 	{
-		typedef std::iterator_traits<_InIt>::difference_type difference_type;
-		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
-		typedef _Output_scan_token<_OutIt, _Ty, _BinOp> _Output_token;
-
-		if (_First == _Last)
-			return _Dest;
+		typedef _Output_scan_token<_OutIt, _Ty, _BinOp, _UnaryOp> _Output_token;
 
-		return _Partitioner<copy_partitioner_tag>::_For_Each(_First, std::distance(_First, _Last), _Output_token(_Dest, _Init, _Op),
+		return _Partitioner<copy_partitioner_tag>::_For_Each(_First, std::distance(_First, _Last), _Output_token(_Dest, _Init, _Op, _Unary_op),
 			[](_InIt _Begin, size_t _Partition_count, _Output_token& _Output){
-			_Output.filter<_ExPolicy>(_Begin, _Partition_count);
+			_Output.template filter<_ExPolicy>(_Begin, _Partition_count);
 		},
 			[](_InIt _Begin, size_t _Partition_count, _Output_token& _Dest) { // Copy stage						
 			auto _Opration = _Dest.get_operation();
+			auto _Transform = _Dest.get_transform();
 			auto _Out = _Dest.get();
 			_Ty _Val = _Dest.get_sum();
 
 			LoopHelper<_ExPolicy, _InIt>::Loop(_Begin, _Partition_count,
-				[&_Out, &_Val, &_Opration](std::iterator_traits<_InIt>::reference _It) {
+				[&_Out, &_Val, &_Opration, &_Transform](typename std::iterator_traits<_InIt>::reference _It) {
 				*_Out = _Val;
 				++_Out;
 
-				_Val = _Opration(_Val, _It);
+				_Val = _Opration(_Val, _Transform(_It));
 			});
 		}).get_result();
 	}
 
-	template<class _ExPolicy, class _InIt, class _OutIt, class _Ty, class _BinOp>
-	inline typename _enable_if_parallel<_ExPolicy, _OutIt>::type _Exclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, std::input_iterator_tag _Cat)
+	// Single pass engine, see _Lookback_scan
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline _OutIt _Exclusive_scan_engine(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, std::true_type)
+	{
+		return _Lookback_scan_impl<_ExPolicy, false>(_First, _Last, _Dest, _Unary_op, _Init, _Op);
+	}
+
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_exclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, _IterCat)
+	{
+		if (_First == _Last)
+			return _Dest;
+
+		return _Exclusive_scan_engine<_ExPolicy>(_First, _Last, _Dest, _Unary_op, _Init, _Op, _Use_lookback_scan<_InIt, _OutIt>());
+	}
+
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline typename _enable_if_parallel<_ExPolicy, _OutIt>::type _Transform_exclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, std::input_iterator_tag _Cat)
 	{
-		return _Exclusive_scan_impl(seq, _First, _Last, _Dest, _Init, _Op, _Cat);
+		return _Transform_exclusive_scan_impl(seq, _First, _Last, _Dest, _Unary_op, _Init, _Op, _Cat);
 	}
 
-	template<class _InIt, class _OutIt, class _Ty, class _BinOp, class _IterCat>
-	inline _OutIt _Exclusive_scan_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, _IterCat _Cat)
+	template<class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_exclusive_scan_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, _IterCat _Cat)
 	{
-		_EXP_GENERIC_EXECUTION_POLICY(_Exclusive_scan_impl, _Policy, _First, _Last, _Dest, _Init, _Op, _Cat);
+		_EXP_GENERIC_EXECUTION_POLICY(_Transform_exclusive_scan_impl, _Policy, _First, _Last, _Dest, _Unary_op, _Init, _Op, _Cat);
 	}
 
 	//
-	// inclusive_scan
+	// transform_inclusive_scan, inclusive_scan is the transform with _Scan_identity
 	//
-	template<class _InIt, class _OutIt, class _Ty, class _BinOp, class _IterCat>
-	inline _OutIt _Inclusive_scan_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, _IterCat)
+	template<class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_inclusive_scan_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, _IterCat)
 	{
 		_EXP_TRY
-			return inclusive_scan(_First, _Last, _Dest, _Op, _Init);
+			return transform_inclusive_scan(_First, _Last, _Dest, _Unary_op, _Op, _Init);
 		_EXP_RETHROW
 	}
 
-	template<class _ExPolicy, class _InIt, class _OutIt, class _Ty, class _BinOp, class _IterCat>
-	inline _OutIt _Inclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, _IterCat)
+	// Two stage engine: filter computes the partition sums, the copy stage reads the input again to write the output
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline _OutIt _Inclusive_scan_engine(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, std::false_type)
 	{
-		typedef std::iterator_traits<_InIt>::difference_type difference_type;
-		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
-		typedef composable_iterator<_InIt, std::vector<difference_type>::iterator > _Iter_type;
-		typedef _Output_scan_token<_OutIt, _Ty, _BinOp> _Output_token;
+		typedef _Output_scan_token<_OutIt, _Ty, _BinOp, _UnaryOp> _Output_token;
 
-		if (_First == _Last)
-			return _Dest;
-
-		return _Partitioner<copy_partitioner_tag>::_For_Each(_First, std::distance(_First, _Last), _Output_token(_Dest, _Init, _Op),
+		return _Partitioner<copy_partitioner_tag>::_For_Each(_First, std::distance(_First, _Last), _Output_token(_Dest, _Init, _Op, _Unary_op),
 			[](_InIt _Begin, size_t _Partition_count, _Output_token& _Output) { // Filtering stage						
-			_Output.filter<_ExPolicy>(_Begin, _Partition_count);
+			_Output.template filter<_ExPolicy>(_Begin, _Partition_count);
 		},
 			[](_InIt _Begin, size_t _Partition_count, _Output_token& _Dest) { // Copy stage						
 			auto _Opration = _Dest.get_operation();
+			auto _Transform = _Dest.get_transform();
 			auto _Out = _Dest.get();
 			_Ty _Val = _Dest.get_sum();
 
 			LoopHelper<_ExPolicy, _InIt>::Loop(_Begin, _Partition_count,
-				[&_Out, &_Val, &_Opration](std::iterator_traits<_InIt>::reference _It){
-				_Val = _Opration(_Val, _It);
+				[&_Out, &_Val, &_Opration, &_Transform](typename std::iterator_traits<_InIt>::reference _It){
+				_Val = _Opration(_Val, _Transform(_It));
 
 				*_Out = _Val;
 				++_Out;
@@ -174,16 +396,51 @@ namespace details {
 		}).get_result();
 	}
 
-	template<class _ExPolicy, class _InIt, class _OutIt, class _Ty, class _BinOp>
-	inline typename _enable_if_parallel<_ExPolicy, _OutIt>::type _Inclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, std::input_iterator_tag _Cat)
+	// Single pass engine, see _Lookback_scan
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline _OutIt _Inclusive_scan_engine(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, std::true_type)
+	{
+		return _Lookback_scan_impl<_ExPolicy, true>(_First, _Last, _Dest, _Unary_op, _Init, _Op);
+	}
+
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_inclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, _IterCat)
+	{
+		if (_First == _Last)
+			return _Dest;
+
+		return _Inclusive_scan_engine<_ExPolicy>(_First, _Last, _Dest, _Unary_op, _Init, _Op, _Use_lookback_scan<_InIt, _OutIt>());
+	}
+
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+	inline typename _enable_if_parallel<_ExPolicy, _OutIt>::type _Transform_inclusive_scan_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, std::input_iterator_tag _Cat)
+	{
+		return _Transform_inclusive_scan_impl(seq, _First, _Last, _Dest, _Unary_op, _Init, _Op, _Cat);
+	}
+
+	template<class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_inclusive_scan_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Op, _IterCat _Cat)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Transform_inclusive_scan_impl, _Policy, _First, _Last, _Dest, _Unary_op, _Init, _Op, _Cat);
+	}
+
+	// Without an init the first transformed element starts the sum, a value initialized one is no neutral element of e.g. multiplies or max
+	template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_inclusive_scan_impl(const _ExPolicy& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _BinOp _Op, _IterCat _Cat)
 	{
-		return _Inclusive_scan_impl(seq, _First, _Last, _Dest, _Init, _Op, _Cat);
+		if (_First == _Last)
+			return _Dest;
+
+		typename std::decay<decltype(_Unary_op(*_First))>::type _Val = _Unary_op(*_First);
+		*_Dest = _Val;
+
+		return _Transform_inclusive_scan_impl(_Policy, ++_First, _Last, ++_Dest, _Unary_op, _Val, _Op, _Cat);
 	}
 
-	template<class _InIt, class _OutIt, class _Ty, class _BinOp, class _IterCat>
-	inline _OutIt _Inclusive_scan_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op, _IterCat _Cat)
+	template<class _InIt, class _OutIt, class _UnaryOp, class _BinOp, class _IterCat>
+	inline _OutIt _Transform_inclusive_scan_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _BinOp _Op, _IterCat _Cat)
 	{
-		_EXP_GENERIC_EXECUTION_POLICY(_Inclusive_scan_impl, _Policy, _First, _Last, _Dest, _Init, _Op, _Cat);
+		_EXP_GENERIC_EXECUTION_POLICY(_Transform_inclusive_scan_impl, _Policy, _First, _Last, _Dest, _Unary_op, _Op, _Cat);
 	}
 } // details
 
@@ -191,10 +448,10 @@ template<class _ExPolicy, class _InIt, class _OutIt, class _Ty, class _BinOp>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type exclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init, _BinOp _Op)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
-	return details::_Exclusive_scan_impl(_Policy, _First, _Last, _Dest, _Init, _Op, _Cat);
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	return details::_Transform_exclusive_scan_impl(_Policy, _First, _Last, _Dest, details::_Scan_identity(), _Init, _Op, _Cat);
 }
 
 template<class _ExPolicy, class _InIt, class _OutIt, class _Ty>
@@ -207,22 +464,56 @@ template<class _ExPolicy, class _InIt, class _OutIt, class _Ty, class _BinOp>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type inclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _BinOp _Op, _Ty _Init)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
-	return details::_Inclusive_scan_impl(_Policy, _First, _Last, _Dest, _Init, _Op, _Cat);
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	return details::_Transform_inclusive_scan_impl(_Policy, _First, _Last, _Dest, details::_Scan_identity(), _Init, _Op, _Cat);
 }
 
 template<class _ExPolicy, class _InIt, class _OutIt, class _BinOp>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type inclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _BinOp _Op)
 {
-	return inclusive_scan(_Policy, _First, _Last, _Dest, _Op, std::iterator_traits<_InIt>::value_type{});
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
+
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	return details::_Transform_inclusive_scan_impl(_Policy, _First, _Last, _Dest, details::_Scan_identity(), _Op, _Cat);
 }
 
 template<class _ExPolicy, class _InIt, class _OutIt>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type inclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest)
 {
-	return inclusive_scan(_Policy, _First, _Last, _Dest, std::plus<>(), std::iterator_traits<_InIt>::value_type{});
+	return inclusive_scan(_Policy, _First, _Last, _Dest, std::plus<>());
+}
+
+template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type transform_exclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op)
+{
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
+
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	return details::_Transform_exclusive_scan_impl(_Policy, _First, _Last, _Dest, _Unary_op, _Init, _Binary_op, _Cat);
+}
+
+template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _BinOp, class _Ty>
+inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type transform_inclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _BinOp _Binary_op, _Ty _Init)
+{
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
+
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	return details::_Transform_inclusive_scan_impl(_Policy, _First, _Last, _Dest, _Unary_op, _Init, _Binary_op, _Cat);
+}
+
+template<class _ExPolicy, class _InIt, class _OutIt, class _UnaryOp, class _BinOp>
+inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type transform_inclusive_scan(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _BinOp _Binary_op)
+{
+	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
+
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	return details::_Transform_inclusive_scan_impl(_Policy, _First, _Last, _Dest, _Unary_op, _Binary_op, _Cat);
 }
 _PSTL_NS1_END // std::experimental::parallel
 
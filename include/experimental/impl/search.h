@@ -165,7 +165,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type search(_ExPo
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt2>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::common_iterator<_FwdIt, _FwdIt2>::iterator_category _Cat;
+	typename details::common_iterator<_FwdIt, _FwdIt2>::iterator_category _Cat;
 	return details::_Search_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, _Cat);
 }
 
@@ -180,7 +180,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type search_n(_Ex
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Search_impl_n(_Policy, _First, _Last, _Count, _Val, _Pred, std::_Iter_cat(_First));
+	return details::_Search_impl_n(_Policy, _First, _Last, _Count, _Val, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _FwdIt, class _Diff, class _Ty>
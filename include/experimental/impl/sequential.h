@@ -17,13 +17,13 @@ inline _InIt for_each_n(_InIt _First, _Diff _Count, _Pr _Pred)
 }
 
 template <class _InIt, class _Ty, class _BinOp>
-inline typename _Ty reduce(_InIt _First, _InIt _Last, _Ty _Init, _BinOp _Op)
+inline _Ty reduce(_InIt _First, _InIt _Last, _Ty _Init, _BinOp _Op)
 {
 	return std::accumulate(_First, _Last, _Init, _Op);
 }
 
-template <class _InIt, class _Ty = std::iterator_traits<_InIt>::value_type>
-inline typename _Ty reduce(_InIt _First, _InIt _Last, _Ty _Init)
+template <class _InIt, class _Ty = typename std::iterator_traits<_InIt>::value_type>
+inline _Ty reduce(_InIt _First, _InIt _Last, _Ty _Init)
 {
 	return std::accumulate(_First, _Last, _Init, std::plus<>());
 }
@@ -31,7 +31,28 @@ inline typename _Ty reduce(_InIt _First, _InIt _Last, _Ty _Init)
 template <class _InIt>
 inline typename std::iterator_traits<_InIt>::value_type reduce(_InIt _First, _InIt _Last)
 {
-	return std::accumulate(_First, _Last, std::iterator_traits<_InIt>::value_type{}, std::plus<>());
+	return std::accumulate(_First, _Last, typename std::iterator_traits<_InIt>::value_type{}, std::plus<>());
+}
+
+template<class _InIt, class _UnaryOp, class _Ty, class _BinOp>
+inline _Ty transform_reduce(_InIt _First, _InIt _Last, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op)
+{
+	for (; _First != _Last; ++_First)
+		_Init = _Binary_op(_Init, _Unary_op(*_First));
+
+	return _Init;
+}
+
+template<class _InIt, class _InIt2, class _Ty, class _BinOp, class _BinOp2>
+inline _Ty transform_reduce(_InIt _First, _InIt _Last, _InIt2 _First2, _Ty _Init, _BinOp _Reduce_op, _BinOp2 _Transform_op)
+{
+	return std::inner_product(_First, _Last, _First2, _Init, _Reduce_op, _Transform_op);
+}
+
+template<class _InIt, class _InIt2, class _Ty>
+inline _Ty transform_reduce(_InIt _First, _InIt _Last, _InIt2 _First2, _Ty _Init)
+{
+	return std::inner_product(_First, _Last, _First2, _Init);
 }
 
 template<class _InIt, class _OutIt, class _Ty, class _BinOp>
@@ -52,6 +73,17 @@ inline _OutIt exclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _Ty _Init)
 }
 
 
+template<class _InIt, class _OutIt, class _UnaryOp, class _Ty, class _BinOp>
+inline _OutIt transform_exclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _Ty _Init, _BinOp _Binary_op)
+{
+	for (; _First != _Last; ++_First, ++_Dest) {
+		*_Dest = _Init;
+		_Init = _Binary_op(_Init, _Unary_op(*_First));
+	}
+
+	return _Dest;
+}
+
 template<class _InIt, class _OutIt, class _BinOp, class _Ty>
 inline _OutIt inclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _BinOp _Op, _Ty _Init)
 {
@@ -63,16 +95,46 @@ inline _OutIt inclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _BinOp _Op
 	return _Dest;
 }
 
-template<class _InIt, class _OutIt, class _BinOp = std::plus<_Ty>>
+template<class _InIt, class _OutIt, class _BinOp>
 inline _OutIt inclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _BinOp _Op)
 {
-	return inclusive_scan(_First, _Last, _Dest, _Op(), std::iterator_traits<_InIt>::value_type{});
+	if (_First == _Last)
+		return _Dest;
+
+	typename std::iterator_traits<_InIt>::value_type _Val = *_First;
+	*_Dest = _Val;
+
+	return inclusive_scan(++_First, _Last, ++_Dest, _Op, _Val);
 }
 
 template<class _InIt, class _OutIt>
 inline _OutIt inclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest)
 {
-	return inclusive_scan(_First, _Last, _Dest, std::plus<>(), std::iterator_traits<_InIt>::value_type{});
+	return inclusive_scan(_First, _Last, _Dest, std::plus<>(), typename std::iterator_traits<_InIt>::value_type{});
+}
+
+template<class _InIt, class _OutIt, class _UnaryOp, class _BinOp, class _Ty>
+inline _OutIt transform_inclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _BinOp _Binary_op, _Ty _Init)
+{
+	for (; _First != _Last; ++_First, ++_Dest) {
+		_Init = _Binary_op(_Init, _Unary_op(*_First));
+		*_Dest = _Init;
+	}
+
+	return _Dest;
+}
+
+template<class _InIt, class _OutIt, class _UnaryOp, class _BinOp>
+inline _OutIt transform_inclusive_scan(_InIt _First, _InIt _Last, _OutIt _Dest, _UnaryOp _Unary_op, _BinOp _Binary_op)
+{
+	if (_First == _Last)
+		return _Dest;
+
+	// The first transformed element starts the sum, no need for a neutral element
+	auto _Val = _Unary_op(*_First);
+	*_Dest = _Val;
+
+	return transform_inclusive_scan(++_First, _Last, ++_Dest, _Unary_op, _Binary_op, _Val);
 }
 _PSTL_NS1_END // std::experimental::parallel
 
@@ -6,6 +6,7 @@
 #include "algorithm_impl.h"
 #include "foreach.h"
 #include "copy.h"
+#include "merge.h"
 #include <vector>
 #include <algorithm>
 #include <numeric>
@@ -14,106 +15,155 @@
 _PSTL_NS1_BEGIN
 namespace details
 {
-	struct _SplitedChunk
+	// Output iterator only counting the elements written through it
+	class _Counting_output_iterator : public std::iterator<std::output_iterator_tag, void, void, void, void>
 	{
-		size_t _Start, _Len, _Accumulated;
-	};
-
-	template <typename _T>
-	class _NullablePointerWrapper
-	{
-		const _T * _M_Item;
+		size_t _Count;
 
 	public:
-		_NullablePointerWrapper()
+		_Counting_output_iterator() : _Count(0)
+		{
+		}
+
+		template <typename _Ty>
+		_Counting_output_iterator & operator =(const _Ty &)
 		{
-			_M_Item = nullptr;
+			return *this;
+		}
+
+		_Counting_output_iterator & operator *()
+		{
+			return *this;
 		}
 
-		_NullablePointerWrapper(const _T &_Item)
+		_Counting_output_iterator & operator ++()
 		{
-			_M_Item = &_Item;
+			++_Count;
+			return *this;
 		}
 
-		_NullablePointerWrapper & operator =(const _T &_Item)
+		_Counting_output_iterator & operator ++(int)
 		{
-			_M_Item = &_Item;
+			++_Count;
 			return *this;
 		}
 
-		operator const _T &() const
+		size_t count() const
 		{
-			_ASSERT(_M_Item != nullptr);
-			return *_M_Item;
+			return _Count;
 		}
 	};
 
-	template <typename OutItr>
-	struct SetOperationBuffer
+	struct _Set_union_op
 	{
-		typedef typename std::iterator_traits<OutItr>::value_type ValueType;
+		template <typename _InIt1, typename _InIt2, typename _OutIt, typename _Comp>
+		_OutIt operator()(_InIt1 _First1, _InIt1 _Last1, _InIt2 _First2, _InIt2 _Last2, _OutIt _Dest, _Comp& _Cmp) const
+		{
+			return std::set_union(_First1, _Last1, _First2, _Last2, _Dest, _Cmp);
+		}
+	};
 
-		static _NullablePointerWrapper<ValueType> notUseWrapper(std::false_type);
-		static typename ValueType notUseWrapper(std::true_type);
-		typedef decltype(notUseWrapper(typename std::is_scalar<ValueType>::type())) ValueType2;
+	struct _Set_intersection_op
+	{
+		template <typename _InIt1, typename _InIt2, typename _OutIt, typename _Comp>
+		_OutIt operator()(_InIt1 _First1, _InIt1 _Last1, _InIt2 _First2, _InIt2 _Last2, _OutIt _Dest, _Comp& _Cmp) const
+		{
+			return std::set_intersection(_First1, _Last1, _First2, _Last2, _Dest, _Cmp);
+		}
+	};
+
+	struct _Set_difference_op
+	{
+		template <typename _InIt1, typename _InIt2, typename _OutIt, typename _Comp>
+		_OutIt operator()(_InIt1 _First1, _InIt1 _Last1, _InIt2 _First2, _InIt2 _Last2, _OutIt _Dest, _Comp& _Cmp) const
+		{
+			return std::set_difference(_First1, _Last1, _First2, _Last2, _Dest, _Cmp);
+		}
+	};
 
-		typedef std::vector<ValueType2> BufferType;
-		typedef typename BufferType::iterator IteratorType;
+	struct _Set_symmetric_difference_op
+	{
+		template <typename _InIt1, typename _InIt2, typename _OutIt, typename _Comp>
+		_OutIt operator()(_InIt1 _First1, _InIt1 _Last1, _InIt2 _First2, _InIt2 _Last2, _OutIt _Dest, _Comp& _Cmp) const
+		{
+			return std::set_symmetric_difference(_First1, _Last1, _First2, _Last2, _Dest, _Cmp);
+		}
 	};
 
-	template <typename _RandItr1, typename _RandItr2, typename _RandItr3, typename SetOp, typename _CancPos, typename _Comp>
-	_RandItr3 _ParallelSetOperation(_RandItr1 _Begin1, size_t _Len1, _RandItr2 _Begin2, size_t _Len2, _RandItr3 _Output, size_t _ConcurrencyLevel, SetOp _SetOp, _CancPos _CalcPos, _Comp _Cmp)
+	// Splits both ranges where the merge path crosses the given diagonal, then moves the split back to the first
+	// element equivalent to the next merged one, so that equivalent elements of both ranges end up in the same part.
+	template <typename _RandItr1, typename _RandItr2, typename _Comp>
+	std::pair<size_t, size_t> _Set_operation_split(_RandItr1 _Begin1, size_t _Len1, _RandItr2 _Begin2, size_t _Len2, size_t _Diagonal, _Comp &_Cmp)
 	{
-		if (_ConcurrencyLevel > _Len1)
-			_ConcurrencyLevel = _Len1;
+		const size_t _Pos1 = _Merge_path_split(_Begin1, _Len1, _Begin2, _Len2, _Diagonal, _Cmp), _Pos2 = _Diagonal - _Pos1;
+		if (_Pos1 == _Len1 && _Pos2 == _Len2)
+			return std::make_pair(_Len1, _Len2);
 
-		size_t _Step = (_Len1 + _ConcurrencyLevel - 1) / _ConcurrencyLevel;
-		std::vector<_SplitedChunk> _ChunkInfo(_ConcurrencyLevel);
+		if (_Pos1 < _Len1 && (_Pos2 == _Len2 || !_Cmp(_Begin2[_Pos2], _Begin1[_Pos1])))
+		{
+			auto &&_Key = _Begin1[_Pos1];
+			return std::make_pair(std::lower_bound(_Begin1, _Begin1 + _Pos1, _Key, _Cmp) - _Begin1, std::lower_bound(_Begin2, _Begin2 + _Pos2, _Key, _Cmp) - _Begin2);
+		}
 
-		// a reference _Buffer as big as the input data
-		typename SetOperationBuffer<_RandItr3>::BufferType _Buffer(_CalcPos(_Len1, _Len2));
+		auto &&_Key = _Begin2[_Pos2];
+		return std::make_pair(std::lower_bound(_Begin1, _Begin1 + _Pos1, _Key, _Cmp) - _Begin1, std::lower_bound(_Begin2, _Begin2 + _Pos2, _Key, _Cmp) - _Begin2);
+	}
 
-		// _Step 1: filter
-		_Partitioner<static_partitioner_tag>::_For_Each(_ChunkInfo.begin(), _ChunkInfo.size(), _Cmp,
-			[&_Step, &_Len1, &_Begin1, &_Begin2, &_Len2, &_CalcPos, &_SetOp, &_ChunkInfo, &_Buffer](std::vector<_SplitedChunk>::iterator _CurItr, size_t, _Comp& _UserFunc) {
-			size_t _Start1 = (_CurItr - _ChunkInfo.begin()) * _Step;
-			size_t _End1 = (std::min)(_Start1 + _Step, _Len1); // the last chunk can only be smaller than others, since we round up _Step
+	// Both ranges are split into parts of about the same number of input elements along the merge path. The set
+	// operation runs twice on every part, first only counting its output and then, once the offsets of the parts are
+	// known, writing straight to the destination.
+	template <typename _RandItr1, typename _RandItr2, typename _RandItr3, typename _SetOp, typename _Comp>
+	_RandItr3 _ParallelSetOperation(_RandItr1 _Begin1, size_t _Len1, _RandItr2 _Begin2, size_t _Len2, _RandItr3 _Output, size_t _ConcurrencyLevel, _SetOp _Op, _Comp _Cmp)
+	{
+		struct _Set_part
+		{
+			size_t _Start1, _Start2, _Offset;
+		};
 
-			// if it's not last chunk, we need to adjust tail
-			if (_End1 < _Len1)
-			{
-				// all equal range. It will be handled by next chunk.
-				if (!_UserFunc(_Begin1[_Start1], _Begin1[_End1]))
-					return;
-				while (!_UserFunc(_Begin1[_End1 - 1], _Begin1[_End1]))
-					--_End1;
-			}
+		const size_t _Total = _Len1 + _Len2;
+		if (_ConcurrencyLevel > _Total)
+			_ConcurrencyLevel = _Total;
 
-			// Adjust head, until it reach the beginning
-			while (_Start1 > 0 && !_UserFunc(_Begin1[_Start1 - 1], _Begin1[_Start1]))
-				--_Start1;
+		std::vector<_Set_part> _Parts(_ConcurrencyLevel + 1);
+		for (size_t _I = 0; _I <= _ConcurrencyLevel; _I++)
+		{
+			auto _Split = _Set_operation_split(_Begin1, _Len1, _Begin2, _Len2, _Total * _I / _ConcurrencyLevel, _Cmp);
+			_Parts[_I]._Start1 = _Split.first;
+			_Parts[_I]._Start2 = _Split.second;
+		}
 
-			// find a paired range
-			size_t _Start2 = _Start1 == 0 ? 0 : std::lower_bound(_Begin2, _Begin2 + _Len2, _Begin1[_Start1], _UserFunc) - _Begin2;
-			size_t _End2 = _End1 == _Len1 ? _Len2 : std::upper_bound(_Begin2, _Begin2 + _Len2, _Begin1[_End1 - 1], _UserFunc) - _Begin2;
+		typedef typename std::vector<_Set_part>::iterator _Part_iterator;
 
-			_CurItr->_Start = _CalcPos(_Start1, _Start2);
-			auto _OutItr = _Buffer.begin() + _CurItr->_Start;
-			_CurItr->_Len = _SetOp(_Begin1 + _Start1, _Begin1 + _End1, _Begin2 + _Start2, _Begin2 + _End2, _OutItr, _UserFunc) - _OutItr;
+		// _Step 1: count
+		_Partitioner<static_partitioner_tag>::_For_Each(_Parts.begin(), _ConcurrencyLevel, _Cmp,
+			[&_Begin1, &_Begin2, &_Op](_Part_iterator _CurItr, size_t _Count, _Comp& _UserFunc) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				_CurItr->_Offset = _Op(_Begin1 + _CurItr->_Start1, _Begin1 + _CurItr[1]._Start1, _Begin2 + _CurItr->_Start2, _Begin2 + _CurItr[1]._Start2,
+					_Counting_output_iterator(), _UserFunc).count();
+			}
 		}, 1);
 
 		// _Step 2: accumulation
-		_ChunkInfo.front()._Accumulated = 0;
-		for (size_t _I = 1; _I < _ChunkInfo.size(); _I++)
-			_ChunkInfo[_I]._Accumulated = _ChunkInfo[_I - 1]._Accumulated + _ChunkInfo[_I - 1]._Len;
-
-		// _Step 3: move
-		_Partitioner<static_partitioner_tag>::_For_Each(_ChunkInfo.begin(), _ChunkInfo.size(), _Output,
-			[&_Buffer](std::vector<_SplitedChunk>::iterator _CurItr, size_t, _RandItr3 _OutputIter) {
-			std::copy(_Buffer.begin() + _CurItr->_Start, _Buffer.begin() + _CurItr->_Start + _CurItr->_Len, _OutputIter + _CurItr->_Accumulated);
+		size_t _Sum = 0;
+		for (auto &_Part : _Parts)
+		{
+			size_t _Len = _Part._Offset;
+			_Part._Offset = _Sum;
+			_Sum += _Len;
+		}
+
+		// _Step 3: write
+		_Partitioner<static_partitioner_tag>::_For_Each(_Parts.begin(), _ConcurrencyLevel, _Cmp,
+			[&_Begin1, &_Begin2, &_Op, &_Output](_Part_iterator _CurItr, size_t _Count, _Comp& _UserFunc) {
+			for (; _Count > 0; --_Count, ++_CurItr)
+			{
+				_Op(_Begin1 + _CurItr->_Start1, _Begin1 + _CurItr[1]._Start1, _Begin2 + _CurItr->_Start2, _Begin2 + _CurItr[1]._Start2,
+					_Output + _CurItr->_Offset, _UserFunc);
+			}
 		}, 1);
 
-		return _Output + _ChunkInfo.back()._Accumulated + _ChunkInfo.back()._Len;
+		return _Output + _Sum;
 	}
 
 	template <typename _ExPolicy, typename _RandItr1, typename _RandItr2, typename _RandItr3, typename _Comp>
@@ -128,18 +178,10 @@ namespace details
 		else
 		{
 			size_t _ConcurrencyLevel = get_hardware_concurrency() * 2;
-			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel,
-				static_cast<typename SetOperationBuffer<_RandItr3>::IteratorType(*)(_RandItr1, _RandItr1, _RandItr2, _RandItr2, typename SetOperationBuffer<_RandItr3>::IteratorType, _Comp)>(std::set_union),
-				[](size_t _Left, size_t _Right) { return _Left + _Right; }, _Cmp);
+			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel, _Set_union_op(), _Cmp);
 		}
 	}
 
-	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
-	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_union_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
-	{
-		return set_union_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _ItrTag);
-	}
-
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_union_impl(const sequential_execution_policy &, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat)
 	{
@@ -148,6 +190,12 @@ namespace details
 		_EXP_RETHROW
 	}
 
+	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
+	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_union_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
+	{
+		return set_union_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _ItrTag);
+	}
+
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_union_impl(const execution_policy &_Policy, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
 	{
@@ -164,18 +212,10 @@ namespace details
 		else
 		{
 			size_t _ConcurrencyLevel = get_hardware_concurrency() * 2;
-			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel,
-				static_cast<typename SetOperationBuffer<_RandItr3>::IteratorType(*)(_RandItr1, _RandItr1, _RandItr2, _RandItr2, typename SetOperationBuffer<_RandItr3>::IteratorType, _Comp)>(std::set_intersection),
-				[](size_t _Left, size_t _Right) { return (std::min)(_Left, _Right); }, _Cmp);
+			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel, _Set_intersection_op(), _Cmp);
 		}
 	}
 
-	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
-	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_intersection_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
-	{
-		return set_intersection_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _ItrTag);
-	}
-
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_intersection_impl(const sequential_execution_policy &, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat)
 	{
@@ -184,6 +224,12 @@ namespace details
 		_EXP_RETHROW
 	}
 
+	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
+	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_intersection_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
+	{
+		return set_intersection_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _ItrTag);
+	}
+
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_intersection_impl(const execution_policy &_Policy, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _Cat)
 	{
@@ -202,18 +248,10 @@ namespace details
 		else
 		{
 			size_t _ConcurrencyLevel = get_hardware_concurrency() * 2;
-			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel,
-				static_cast<typename SetOperationBuffer<_RandItr3>::IteratorType(*)(_RandItr1, _RandItr1, _RandItr2, _RandItr2, typename SetOperationBuffer<_RandItr3>::IteratorType, _Comp)>(std::set_difference),
-				[](size_t _Left, size_t) { return _Left; }, _Cmp);
+			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel, _Set_difference_op(), _Cmp);
 		}
 	}
 
-	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
-	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_difference_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _Cat)
-	{
-		return set_difference_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _Cat);
-	}
-
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_difference_impl(const sequential_execution_policy &, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat)
 	{
@@ -222,6 +260,12 @@ namespace details
 		_EXP_RETHROW
 	}
 
+	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
+	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_difference_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _Cat)
+	{
+		return set_difference_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _Cat);
+	}
+
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_difference_impl(const execution_policy &_Policy, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _Cat)
 	{
@@ -239,18 +283,10 @@ namespace details
 		else
 		{
 			size_t _ConcurrencyLevel = get_hardware_concurrency() * 2;
-			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel,
-				static_cast<typename SetOperationBuffer<_RandItr3>::IteratorType(*)(_RandItr1, _RandItr1, _RandItr2, _RandItr2, typename SetOperationBuffer<_RandItr3>::IteratorType, _Comp)>(std::set_symmetric_difference),
-				[](size_t _Left, size_t _Right) { return _Left + _Right; }, _Cmp);
+			return _ParallelSetOperation(_Begin1, _Len1, _Begin2, _Len2, _Output, _ConcurrencyLevel, _Set_symmetric_difference_op(), _Cmp);
 		}
 	}
 
-	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
-	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_symmetric_difference_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
-	{
-		return set_symmetric_difference_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _ItrTag);
-	}
-
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_symmetric_difference_impl(const sequential_execution_policy &, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat)
 	{
@@ -259,6 +295,12 @@ namespace details
 		_EXP_RETHROW
 	}
 
+	template <typename _ExPolicy, typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
+	typename _enable_if_parallel<_ExPolicy, OutputItr>::type set_symmetric_difference_impl(_ExPolicy &&, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _ItrTag)
+	{
+		return set_symmetric_difference_impl(seq, _Begin1, _End1, _Begin2, _End2, _Output, _Cmp, _ItrTag);
+	}
+
 	template <typename _InputItr1, typename _InputItr2, typename OutputItr, typename _Comp, typename _ItrCat>
 	OutputItr set_symmetric_difference_impl(const execution_policy &_Policy, _InputItr1 _Begin1, _InputItr1 _End1, _InputItr2 _Begin2, _InputItr2 _End2, OutputItr _Output, _Comp _Cmp, _ItrCat _Cat)
 	{
@@ -271,7 +313,7 @@ inline typename details::_enable_if_policy<_ExecPolicy, _OutIt>::type set_union(
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt1>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required _Output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required _Output iterator or stronger.");
 
 	return details::set_union_impl(_Policy, _First1, _Last1, _First2, _Last2, _Dest, _Cmp, typename details::common_iterator<_InIt1, _InIt2, _OutIt>::iterator_category());
 }
@@ -287,7 +329,7 @@ inline typename details::_enable_if_policy<_ExecPolicy, _OutIt>::type set_inters
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt1>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required _Output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required _Output iterator or stronger.");
 
 	return details::set_intersection_impl(_Policy, _First1, _Last1, _First2, _Last2, _Dest, _Cmp, typename details::common_iterator<_InIt1, _InIt2, _OutIt>::iterator_category());
 }
@@ -303,7 +345,7 @@ inline typename details::_enable_if_policy<_ExecPolicy, _OutIt>::type set_differ
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt1>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required _Output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required _Output iterator or stronger.");
 
 	return details::set_difference_impl(_Policy, _First1, _Last1, _First2, _Last2, _Dest, _Cmp, typename details::common_iterator<_InIt1, _InIt2, _OutIt>::iterator_category());
 }
@@ -319,7 +361,7 @@ inline typename details::_enable_if_policy<_ExecPolicy, _OutIt>::type set_symmet
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt1>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required _Output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required _Output iterator or stronger.");
 
 	return details::set_symmetric_difference_impl(_Policy, _First1, _Last1, _First2, _Last2, _Dest, _Cmp, typename details::common_iterator<_InIt1, _InIt2, _OutIt>::iterator_category());
 }
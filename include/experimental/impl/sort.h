@@ -8,6 +8,11 @@
 #include <functional>
 #include <type_traits>
 #include <algorithm>
+#include <numeric>
+#include <vector>
+#include <cstring>
+#include <atomic>
+#include <limits>
 
 #include "taskgroup.h"
 #include "reduce.h"
@@ -220,14 +225,14 @@ namespace details
 			return std::partial_sort(begin, begin + sortSize, begin + size, func);
 
 		if (sortSize == size)
-			_Parallel_quicksort_impl(begin, size, func, _Div_num, chunkSize, depth);
+			return _Parallel_quicksort_impl(begin, size, func, _Div_num, chunkSize, depth);
 		else if (size - sortSize == 1)
 		{
 			std::iter_swap(max_element(par, begin, begin + size, func), begin + (size - 1));
-			_Parallel_quicksort_impl(begin, size - 1, func, _Div_num, chunkSize, depth);
+			return _Parallel_quicksort_impl(begin, size - 1, func, _Div_num, chunkSize, depth);
 		}
 		else if (sortSize == 1)
-			std::iter_swap(min_element(par, begin, begin + size, func), begin);
+			return std::iter_swap(min_element(par, begin, begin + size, func), begin);
 
 		// Go for general case
 		bool isThreeWay = false;
@@ -259,13 +264,11 @@ namespace details
 		size_t firstRangeSize = midItr - begin;
 		if (firstRangeSize <= sortSize)
 		{
-#pragma warning(push)
-			// nonstandard extension used : 'argument' : conversion from 
-#pragma warning(disable: 4239)
-			tg.run(make_task([&] {
+			// The task is referenced by the task group until the wait
+			auto task = make_task([&] {
 				_Parallel_quicksort_impl(begin, firstRangeSize, func, _Div_num, chunkSize, depth + 1);
-			}));
-#pragma warning(pop)
+			});
+			tg.run(task);
 
 			if (firstRangeSize < sortSize)
 				parallel_partialsort_impl(midItr, sortSize - firstRangeSize, size - firstRangeSize, func, _Div_num / 2, chunkSize, depth + 1);
@@ -277,71 +280,767 @@ namespace details
 			parallel_partialsort_impl(begin, sortSize, firstRangeSize, func, _Div_num / 2, chunkSize, depth + 1);
 	}
 
-	// This function will be called to sort the elements in the "_Begin" buffer. However, we can't tell whether the result will end up in buffer
-	// "_Begin", or buffer "_Output" when it returned. The return value is designed to indicate which buffer holds the sorted result.
-	// Return true if the merge result is in the "_Begin" buffer; return false if the result is in the "_Output" buffer.
-	// We can't always put the result into one assigned buffer because that may cause frequent buffer copies at return time.
-	template<typename _Random_iterator, typename _Random_buffer_iterator, typename _Function>
-	inline bool _Parallel_buffered_sort_impl(const _Random_iterator &_Begin, size_t _Size, _Random_buffer_iterator _Output, _Function &_Func,
-		int _Div_num, const size_t _Chunk_size)
+	//
+	// Stable sort
+	//
+	// Multi-way merge sort used by stable_sort(par). The input is cut into runs which are sorted in place in parallel,
+	// then the runs are split at sampled splitters into independent parts and every part is merged from the runs into
+	// uninitialized scratch storage with a loser tree, before being moved back. Elements are only ever move constructed
+	// into the scratch storage, thus the value type doesn't have to be default constructible.
+	// When the scratch storage is smaller than the input (explicit bound or failed allocation), segments that fit in the
+	// storage are sorted that way and then merged in place, recursively splitting the merges with rotations until the
+	// smaller side fits in the storage.
+	const size_t _Stable_sort_chunk_size = 2048;
+	const size_t _Stable_sort_insertion_size = 32;
+	const size_t _Stable_sort_oversampling = 16;
+
+	template<typename _RanIt, typename _Pr>
+	void _Stable_insertion_sort(_RanIt _First, _RanIt _Last, _Pr& _Pred)
+	{
+		if (_First == _Last)
+			return;
+
+		for (_RanIt _Next = _First + 1; _Next != _Last; ++_Next)
+		{
+			auto _Val = std::move(*_Next);
+			_RanIt _Hole = _Next;
+			for (; _Hole != _First && _Pred(_Val, *(_Hole - 1)); --_Hole)
+				*_Hole = std::move(*(_Hole - 1));
+			*_Hole = std::move(_Val);
+		}
+	}
+
+	// Merges [_First, _Mid) and [_Mid, _Last) moving the smaller side into _Buffer, which must hold it
+	template<typename _RanIt, typename _Ty, typename _Pr>
+	void _Stable_buffered_merge(_RanIt _First, _RanIt _Mid, _RanIt _Last, _Pr& _Pred, _Ty *_Buffer)
 	{
-		static_assert(std::is_same<typename std::iterator_traits<_Random_iterator>::value_type, typename std::iterator_traits<_Random_buffer_iterator>::value_type>::value,
-			"same value type expected");
+		_Constructed_range<_Ty> _Tmp(_Buffer);
 
-		if (_Div_num <= 1 || _Size <= _Chunk_size)
+		if (_Mid - _First <= _Last - _Mid)
 		{
-			std::stable_sort(_Begin, _Begin + _Size, _Func);
+			for (_RanIt _It = _First; _It != _Mid; ++_It, ++_Tmp._Count)
+				::new (static_cast<void *>(_Buffer + _Tmp._Count)) _Ty(std::move(*_It));
 
-			// In case _Size <= _Chunk_size happened BEFORE the planned stop time (when _Div_num == 1) we need to calculate how many turns of 
-			// binary divisions are left. If there are an odd number of turns left, then the buffer move is necessary to make sure the final 
-			// merge result will be in the original input array.
-			int _Left_div_turns = 0;
-			while (_Div_num >>= 1)
+			_Ty *_Left = _Buffer, *_Left_end = _Buffer + _Tmp._Count;
+			_RanIt _Right = _Mid, _Out = _First;
+			while (_Left != _Left_end && _Right != _Last)
 			{
-				_Left_div_turns++;
+				if (_Pred(*_Right, *_Left))
+					*_Out++ = std::move(*_Right++);
+				else
+					*_Out++ = std::move(*_Left++);
 			}
+			std::move(_Left, _Left_end, _Out);
+		}
+		else
+		{
+			for (_RanIt _It = _Mid; _It != _Last; ++_It, ++_Tmp._Count)
+				::new (static_cast<void *>(_Buffer + _Tmp._Count)) _Ty(std::move(*_It));
 
-			if (_Left_div_turns & 1)
+			_Ty *_Right = _Buffer + _Tmp._Count;
+			_RanIt _Left = _Mid, _Out = _Last;
+			while (_Right != _Buffer && _Left != _First)
 			{
-				std::move(_Begin, _Begin + _Size, _Output);
+				if (_Pred(*(_Right - 1), *(_Left - 1)))
+					*--_Out = std::move(*--_Left);
+				else
+					*--_Out = std::move(*--_Right);
+			}
+			std::move_backward(_Buffer, _Right, _Out);
+		}
+	}
+
+	// Splits a merge whose smaller side doesn't fit in the buffer into two independent merges.
+	// Returns the middle of the rotated range, the merges are [_First, _Cut1) + [_Cut1, _New_mid) and [_New_mid, _Cut2) + [_Cut2, _Last).
+	template<typename _RanIt, typename _Pr>
+	_RanIt _Stable_split_merge(_RanIt _First, _RanIt _Mid, _RanIt _Last, _Pr& _Pred, _RanIt& _Cut1, _RanIt& _Cut2)
+	{
+		if (_Mid - _First > _Last - _Mid)
+		{
+			_Cut1 = _First + (_Mid - _First) / 2;
+			_Cut2 = std::lower_bound(_Mid, _Last, *_Cut1, _Pred);
+		}
+		else
+		{
+			_Cut2 = _Mid + (_Last - _Mid) / 2;
+			_Cut1 = std::upper_bound(_First, _Mid, *_Cut2, _Pred);
+		}
+
+		return std::rotate(_Cut1, _Mid, _Cut2);
+	}
+
+	template<typename _RanIt, typename _Ty, typename _Pr>
+	void _Stable_adaptive_merge(_RanIt _First, _RanIt _Mid, _RanIt _Last, _Pr& _Pred, _Ty *_Buffer, size_t _Capacity)
+	{
+		const size_t _Len1 = _Mid - _First, _Len2 = _Last - _Mid;
+		if (_Len1 == 0 || _Len2 == 0)
+			return;
+
+		if ((std::min)(_Len1, _Len2) <= _Capacity)
+			return _Stable_buffered_merge(_First, _Mid, _Last, _Pred, _Buffer);
+
+		if (_Len1 + _Len2 == 2)
+		{
+			if (_Pred(*_Mid, *_First))
+				std::iter_swap(_First, _Mid);
+			return;
+		}
+
+		_RanIt _Cut1, _Cut2;
+		_RanIt _New_mid = _Stable_split_merge(_First, _Mid, _Last, _Pred, _Cut1, _Cut2);
+		_Stable_adaptive_merge(_First, _Cut1, _New_mid, _Pred, _Buffer, _Capacity);
+		_Stable_adaptive_merge(_New_mid, _Cut2, _Last, _Pred, _Buffer, _Capacity);
+	}
+
+	// Sequential merge sort of a run, the buffer is enough for plain buffered merges when it holds half of the run
+	template<typename _RanIt, typename _Ty, typename _Pr>
+	void _Stable_adaptive_sort(_RanIt _First, size_t _Size, _Pr& _Pred, _Ty *_Buffer, size_t _Capacity)
+	{
+		if (_Size <= _Stable_sort_insertion_size)
+			return _Stable_insertion_sort(_First, _First + _Size, _Pred);
+
+		const size_t _Half = _Size / 2;
+		_Stable_adaptive_sort(_First, _Half, _Pred, _Buffer, _Capacity);
+		_Stable_adaptive_sort(_First + _Half, _Size - _Half, _Pred, _Buffer, _Capacity);
+		_Stable_adaptive_merge(_First, _First + _Half, _First + _Size, _Pred, _Buffer, _Capacity);
+	}
+
+	// In place merge splitting the work and the buffer between tasks until _Div_num runs out
+	template<typename _RanIt, typename _Ty, typename _Pr>
+	void _Parallel_stable_adaptive_merge(_RanIt _First, _RanIt _Mid, _RanIt _Last, _Pr& _Pred, _Ty *_Buffer, size_t _Capacity, size_t _Div_num)
+	{
+		if (_Div_num <= 1 || static_cast<size_t>(_Last - _First) <= _Stable_sort_chunk_size || _First == _Mid || _Mid == _Last)
+			return _Stable_adaptive_merge(_First, _Mid, _Last, _Pred, _Buffer, _Capacity);
+
+		_RanIt _Cut1, _Cut2;
+		_RanIt _New_mid = _Stable_split_merge(_First, _Mid, _Last, _Pred, _Cut1, _Cut2);
+
+		const size_t _Half_capacity = _Capacity / 2;
+		TaskGroup _Tg;
+		auto _Handle = make_task([&]
+		{
+			_Parallel_stable_adaptive_merge(_First, _Cut1, _New_mid, _Pred, _Buffer, _Half_capacity, _Div_num / 2);
+		});
+		_Tg.run(_Handle);
+
+		_Parallel_stable_adaptive_merge(_New_mid, _Cut2, _Last, _Pred, _Buffer + _Half_capacity, _Capacity - _Half_capacity, _Div_num / 2);
+
+		_Tg.wait();
+	}
+
+	// Tournament tree over sorted sources, every node keeps the loser of the match played there and _Losers[0] the
+	// overall winner. Ties go to the source with the lower index, which is the earlier one in the input.
+	template<typename _RanIt, typename _Pr>
+	class _Loser_tree
+	{
+		struct _Source
+		{
+			_RanIt _Cur;
+			_RanIt _End;
+		};
+
+		std::vector<_Source> _Sources;
+		std::vector<size_t> _Losers;
+		size_t _Leaves;
+		_Pr& _Pred;
+
+		// True when source _A must be taken before source _B
+		bool _Wins(size_t _A, size_t _B) const
+		{
+			if (_Sources[_A]._Cur == _Sources[_A]._End)
+				return false;
+			if (_Sources[_B]._Cur == _Sources[_B]._End)
 				return true;
+			return _A < _B ? !_Pred(*_Sources[_B]._Cur, *_Sources[_A]._Cur) : _Pred(*_Sources[_A]._Cur, *_Sources[_B]._Cur);
+		}
+
+		size_t _Init(size_t _Node)
+		{
+			if (_Node >= _Leaves)
+				return _Node - _Leaves;
+
+			size_t _Left = _Init(2 * _Node), _Right = _Init(2 * _Node + 1);
+			if (_Wins(_Left, _Right))
+			{
+				_Losers[_Node] = _Right;
+				return _Left;
 			}
-			else
+			_Losers[_Node] = _Left;
+			return _Right;
+		}
+
+	public:
+		_Loser_tree(size_t _Count, _Pr& _P) : _Leaves(1), _Pred(_P)
+		{
+			while (_Leaves < _Count)
+				_Leaves *= 2;
+
+			_Source _Empty = {};
+			_Sources.resize(_Leaves, _Empty);
+			_Losers.resize(_Leaves);
+		}
+
+		void set_source(size_t _Index, _RanIt _First, _RanIt _Last)
+		{
+			_Sources[_Index]._Cur = _First;
+			_Sources[_Index]._End = _Last;
+		}
+
+		void build()
+		{
+			_Losers[0] = _Init(1);
+		}
+
+		// Returns the current smallest element and replays the matches of its source
+		_RanIt pop()
+		{
+			size_t _Winner = _Losers[0];
+			_RanIt _Result = _Sources[_Winner]._Cur++;
+
+			for (size_t _Node = (_Winner + _Leaves) / 2; _Node > 0; _Node /= 2)
+			{
+				if (_Wins(_Losers[_Node], _Winner))
+					std::swap(_Losers[_Node], _Winner);
+			}
+			_Losers[0] = _Winner;
+			return _Result;
+		}
+	};
+
+	// Runs _Func(index) for every index in [0, _Count) on the static partitioner
+	template<typename _Fn>
+	void _Stable_sort_for_each(size_t _Count, const _Fn& _Func)
+	{
+		std::vector<size_t> _Ids(_Count);
+		std::iota(_Ids.begin(), _Ids.end(), size_t{ 0 });
+
+		_Partitioner<static_partitioner_tag>::_For_Each(_Ids.cbegin(), _Count,
+			[&_Func](std::vector<size_t>::const_iterator _Begin, size_t _Chunk_count) {
+			for (size_t _I = 0; _I < _Chunk_count; ++_I)
+				_Func(_Begin[_I]);
+		}, 1);
+	}
+
+	// Sorts [_First, _First + _Size) with the multi-way merge, _Buffer must hold _Size elements
+	template<typename _RanIt, typename _Ty, typename _Pr>
+	void _Multiway_merge_sort(_RanIt _First, size_t _Size, _Pr& _Pred, _Ty *_Buffer, size_t _Max_runs)
+	{
+		const size_t _Runs = (std::max)((std::min)(_Max_runs, _Size / _Stable_sort_chunk_size), size_t{ 1 });
+		if (_Runs == 1)
+			return _Stable_adaptive_sort(_First, _Size, _Pred, _Buffer, _Size);
+
+		std::vector<size_t> _Run_offsets(_Runs + 1);
+		for (size_t _Run = 0; _Run <= _Runs; ++_Run)
+			_Run_offsets[_Run] = _Size * _Run / _Runs;
+
+		_Stable_sort_for_each(_Runs, [&](size_t _Run) {
+			const size_t _Offset = _Run_offsets[_Run], _Len = _Run_offsets[_Run + 1] - _Offset;
+			_Stable_adaptive_sort(_First + _Offset, _Len, _Pred, _Buffer + _Offset, _Len);
+		});
+
+		// Samples ordered by (value, run, position), the order of the elements in the sorted output
+		struct _Sample
+		{
+			size_t _Run;
+			size_t _Pos;
+		};
+
+		std::vector<_Sample> _Samples;
+		_Samples.reserve(_Runs * _Stable_sort_oversampling);
+		for (size_t _Run = 0; _Run < _Runs; ++_Run)
+		{
+			const size_t _Len = _Run_offsets[_Run + 1] - _Run_offsets[_Run];
+			for (size_t _S = 0; _S < _Stable_sort_oversampling; ++_S)
 			{
+				_Sample _Smp = { _Run, _Len * _S / _Stable_sort_oversampling };
+				_Samples.push_back(_Smp);
+			}
+		}
+
+		std::sort(_Samples.begin(), _Samples.end(), [&](const _Sample& _Left, const _Sample& _Right) {
+			auto&& _Left_val = _First[_Run_offsets[_Left._Run] + _Left._Pos];
+			auto&& _Right_val = _First[_Run_offsets[_Right._Run] + _Right._Pos];
+			if (_Pred(_Left_val, _Right_val))
+				return true;
+			if (_Pred(_Right_val, _Left_val))
 				return false;
+			return _Left._Run != _Right._Run ? _Left._Run < _Right._Run : _Left._Pos < _Right._Pos;
+		});
+
+		// _Splits[_Part * _Runs + _Run] is where part _Part starts in run _Run
+		const size_t _Parts = _Runs;
+		std::vector<size_t> _Splits((_Parts + 1) * _Runs);
+		for (size_t _Run = 0; _Run < _Runs; ++_Run)
+			_Splits[_Parts * _Runs + _Run] = _Run_offsets[_Run + 1] - _Run_offsets[_Run];
+
+		for (size_t _Part = 1; _Part < _Parts; ++_Part)
+		{
+			const _Sample& _Splitter = _Samples[_Part * _Samples.size() / _Parts];
+			auto&& _Splitter_val = _First[_Run_offsets[_Splitter._Run] + _Splitter._Pos];
+
+			for (size_t _Run = 0; _Run < _Runs; ++_Run)
+			{
+				_RanIt _Run_first = _First + _Run_offsets[_Run], _Run_last = _First + _Run_offsets[_Run + 1];
+				size_t &_Split = _Splits[_Part * _Runs + _Run];
+				if (_Run < _Splitter._Run)
+					_Split = std::upper_bound(_Run_first, _Run_last, _Splitter_val, _Pred) - _Run_first;
+				else if (_Run == _Splitter._Run)
+					_Split = _Splitter._Pos;
+				else
+					_Split = std::lower_bound(_Run_first, _Run_last, _Splitter_val, _Pred) - _Run_first;
 			}
 		}
-		else
+
+		std::vector<size_t> _Part_offsets(_Parts + 1);
+		for (size_t _Part = 0; _Part <= _Parts; ++_Part)
+			_Part_offsets[_Part] = std::accumulate(_Splits.begin() + _Part * _Runs, _Splits.begin() + (_Part + 1) * _Runs, size_t{ 0 });
+
+		// Elements constructed in the buffer, destroyed even if a merge throws
+		struct _Merged_parts
 		{
-			size_t _Mid = _Size / 2;
-			TaskGroup _Tg;
+			_Ty *_Buffer;
+			const std::vector<size_t>& _Offsets;
+			std::vector<size_t> _Constructed;
 
-			auto _Handle = make_task([&, _Chunk_size]
+			_Merged_parts(_Ty *_B, const std::vector<size_t>& _O) : _Buffer(_B), _Offsets(_O), _Constructed(_O.size() - 1)
 			{
-				_Parallel_buffered_sort_impl(_Begin, _Mid, _Output, _Func, _Div_num / 2, _Chunk_size);
-			});
-			_Tg.run(_Handle);
+			}
 
-			bool _Is_buffer_swap = _Parallel_buffered_sort_impl(_Begin + _Mid, _Size - _Mid, _Output + _Mid, _Func, _Div_num / 2, _Chunk_size);
+			~_Merged_parts()
+			{
+				for (size_t _Part = 0; _Part < _Constructed.size(); ++_Part)
+					for (size_t _I = 0; _I < _Constructed[_Part]; ++_I)
+						_Buffer[_Offsets[_Part] + _I].~_Ty();
+			}
 
-			_Tg.wait();
+			_Merged_parts(const _Merged_parts &) = delete;
+			_Merged_parts &operator =(const _Merged_parts &) = delete;
+		} _Merged(_Buffer, _Part_offsets);
 
-			if (_Is_buffer_swap)
+		_Stable_sort_for_each(_Parts, [&](size_t _Part) {
+			_Loser_tree<_RanIt, _Pr> _Tree(_Runs, _Pred);
+			for (size_t _Run = 0; _Run < _Runs; ++_Run)
 			{
-				_Parallel_merge(_Output, _Mid, _Output + _Mid, _Size - _Mid, _Begin, _Func, _Div_num);
+				_RanIt _Run_first = _First + _Run_offsets[_Run];
+				_Tree.set_source(_Run, _Run_first + _Splits[_Part * _Runs + _Run], _Run_first + _Splits[(_Part + 1) * _Runs + _Run]);
 			}
+			_Tree.build();
+
+			_Ty *_Out = _Buffer + _Part_offsets[_Part];
+			size_t &_Constructed = _Merged._Constructed[_Part];
+			for (const size_t _Len = _Part_offsets[_Part + 1] - _Part_offsets[_Part]; _Constructed < _Len; ++_Constructed)
+				::new (static_cast<void *>(_Out + _Constructed)) _Ty(std::move(*_Tree.pop()));
+		});
+
+		_Stable_sort_for_each(_Parts, [&](size_t _Part) {
+			std::move(_Buffer + _Part_offsets[_Part], _Buffer + _Part_offsets[_Part + 1], _First + _Part_offsets[_Part]);
+		});
+	}
+
+	// _Buffer_size is the number of elements the scratch storage may hold at most
+	template<typename _RanIt, typename _Pr>
+	void _Parallel_stable_sort(_RanIt _First, size_t _Size, _Pr& _Pred, size_t _Buffer_size)
+	{
+		typedef typename std::iterator_traits<_RanIt>::value_type _Ty;
+
+		const size_t _Core_num = get_hardware_concurrency();
+		_Scratch_buffer<_Ty> _Buffer((std::min)(_Size, _Buffer_size));
+		const size_t _Capacity = _Buffer.capacity();
+
+		// 2 runs per core, the parts are not perfectly balanced
+		if (_Capacity >= _Size)
+			return _Multiway_merge_sort(_First, _Size, _Pred, _Buffer.data(), _Core_num * 2);
+
+		const size_t _Segment = (std::max)(_Capacity, _Stable_sort_chunk_size);
+		for (size_t _Offset = 0; _Offset < _Size; _Offset += _Segment)
+		{
+			const size_t _Len = (std::min)(_Segment, _Size - _Offset);
+			if (_Len <= _Capacity)
+				_Multiway_merge_sort(_First + _Offset, _Len, _Pred, _Buffer.data(), _Core_num * 2);
 			else
+				_Stable_adaptive_sort(_First + _Offset, _Len, _Pred, _Buffer.data(), _Capacity);
+		}
+
+		for (size_t _Width = _Segment; _Width < _Size; _Width *= 2)
+		{
+			for (size_t _Offset = 0; _Offset + _Width < _Size; _Offset += 2 * _Width)
 			{
-				_Parallel_merge(_Begin, _Mid, _Begin + _Mid, _Size - _Mid, _Output, _Func, _Div_num);
+				_Parallel_stable_adaptive_merge(_First + _Offset, _First + _Offset + _Width, _First + (std::min)(_Offset + 2 * _Width, _Size),
+					_Pred, _Buffer.data(), _Capacity, _Core_num * 4);
 			}
+		}
+	}
+
+	//
+	// Radix sort
+	//
+	// Parallel LSD radix sort on 8 bit digits used by sort(par) for arithmetic values ordered with std::less or
+	// std::greater and for the key extractor overload. Every pass counts the digits of each block in parallel,
+	// computes the scatter offsets of every (digit, block) pair and scatters the blocks in parallel, each block
+	// in its own order, so the passes are stable. Digits that are the same for all keys are skipped.
+	const size_t _Radix_bits = 8;
+	const size_t _Radix_buckets = 1 << _Radix_bits;
+
+	// Under this size the comparison sort is faster than the extra passes over the buffer
+	const size_t _Radix_min_size = 1 << 14;
+
+	// Minimal block size, the count and offset arrays are _Radix_buckets per block
+	const size_t _Radix_min_block_size = 1 << 12;
+
+	template<size_t _Size>
+	struct _Radix_uint;
+
+	template<> struct _Radix_uint<1> { typedef unsigned char type; };
+	template<> struct _Radix_uint<2> { typedef unsigned short type; };
+	template<> struct _Radix_uint<4> { typedef unsigned int type; };
+	template<> struct _Radix_uint<8> { typedef unsigned long long type; };
+
+	// Maps an arithmetic value to an unsigned integer with the same order
+	template<typename _Ty, bool _IsFloat = std::is_floating_point<_Ty>::value, bool _IsSigned = std::is_signed<_Ty>::value>
+	struct _Radix_key
+	{
+		typedef typename _Radix_uint<sizeof(_Ty)>::type type;
+
+		static type get(_Ty _Val)
+		{
+			return static_cast<type>(_Val);
+		}
+	};
 
-			return !_Is_buffer_swap;
+	template<typename _Ty>
+	struct _Radix_key<_Ty, false, true>
+	{
+		typedef typename _Radix_uint<sizeof(_Ty)>::type type;
+
+		// Flipping the sign bit orders negative values first
+		static type get(_Ty _Val)
+		{
+			return static_cast<type>(static_cast<type>(_Val) ^ (static_cast<type>(1) << (sizeof(_Ty) * 8 - 1)));
 		}
+	};
+
+	template<typename _Ty>
+	struct _Radix_key<_Ty, true, true>
+	{
+		typedef typename _Radix_uint<sizeof(_Ty)>::type type;
+
+		// IEEE 754: positive values get the sign bit set, negative values are inverted to reverse their order
+		static type get(_Ty _Val)
+		{
+			const type _Sign = static_cast<type>(1) << (sizeof(_Ty) * 8 - 1);
+			type _Bits;
+			std::memcpy(&_Bits, &_Val, sizeof(_Ty));
+			return (_Bits & _Sign) ? static_cast<type>(~_Bits) : static_cast<type>(_Bits | _Sign);
+		}
+	};
+
+	template<typename _Ty>
+	struct _Is_radix_sortable : std::integral_constant<bool,
+		std::is_arithmetic<_Ty>::value && !std::is_same<_Ty, bool>::value &&
+		(sizeof(_Ty) == 1 || sizeof(_Ty) == 2 || sizeof(_Ty) == 4 || sizeof(_Ty) == 8)>
+	{
+	};
+
+	struct _Radix_identity
+	{
+		template<typename _Ty>
+		const _Ty& operator()(const _Ty& _Val) const
+		{
+			return _Val;
+		}
+	};
+
+	// Comparison of the keys returned by a key extractor, sort(par, first, last, key) sorts on key(value)
+	template<typename _KeyFn>
+	struct _Key_compare
+	{
+		_KeyFn _Key;
+
+		explicit _Key_compare(_KeyFn _Fn) : _Key(_Fn)
+		{
+		}
+
+		template<typename _Ty>
+		bool operator()(const _Ty& _Left, const _Ty& _Right) const
+		{
+			return _Key(_Left) < _Key(_Right);
+		}
+	};
+
+	template<typename>
+	struct _Sort_void
+	{
+		typedef void type;
+	};
+
+	// A callable taking one value and returning an arithmetic key is a key extractor, anything else a comparison
+	template<typename _Fn, typename _Ty, typename = void>
+	struct _Is_sort_key_extractor : std::false_type
+	{
+	};
+
+	template<typename _Fn, typename _Ty>
+	struct _Is_sort_key_extractor<_Fn, _Ty, typename _Sort_void<decltype(std::declval<const _Fn&>()(std::declval<const _Ty&>()))>::type> :
+		std::integral_constant<bool, std::is_arithmetic<typename std::decay<decltype(std::declval<const _Fn&>()(std::declval<const _Ty&>()))>::type>::value>
+	{
+	};
+
+	template<typename _Pr, typename _Ty, bool _IsKey = _Is_sort_key_extractor<_Pr, _Ty>::value>
+	struct _Sort_predicate
+	{
+		typedef _Pr type;
+
+		static type make(_Pr _Pred)
+		{
+			return _Pred;
+		}
+	};
+
+	template<typename _Pr, typename _Ty>
+	struct _Sort_predicate<_Pr, _Ty, true>
+	{
+		typedef _Key_compare<_Pr> type;
+
+		static type make(_Pr _Key)
+		{
+			static_assert(_Is_radix_sortable<typename std::decay<decltype(_Key(std::declval<const _Ty&>()))>::type>::value, "The key must be an arithmetic type of 1, 2, 4 or 8 bytes.");
+			return type(_Key);
+		}
+	};
+
+	// Predicates radix sort can reproduce: value is false for any other one, order is 1 ascending and -1 descending,
+	// key() gives the key extractor
+	template<typename _Ty, typename _Pr>
+	struct _Radix_sort_traits
+	{
+		static const bool value = false;
+	};
+
+	template<typename _Ty, int _Order>
+	struct _Radix_sort_arithmetic_traits
+	{
+		static const bool value = _Is_radix_sortable<_Ty>::value;
+		static const int order = _Order;
+
+		template<typename _Pr>
+		static _Radix_identity key(const _Pr&)
+		{
+			return _Radix_identity();
+		}
+	};
+
+	template<typename _Ty> struct _Radix_sort_traits<_Ty, std::less<>> : _Radix_sort_arithmetic_traits<_Ty, 1> {};
+	template<typename _Ty> struct _Radix_sort_traits<_Ty, std::less<_Ty>> : _Radix_sort_arithmetic_traits<_Ty, 1> {};
+	template<typename _Ty> struct _Radix_sort_traits<_Ty, std::greater<>> : _Radix_sort_arithmetic_traits<_Ty, -1> {};
+	template<typename _Ty> struct _Radix_sort_traits<_Ty, std::greater<_Ty>> : _Radix_sort_arithmetic_traits<_Ty, -1> {};
+
+	template<typename _Ty, typename _KeyFn>
+	struct _Radix_sort_traits<_Ty, _Key_compare<_KeyFn>>
+	{
+		static const bool value = true;
+		static const int order = 1;
+
+		static _KeyFn key(const _Key_compare<_KeyFn>& _Pred)
+		{
+			return _Pred._Key;
+		}
+	};
+
+	// Unsigned key of a value, through the user key extractor and in descending order if requested
+	template<typename _KeyFn, bool _Descending>
+	struct _Radix_key_extractor
+	{
+		_KeyFn _Extract;
+
+		explicit _Radix_key_extractor(_KeyFn _Fn) : _Extract(_Fn)
+		{
+		}
+
+		template<typename _Ty>
+		auto operator()(const _Ty& _Val) const -> typename _Radix_key<typename std::decay<decltype(_Extract(_Val))>::type>::type
+		{
+			typedef typename std::decay<decltype(_Extract(_Val))>::type _Key_type;
+			auto _Key = _Radix_key<_Key_type>::get(_Extract(_Val));
+			return _Descending ? static_cast<decltype(_Key)>(~_Key) : _Key;
+		}
+	};
+
+	// Runs _Func(block index) for every block on the static partitioner
+	template<typename _Fn>
+	void _Radix_for_each_block(const std::vector<size_t>& _Block_ids, const _Fn& _Func)
+	{
+		_Partitioner<static_partitioner_tag>::_For_Each(_Block_ids.begin(), _Block_ids.size(),
+			[&_Func](std::vector<size_t>::const_iterator _Begin, size_t _Count) {
+			for (size_t _I = 0; _I < _Count; ++_I)
+				_Func(_Begin[_I]);
+		}, 1);
+	}
+
+	// Counts the digits of every block and turns the counts into the scatter offsets of every (block, digit) pair
+	template<typename _SrcIt, typename _KeyOp>
+	void _Radix_offsets(_SrcIt _Src, size_t _Size, size_t _Block_size, const std::vector<size_t>& _Block_ids,
+		std::vector<size_t>& _Offsets, const _KeyOp& _Get_key, size_t _Shift)
+	{
+		const size_t _Blocks = _Block_ids.size();
+		std::fill(_Offsets.begin(), _Offsets.end(), size_t{ 0 });
+
+		_Radix_for_each_block(_Block_ids, [&](size_t _Block) {
+			size_t *_Count = &_Offsets[_Block * _Radix_buckets];
+			const size_t _End = (std::min)((_Block + 1) * _Block_size, _Size);
+			for (size_t _I = _Block * _Block_size; _I < _End; ++_I)
+				++_Count[(_Get_key(_Src[_I]) >> _Shift) & (_Radix_buckets - 1)];
+		});
+
+		// Exclusive scan of the counts in (digit, block) order gives every block its slots for every digit
+		size_t _Sum = 0;
+		for (size_t _Digit = 0; _Digit < _Radix_buckets; ++_Digit) {
+			for (size_t _Block = 0; _Block < _Blocks; ++_Block) {
+				size_t &_Slot = _Offsets[_Block * _Radix_buckets + _Digit];
+				const size_t _Count = _Slot;
+				_Slot = _Sum;
+				_Sum += _Count;
+			}
+		}
+	}
+
+	template<typename _SrcIt, typename _DstIt, typename _KeyOp>
+	void _Radix_sort_pass(_SrcIt _Src, _DstIt _Dst, size_t _Size, size_t _Block_size, const std::vector<size_t>& _Block_ids,
+		std::vector<size_t>& _Offsets, const _KeyOp& _Get_key, size_t _Shift)
+	{
+		_Radix_offsets(_Src, _Size, _Block_size, _Block_ids, _Offsets, _Get_key, _Shift);
+
+		_Radix_for_each_block(_Block_ids, [&](size_t _Block) {
+			size_t *_Offset = &_Offsets[_Block * _Radix_buckets];
+			const size_t _End = (std::min)((_Block + 1) * _Block_size, _Size);
+			for (size_t _I = _Block * _Block_size; _I < _End; ++_I)
+				_Dst[_Offset[(_Get_key(_Src[_I]) >> _Shift) & (_Radix_buckets - 1)]++] = std::move(_Src[_I]);
+		});
+	}
+
+	// The first pass into the scratch buffer move constructs the elements there. Every (block, digit) pair fills a range
+	// of its own, _Filled tracks them in the order of _Offsets.
+	template<typename _RanIt, typename _Ty, typename _KeyOp>
+	void _Radix_sort_first_pass(_RanIt _Src, _Constructed_ranges<_Ty>& _Filled, size_t _Size, size_t _Block_size, const std::vector<size_t>& _Block_ids,
+		std::vector<size_t>& _Offsets, const _KeyOp& _Get_key, size_t _Shift)
+	{
+		_Radix_offsets(_Src, _Size, _Block_size, _Block_ids, _Offsets, _Get_key, _Shift);
+		for (size_t _I = 0; _I < _Offsets.size(); ++_I)
+			_Filled._Ranges[_I].first = _Offsets[_I];
+
+		_Radix_for_each_block(_Block_ids, [&](size_t _Block) {
+			std::pair<size_t, size_t> *_Range = &_Filled._Ranges[_Block * _Radix_buckets];
+			const size_t _End = (std::min)((_Block + 1) * _Block_size, _Size);
+			for (size_t _I = _Block * _Block_size; _I < _End; ++_I) {
+				auto& _Digit_range = _Range[(_Get_key(_Src[_I]) >> _Shift) & (_Radix_buckets - 1)];
+				::new (static_cast<void *>(_Filled._Base + _Digit_range.first + _Digit_range.second)) _Ty(std::move(_Src[_I]));
+				++_Digit_range.second;
+			}
+		});
+	}
+
+	// Returns false without touching the range when the scratch buffer cannot be allocated
+	template<typename _RanIt, typename _KeyOp>
+	bool _Parallel_radix_sort_impl(_RanIt _First, size_t _Size, const _KeyOp& _Get_key)
+	{
+		typedef typename std::iterator_traits<_RanIt>::value_type _Ty;
+		typedef typename std::decay<decltype(_Get_key(*_First))>::type _Uint;
+
+		const size_t _Block_size = (std::max)((_Size + get_hardware_concurrency() - 1) / get_hardware_concurrency(), _Radix_min_block_size);
+		std::vector<size_t> _Block_ids((_Size + _Block_size - 1) / _Block_size);
+		std::iota(_Block_ids.begin(), _Block_ids.end(), size_t{ 0 });
+
+		// Bits that differ between keys, digits without any of them need no pass
+		std::vector<_Uint> _Block_or(_Block_ids.size()), _Block_and(_Block_ids.size());
+		_Radix_for_each_block(_Block_ids, [&](size_t _Block) {
+			const size_t _End = (std::min)((_Block + 1) * _Block_size, _Size);
+			_Uint _Or = 0, _And = static_cast<_Uint>(~_Uint{ 0 });
+			for (size_t _I = _Block * _Block_size; _I < _End; ++_I) {
+				const _Uint _Key = _Get_key(_First[_I]);
+				_Or |= _Key;
+				_And &= _Key;
+			}
+			_Block_or[_Block] = _Or;
+			_Block_and[_Block] = _And;
+		});
+
+		_Uint _Or = 0, _And = static_cast<_Uint>(~_Uint{ 0 });
+		for (size_t _Block = 0; _Block < _Block_ids.size(); ++_Block) {
+			_Or |= _Block_or[_Block];
+			_And &= _Block_and[_Block];
+		}
+
+		const _Uint _Varying = _Or ^ _And;
+
+		if (_Varying == 0)
+			return true;
+
+		// Uninitialized, the first pass constructs the elements and the others assign them
+		_Scratch_buffer<_Ty> _Buffer(_Size);
+		if (_Buffer.capacity() < _Size)
+			return false;
+
+		auto _Tmp = _Unchecked_array(_Buffer.data());
+		std::vector<size_t> _Offsets(_Block_ids.size() * _Radix_buckets);
+		_Constructed_ranges<_Ty> _Filled(_Buffer.data(), _Offsets.size());
+		bool _Constructed = false, _In_buffer = false;
+
+		for (size_t _Shift = 0; _Shift < sizeof(_Uint) * 8; _Shift += _Radix_bits) {
+			if (((_Varying >> _Shift) & (_Radix_buckets - 1)) == 0)
+				continue;
+
+			if (_In_buffer)
+				_Radix_sort_pass(_Tmp, _First, _Size, _Block_size, _Block_ids, _Offsets, _Get_key, _Shift);
+			else if (_Constructed)
+				_Radix_sort_pass(_First, _Tmp, _Size, _Block_size, _Block_ids, _Offsets, _Get_key, _Shift);
+			else {
+				_Radix_sort_first_pass(_First, _Filled, _Size, _Block_size, _Block_ids, _Offsets, _Get_key, _Shift);
+
+				// The buffer is now complete, a single range tracks it
+				_Filled._Ranges.assign(1, std::pair<size_t, size_t>(0, _Size));
+				_Constructed = true;
+			}
+
+			_In_buffer = !_In_buffer;
+		}
+
+		if (_In_buffer) {
+			_Radix_for_each_block(_Block_ids, [&](size_t _Block) {
+				const size_t _Begin = _Block * _Block_size;
+				const size_t _End = (std::min)(_Begin + _Block_size, _Size);
+				std::move(_Tmp + _Begin, _Tmp + _End, _First + _Begin);
+			});
+		}
+		return true;
+	}
+
+	template<typename _RanIt, typename _KeyFn>
+	inline bool _Parallel_radix_sort(_RanIt _First, size_t _Size, _KeyFn _Key, int _Order)
+	{
+		if (_Order < 0)
+			return _Parallel_radix_sort_impl(_First, _Size, _Radix_key_extractor<_KeyFn, true>(_Key));
+		else
+			return _Parallel_radix_sort_impl(_First, _Size, _Radix_key_extractor<_KeyFn, false>(_Key));
 	}
 
 	//
 	// Sort
 	//
+	template<typename _RanIt, typename _Pr>
+	inline void _Parallel_sort_engine(_RanIt _First, size_t _Size, _Pr _Pred, size_t _Core_num, size_t _Chunk_size, std::false_type)
+	{
+		_Parallel_quicksort_impl(_First, _Size, _Pred, _Core_num * _SortMaxTasksPerCore, _Chunk_size, 0);
+	}
+
+	template<typename _RanIt, typename _Pr>
+	inline void _Parallel_sort_engine(_RanIt _First, size_t _Size, _Pr _Pred, size_t _Core_num, size_t _Chunk_size, std::true_type)
+	{
+		typedef _Radix_sort_traits<typename std::iterator_traits<_RanIt>::value_type, _Pr> _Radix_traits;
+
+		// The comparison sort also takes over when there is no memory for the radix sort buffer
+		if (_Size < _Radix_min_size || !_Parallel_radix_sort(_First, _Size, _Radix_traits::key(_Pred), _Radix_traits::order))
+			_Parallel_quicksort_impl(_First, _Size, _Pred, _Core_num * _SortMaxTasksPerCore, _Chunk_size, 0);
+	}
+
 	template<typename _RanIt, typename _Pr, class _IterCat>
 	inline void _Sort_impl(const sequential_execution_policy&, _RanIt _First, _RanIt _Last, _Pr _Pred, _IterCat)
 	{
@@ -363,7 +1062,8 @@ namespace details
 			return std::sort(_First, _Last, _Pred);
 		}
 
-		_Parallel_quicksort_impl(_First, _Size, _Pred, _Core_num * _SortMaxTasksPerCore, _ChunkSize, 0);
+		typedef _Radix_sort_traits<typename std::iterator_traits<_FwdIt>::value_type, _Pr> _Radix_traits;
+		_Parallel_sort_engine(_First, _Size, _Pred, _Core_num, _ChunkSize, std::integral_constant<bool, _Radix_traits::value>());
 	}
 
 	template<typename _RanIt, typename _Pr, class _IterCat>
@@ -413,107 +1113,167 @@ namespace details
 	// stable_sort
 	//
 	template<class _RanIt, class _Pr, class _IterCat>
-	inline void _Stable_sort_impl(const sequential_execution_policy&, _RanIt _First, _RanIt _Last, _Pr _Pred, _IterCat)
+	inline void _Stable_sort_impl(const sequential_execution_policy&, _RanIt _First, _RanIt _Last, _Pr _Pred, size_t _Buffer_size, _IterCat)
 	{
 		_EXP_TRY
-			std::stable_sort(_First, _Last, _Pred);
+			const size_t _Size = _Last - _First;
+			if (_Buffer_size >= _Size)
+				return std::stable_sort(_First, _Last, _Pred);
+
+			_Scratch_buffer<typename std::iterator_traits<_RanIt>::value_type> _Buffer(_Buffer_size);
+			_Stable_adaptive_sort(_First, _Size, _Pred, _Buffer.data(), _Buffer.capacity());
 		_EXP_RETHROW
 	}
 
 	template<class _ExPolicy, class _RanIt, class _Pr, class _IterCat>
-	inline void _Stable_sort_impl(const _ExPolicy&, _RanIt _First, _RanIt _Last, _Pr _Pred, _IterCat)
+	inline void _Stable_sort_impl(const _ExPolicy&, _RanIt _First, _RanIt _Last, _Pr _Pred, size_t _Buffer_size, _IterCat _Cat)
 	{
-		// Check cancellation before the algorithm starts.
 		size_t _Size = _Last - _First;
-		size_t _Core_num = get_hardware_concurrency();
-		const size_t _Chunk_size = 2048;
-
-		if (_Size <= _Chunk_size || _Core_num < 2)
-		{
-			return std::stable_sort(_First, _Last, _Pred);
-		}
-		const static size_t CORE_NUM_MASK = 0x55555555;
-
-		// 4 times overload on each core
-		_Core_num *= 4;
-
-		auto _Holder = std::make_unique<typename std::iterator_traits<_RanIt>::value_type []>(_Size);
-
-		// This buffered sort algorithm will divide chunks and apply parallel quicksort on each chunk. In the end, it will 
-		// apply parallel merge to these sorted chunks.
-		// 
-		// We need to decide on the number of chunks to divide the input buffer into. If we divide it into n chunks, log(n) 
-		// merges will be needed to get the final sorted result. In this algorithm, we have two buffers for each merge 
-		// operation, let's say buffer A and B. Buffer A is the original input array, buffer B is the additional allocated 
-		// buffer. Each turn's merge will put the merge result into the other buffer; for example, if we decided to split 
-		// into 8 chunks in buffer A at very beginning, after one pass of merging, there will be 4 chunks in buffer B.
-		// If we apply one more pass of merging, there will be 2 chunks in buffer A again.
-		// 
-		// The problem is we want to the final merge pass to put the result back in buffer A, so that we don't need 
-		// one extra copy to put the sorted data back to buffer A.
-		// To make sure the final result is in buffer A (original input array), we need an even number of merge passes,
-		// which means log(n) must be an even number. Thus n must be a number power(2, even number). For example, when the
-		// even number is 2, n is power(2, 2) = 4, when even number is 4, n is power(2, 4) = 16. When we divide chunks 
-		// into these numbers, the final merge result will be in the original input array. Now we need to decide the chunk(split) 
-		// number based on this property and the number of cores.
-		// 
-		// We want to get a chunk (split) number close to the core number (or a little more than the number of cores), 
-		// and it also needs to satisfy above property. For a 8 core machine, the best chunk number should be 16, because it's 
-		// the smallest number that satisfies the above property and is bigger than the core number (so that we can utilize all 
-		// cores, a little more than core number is OK, we need to split more tasks anyway). 
-		// 
-		// In this algorithm, we will make this alignment by bit operations (it's easy and clear). For a binary representation, 
-		// all the numbers that satisfy power(2, even number) will be 1, 100, 10000, 1000000, 100000000 ...
-		// After OR-ing these numbers together, we will get a mask (... 0101 0101 0101) which is all possible combinations of 
-		// power(2, even number). We use _Core_num & CORE_NUM_MASK | _Core_num << 1 & CORE_NUM_MASK, a bit-wise operation to align 
-		// _Core_num's highest bit into a power(2, even number).
-		// 
-		// It means if _Core_num = 8, the highest bit in binary is bin(1000) which is not power(2, even number). After this 
-		// bit-wise operation, it will align to bin(10000) = 16 which is power(2, even number). If the _Core_num = 16, after 
-		// alignment it still returns 16. The trick is to make sure the highest bit of _Core_num will align to the "1" bit of the 
-		// mask bin(... 0101 0101 0101) We don't care about the other bits on the aligned result except the highest bit, because they 
-		// will be ignored in the function.
-		_Parallel_buffered_sort_impl(_First, _Size, stdext::make_unchecked_array_iterator(_Holder.get()),
-			_Pred, _Core_num & CORE_NUM_MASK | _Core_num << 1 & CORE_NUM_MASK, _Chunk_size);
+		if (_Size <= _Stable_sort_chunk_size || get_hardware_concurrency() < 2)
+			return _Stable_sort_impl(seq, _First, _Last, _Pred, _Buffer_size, _Cat);
+
+		_Parallel_stable_sort(_First, _Size, _Pred, _Buffer_size);
 	}
 
 	template<class _ExPolicy, class _RanIt, class _Pr>
-	inline void _Stable_sort_impl(const _ExPolicy&, _RanIt _First, _RanIt _Last, _Pr _Pred, std::input_iterator_tag _Cat)
+	inline void _Stable_sort_impl(const _ExPolicy&, _RanIt _First, _RanIt _Last, _Pr _Pred, size_t _Buffer_size, std::input_iterator_tag _Cat)
 	{
-		_Stable_sort_impl(seq, _First, _Last, _Pred, _Cat);
+		_Stable_sort_impl(seq, _First, _Last, _Pred, _Buffer_size, _Cat);
 	}
 
 	template<class _RanIt, class _Pr, class _IterCat>
-	inline void _Stable_sort_impl(const execution_policy& _Policy, _RanIt _First, _RanIt _Last, _Pr _Pred, _IterCat _Cat)
+	inline void _Stable_sort_impl(const execution_policy& _Policy, _RanIt _First, _RanIt _Last, _Pr _Pred, size_t _Buffer_size, _IterCat _Cat)
 	{
-		_EXP_GENERIC_EXECUTION_POLICY(_Stable_sort_impl, _Policy, _First, _Last, _Pred, _Cat);
+		_EXP_GENERIC_EXECUTION_POLICY(_Stable_sort_impl, _Policy, _First, _Last, _Pred, _Buffer_size, _Cat);
 	}
 
 	//
 	// partial_sort_copy
 	//
-	// partial_sort_copy always fallback to sequential since heap_sort is not able to be parallelized
-	template<class _ExPolicy, class _InIt, class _RanIt, class _Pr>
-	inline _RanIt _Partial_sort_copy_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _RanIt _First2, _RanIt _Last2, _Pr _Pred)
+	template<class _InIt, class _RanIt, class _Pr, class _IterCat>
+	inline _RanIt _Partial_sort_copy_impl(const sequential_execution_policy&, _InIt _First, _InIt _Last, _RanIt _First2, _RanIt _Last2, _Pr _Pred, _IterCat)
 	{
 		_EXP_TRY
 			return std::partial_sort_copy(_First, _Last, _First2, _Last2, _Pred);
 		_EXP_RETHROW
 	}
 
-	template<class _InIt, class _RanIt, class _Pr>
-	inline _RanIt _Partial_sort_copy_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _RanIt _First2, _RanIt _Last2, _Pr _Pred)
+	// Every chunk of the input keeps its smallest elements with a bounded max heap in its own slot of the uninitialized
+	// candidate buffer, which holds at most the size of the input. The candidates are then partially sorted in parallel
+	// and the first ones moved to the output.
+	template<class _ExPolicy, class _FwdIt, class _RanIt, class _Pr, class _IterCat>
+	inline typename _enable_if_parallel<_ExPolicy, _RanIt>::type _Partial_sort_copy_impl(const _ExPolicy&, _FwdIt _First, _FwdIt _Last, _RanIt _First2, _RanIt _Last2, _Pr _Pred, _IterCat)
 	{
-		_EXP_GENERIC_EXECUTION_POLICY(_Partial_sort_copy_impl, _Policy, _First, _Last, _First2, _Last2, _Pred);
+		typedef typename std::iterator_traits<_RanIt>::value_type _Ty;
+
+		const size_t _ChunkSize = 2048; // Default chunk size
+		const size_t _Core_num = get_hardware_concurrency();
+		const size_t _Size = std::distance(_First, _Last);
+		const size_t _Count = (std::min)(_Size, static_cast<size_t>(_Last2 - _First2));
+
+		if (_Count == 0)
+			return _First2;
+
+		if (_Size <= _ChunkSize || _Core_num < 2)
+			return std::partial_sort_copy(_First, _Last, _First2, _Last2, _Pred);
+
+		const size_t _Chunk = (std::max)((_Size + _Core_num - 1) / _Core_num, _ChunkSize);
+		const size_t _Slot_size = (std::min)(_Count, _Chunk);
+		const size_t _Slots = (_Size + _Chunk - 1) / _Chunk;
+
+		_Scratch_buffer<_Ty> _Buffer(_Slots * _Slot_size);
+		if (_Buffer.capacity() < _Slots * _Slot_size)
+			return std::partial_sort_copy(_First, _Last, _First2, _Last2, _Pred);
+
+		struct _Candidates
+		{
+			_Constructed_ranges<_Ty> _Filled; // one range per slot
+			std::atomic<size_t> _Next_slot;
+
+			_Candidates(_Ty *_Buffer, size_t _Slots) : _Filled(_Buffer, _Slots), _Next_slot(0)
+			{
+			}
+		} _Cand(_Buffer.data(), _Slots);
+
+		_Partitioner<static_partitioner_tag>::_For_Each(_First, _Size, &_Cand, [_Chunk, _Slot_size, &_Pred](_FwdIt _Begin, size_t _Partition_count, _Candidates *_Data) {
+			// A nested loop over the chore limit runs inline as one partition, no slot can hold its candidates.
+			// It is left empty and the whole input goes to the sequential algorithm below.
+			if (_Partition_count > _Chunk)
+				return;
+
+			const size_t _Slot = _Data->_Next_slot.fetch_add(1);
+			auto& _Range = _Data->_Filled._Ranges[_Slot];
+			_Range.first = _Slot * _Slot_size;
+			_Ty *_Out = _Data->_Filled._Base + _Range.first;
+
+			for (const size_t _Heap_size = (std::min)(_Slot_size, _Partition_count); _Range.second < _Heap_size; ++_Range.second, ++_Begin)
+				::new (static_cast<void *>(_Out + _Range.second)) _Ty(*_Begin);
+
+			// The rest of the chunk replaces the largest candidate whenever it is smaller
+			auto _Heap_begin = _Unchecked_array(_Out), _Heap_end = _Unchecked_array(_Out + _Range.second);
+			std::make_heap(_Heap_begin, _Heap_end, _Pred);
+			for (size_t _Rest = _Partition_count - _Range.second; _Rest > 0; --_Rest, ++_Begin) {
+				if (_Pred(*_Begin, *_Out)) {
+					std::pop_heap(_Heap_begin, _Heap_end, _Pred);
+					*(_Heap_end - 1) = *_Begin;
+					std::push_heap(_Heap_begin, _Heap_end, _Pred);
+				}
+			}
+		}, _Chunk);
+
+		// Close the gaps left by the slots that were not filled up, the candidates end up in the range of slot 0.
+		// The gaps hold no objects, the candidates behind them are move constructed there and destroyed.
+		auto& _Ranges = _Cand._Filled._Ranges;
+		const size_t _Used_slots = _Cand._Next_slot.load();
+		for (size_t _Slot = 1; _Slot < _Used_slots; ++_Slot) {
+			auto& _Range = _Ranges[_Slot];
+			if (_Range.first == _Ranges[0].second) {
+				_Ranges[0].second += _Range.second;
+				_Range.second = 0;
+				continue;
+			}
+
+			for (; _Range.second > 0; ++_Range.first, --_Range.second, ++_Ranges[0].second) {
+				_Ty *_Src = _Buffer.data() + _Range.first;
+				::new (static_cast<void *>(_Buffer.data() + _Ranges[0].second)) _Ty(std::move(*_Src));
+				_Src->~_Ty();
+			}
+		}
+
+		const size_t _Total = _Ranges[0].second;
+		if (_Total < _Count)
+			return std::partial_sort_copy(_First, _Last, _First2, _Last2, _Pred);
+
+		auto _Candidates_begin = _Unchecked_array(_Buffer.data());
+		if (_Total <= _ChunkSize)
+			return std::partial_sort_copy(_Candidates_begin, _Candidates_begin + _Total, _First2, _First2 + _Count, _Pred);
+
+		parallel_partialsort_impl(_Candidates_begin, _Count, _Total, _Pred, _Core_num * _SortMaxTasksPerCore, _ChunkSize, 0);
+		return std::move(_Candidates_begin, _Candidates_begin + _Count, _First2);
+	}
+
+	template<class _ExPolicy, class _InIt, class _RanIt, class _Pr>
+	inline typename _enable_if_parallel<_ExPolicy, _RanIt>::type _Partial_sort_copy_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _RanIt _First2, _RanIt _Last2, _Pr _Pred, std::input_iterator_tag _Cat)
+	{
+		return _Partial_sort_copy_impl(seq, _First, _Last, _First2, _Last2, _Pred, _Cat);
+	}
+
+	template<class _InIt, class _RanIt, class _Pr, class _IterCat>
+	inline _RanIt _Partial_sort_copy_impl(const execution_policy& _Policy, _InIt _First, _InIt _Last, _RanIt _First2, _RanIt _Last2, _Pr _Pred, _IterCat _Cat)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Partial_sort_copy_impl, _Policy, _First, _Last, _First2, _Last2, _Pred, _Cat);
 	}
 }  //details
 
+// _Pred is either a comparison or a key extractor returning an arithmetic key, the range is then sorted by ascending key.
+// With a parallel policy arithmetic values compared with std::less or std::greater and key extractors use a radix sort.
 template<class _ExPolicy, class _RanIt, class _Pr>
 inline typename details::_enable_if_policy<_ExPolicy, void>::type sort(_ExPolicy&& _Policy, _RanIt _First, _RanIt _Last, _Pr _Pred)
 {
 	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_RanIt>::iterator_category>::value, "Required random access iterator.");
 
-	details::_Sort_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	typedef details::_Sort_predicate<_Pr, typename std::iterator_traits<_RanIt>::value_type> _Sort_predicate;
+	details::_Sort_impl(_Policy, _First, _Last, _Sort_predicate::make(_Pred), details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _RanIt>
@@ -527,7 +1287,7 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type partial_sort(_
 {
 	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_RanIt>::iterator_category>::value, "Required random access iterator.");
 
-	details::_Partial_sort_impl(_Policy, _First, _Mid, _Last, _Pred, std::_Iter_cat(_First));
+	details::_Partial_sort_impl(_Policy, _First, _Mid, _Last, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _RanIt>
@@ -541,7 +1301,17 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type stable_sort(_E
 {
 	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_RanIt>::iterator_category>::value, "Required random access iterator.");
 
-	details::_Stable_sort_impl(_Policy, _First, _Last, _Pred, std::_Iter_cat(_First));
+	details::_Stable_sort_impl(_Policy, _First, _Last, _Pred, (std::numeric_limits<size_t>::max)(), details::_Iter_cat(_First));
+}
+
+// Extension: stable_sort using at most _Buffer_size elements of scratch storage, for instance a fraction of the input on
+// memory constrained hosts. Smaller buffers trade memory for additional element moves, 0 sorts without any buffer.
+template<class _ExPolicy, class _RanIt, class _Pr>
+inline typename details::_enable_if_policy<_ExPolicy, void>::type stable_sort(_ExPolicy&& _Policy, _RanIt _First, _RanIt _Last, _Pr _Pred, size_t _Buffer_size)
+{
+	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_RanIt>::iterator_category>::value, "Required random access iterator.");
+
+	details::_Stable_sort_impl(_Policy, _First, _Last, _Pred, _Buffer_size, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _RanIt>
@@ -558,7 +1328,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _RanIt>::type partial_sort
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<_RanIt>::iterator_category>::value, "Required random access iterator.");
 
-	return details::_Partial_sort_copy_impl(_Policy, _First, _Last, _First2, _Last2, _Pred);
+	return details::_Partial_sort_copy_impl(_Policy, _First, _Last, _First2, _Last2, _Pred, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _InIt, class _RanIt>
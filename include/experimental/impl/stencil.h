@@ -0,0 +1,235 @@
+#pragma once
+
+#ifndef _IMPL_STENCIL_H_
+#define _IMPL_STENCIL_H_ 1
+
+#include "algorithm_impl.h"
+
+_PSTL_NS1_BEGIN
+// Neighbourhood of an element handed to the function of stencil: _Window(_Row, _Col) is the element _Row rows below
+// and _Col columns right of the centre
+template<typename _Ty>
+class stencil_window
+{
+	_Ty *_Center;
+	ptrdiff_t _Row_stride;
+	ptrdiff_t _Col_stride;
+public:
+	stencil_window(_Ty *_Ptr, ptrdiff_t _Rs, ptrdiff_t _Cs) : _Center(_Ptr), _Row_stride(_Rs), _Col_stride(_Cs)
+	{
+	}
+
+	_Ty& operator()(ptrdiff_t _Row, ptrdiff_t _Col) const
+	{
+		return _Center[_Row * _Row_stride + _Col * _Col_stride];
+	}
+};
+
+namespace details {
+	//
+	// stencil over two-dimensional views: the interior, the elements at least _Radius away from the edges, is cut into
+	// the tiles of for_each over bounds and the tiles are spread over the threads. A single pass reads the neighbours
+	// straight from the input. With several passes a tile copies its area and a halo of _Passes * _Radius elements
+	// into a buffer, runs all passes there while it is in the cache (every pass leaves a band of _Radius at the inner
+	// edges of the buffer stale) and writes the area to the output.
+	//
+	template<class _ExPolicy>
+	struct _Stencil_row
+	{
+		template<class _InTy, class _OutTy, class _Fn>
+		static void Loop(_InTy *_In, ptrdiff_t _In_rs, ptrdiff_t _In_cs, _OutTy *_Out, ptrdiff_t _Out_cs, ptrdiff_t _Count, _Fn& _Func)
+		{
+			for (ptrdiff_t _I = 0; _I < _Count; ++_I)
+				_Out[_I * _Out_cs] = _Func(stencil_window<_InTy>(_In + _I * _In_cs, _In_rs, _In_cs));
+		}
+	};
+
+	template<>
+	struct _Stencil_row<parallel_vector_execution_policy>
+	{
+		template<class _InTy, class _OutTy, class _Fn>
+		static void Loop(_InTy *_In, ptrdiff_t _In_rs, ptrdiff_t _In_cs, _OutTy *_Out, ptrdiff_t _Out_cs, ptrdiff_t _Count, _Fn& _Func)
+		{
+			_EXP_PRAGMA_VEC
+			for (ptrdiff_t _I = 0; _I < _Count; ++_I)
+				_Out[_I * _Out_cs] = _Func(stencil_window<_InTy>(_In + _I * _In_cs, _In_rs, _In_cs));
+		}
+	};
+
+	template<typename _InTy, typename _OutTy>
+	class _Stencil
+	{
+		typedef typename std::remove_const<_InTy>::type _ValTy;
+
+		_View_layout<_InTy, 2> _In;
+		_View_layout<_OutTy, 2> _Out;
+		ptrdiff_t _Radius;
+		size_t _Passes;
+		_Bounds_tiles<2> _Tiles;
+
+		static D4087::bounds<2> _Interior(const D4087::bounds<2>& _Bnd, ptrdiff_t _Radius)
+		{
+			D4087::bounds<2> _Inner;
+			for (int _I = 0; _I < 2; ++_I)
+				_Inner[_I] = (std::max)(ptrdiff_t{ 0 }, _Bnd[_I] - 2 * _Radius);
+			return _Inner;
+		}
+	public:
+		_Stencil(const _View_layout<_InTy, 2>& _In_layout, const _View_layout<_OutTy, 2>& _Out_layout, ptrdiff_t _R, size_t _P, ptrdiff_t _Min_tiles) :
+			_In(_In_layout), _Out(_Out_layout), _Radius(_R), _Passes(_P), _Tiles(_Interior(_In_layout._Bnd, _R), D4087::bounds<2>(), _Min_tiles)
+		{
+		}
+
+		ptrdiff_t tiles() const
+		{
+			return _Tiles.count();
+		}
+
+		// Computes the tile _Pos, _Buffer is the storage of the passes. Only std::true_type compiles the passes in
+		// buffers, the single pass may write another type than the one of _In.
+		template<class _ExPolicy, class _Fn, class _Fused>
+		void tile(ptrdiff_t _Pos, _Fn& _Func, std::vector<_ValTy>& _Buffer, _Fused) const
+		{
+			D4087::index<2> _Origin, _End;
+			_Tiles.area(_Pos, _Origin, _End);
+			for (int _I = 0; _I < 2; ++_I)
+			{
+				_Origin[_I] += _Radius;
+				_End[_I] += _Radius;
+			}
+			_Tile<_ExPolicy>(_Origin, _End, _Func, _Buffer, _Fused());
+		}
+	private:
+		template<class _ExPolicy, class _Fn>
+		void _Tile(const D4087::index<2>& _Origin, const D4087::index<2>& _End, _Fn& _Func, std::vector<_ValTy>&, std::false_type) const
+		{
+			for (ptrdiff_t _Row = _Origin[0]; _Row < _End[0]; ++_Row)
+			{
+				const D4087::index<2> _Start{ _Row, _Origin[1] };
+				_Stencil_row<_ExPolicy>::Loop(static_cast<const _ValTy *>(_In._Row(_Start)), _In._Stride[0], _In._Stride[1], _Out._Row(_Start), _Out._Stride[1], _End[1] - _Origin[1], _Func);
+			}
+		}
+
+		template<class _ExPolicy, class _Fn>
+		void _Tile(const D4087::index<2>& _Origin, const D4087::index<2>& _End, _Fn& _Func, std::vector<_ValTy>& _Buffer, std::true_type) const
+		{
+			if (_Passes == 1)
+			{
+				_Tile<_ExPolicy>(_Origin, _End, _Func, _Buffer, std::false_type());
+				return;
+			}
+
+			// The buffer holds the area with its halo, clipped to the bounds. Pass _Pass computes the part of the buffer
+			// _Pass * _Radius away from the inner edges, the elements closer than _Radius to the edges of the bounds
+			// keep the values of the input in both halves of the buffer.
+			const ptrdiff_t _Halo = static_cast<ptrdiff_t>(_Passes) * _Radius;
+			D4087::index<2> _First, _Last, _Size;
+			for (int _I = 0; _I < 2; ++_I)
+			{
+				_First[_I] = (std::max)(ptrdiff_t{ 0 }, _Origin[_I] - _Halo);
+				_Last[_I] = (std::min)(_In._Bnd[_I], _End[_I] + _Halo);
+				_Size[_I] = _Last[_I] - _First[_I];
+			}
+
+			const size_t _Area = static_cast<size_t>(_Size[0] * _Size[1]);
+			_Buffer.resize(2 * _Area);
+			_ValTy *_Src = _Buffer.data(), *_Dest = _Src + _Area;
+			for (ptrdiff_t _Row = 0; _Row < _Size[0]; ++_Row)
+			{
+				const _InTy *_Ptr = _In._Row(D4087::index<2>{ _First[0] + _Row, _First[1] });
+				for (ptrdiff_t _Col = 0; _Col < _Size[1]; ++_Col)
+					_Src[_Row * _Size[1] + _Col] = _Ptr[_Col * _In._Stride[1]];
+			}
+			std::copy(_Src, _Src + _Area, _Dest);
+
+			for (size_t _Pass = 1; _Pass <= _Passes; ++_Pass)
+			{
+				const ptrdiff_t _Inset = static_cast<ptrdiff_t>(_Pass) * _Radius;
+				D4087::index<2> _Lo, _Hi;
+				for (int _I = 0; _I < 2; ++_I)
+				{
+					_Lo[_I] = _First[_I] == 0 ? _Radius : _First[_I] + _Inset;
+					_Hi[_I] = _Last[_I] == _In._Bnd[_I] ? _In._Bnd[_I] - _Radius : _Last[_I] - _Inset;
+				}
+
+				for (ptrdiff_t _Row = _Lo[0]; _Row < _Hi[0]; ++_Row)
+				{
+					const ptrdiff_t _Offset = (_Row - _First[0]) * _Size[1] + _Lo[1] - _First[1];
+					_Stencil_row<_ExPolicy>::Loop(static_cast<const _ValTy *>(_Src + _Offset), _Size[1], 1, _Dest + _Offset, 1, _Hi[1] - _Lo[1], _Func);
+				}
+				std::swap(_Src, _Dest);
+			}
+
+			for (ptrdiff_t _Row = _Origin[0]; _Row < _End[0]; ++_Row)
+			{
+				const _ValTy *_Ptr = _Src + (_Row - _First[0]) * _Size[1] + _Origin[1] - _First[1];
+				_OutTy *_Dest_row = _Out._Row(D4087::index<2>{ _Row, _Origin[1] });
+				for (ptrdiff_t _Col = 0; _Col < _End[1] - _Origin[1]; ++_Col)
+					_Dest_row[_Col * _Out._Stride[1]] = _Ptr[_Col];
+			}
+		}
+	};
+
+	template <class _InTy, class _OutTy, class _Fn, class _Fused>
+	void _Stencil_impl(const sequential_execution_policy&, const _View_layout<_InTy, 2>& _In, const _View_layout<_OutTy, 2>& _Out, ptrdiff_t _Radius, size_t _Passes, _Fn _Func, _Fused)
+	{
+		_EXP_TRY
+			const _Stencil<_InTy, _OutTy> _Engine(_In, _Out, _Radius, _Passes, 0);
+			std::vector<typename std::remove_const<_InTy>::type> _Buffer;
+			for (ptrdiff_t _Pos = 0; _Pos < _Engine.tiles(); ++_Pos)
+				_Engine.template tile<sequential_execution_policy>(_Pos, _Func, _Buffer, _Fused());
+		_EXP_RETHROW
+	}
+
+	template <class _ExPolicy, class _InTy, class _OutTy, class _Fn, class _Fused>
+	void _Stencil_impl(const _ExPolicy&, const _View_layout<_InTy, 2>& _In, const _View_layout<_OutTy, 2>& _Out, ptrdiff_t _Radius, size_t _Passes, _Fn _Func, _Fused)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		const _Stencil<_InTy, _OutTy> _Engine(_In, _Out, _Radius, _Passes, 4 * static_cast<ptrdiff_t>(get_hardware_concurrency()));
+		if (_Engine.tiles() == 0)
+			return;
+
+		const D4087::bounds<1> _Tile_numbers(_Engine.tiles());
+		_Partitioner<_ExecutionPolicy>::_For_Each(_Tile_numbers.begin(), static_cast<size_t>(_Engine.tiles()), _Func,
+			[&_Engine](D4087::bounds_iterator<1> _Begin, size_t _Count, _Fn& _UserFunc){
+			std::vector<typename std::remove_const<_InTy>::type> _Buffer;
+			for (ptrdiff_t _Pos = (*_Begin)[0], _End = _Pos + static_cast<ptrdiff_t>(_Count); _Pos < _End; ++_Pos)
+				_Engine.template tile<_ExecutionPolicy>(_Pos, _UserFunc, _Buffer, _Fused());
+		});
+	}
+
+	template <class _InTy, class _OutTy, class _Fn, class _Fused>
+	inline void _Stencil_impl(const execution_policy& _Policy, const _View_layout<_InTy, 2>& _In, const _View_layout<_OutTy, 2>& _Out, ptrdiff_t _Radius, size_t _Passes, _Fn _Func, _Fused _Tag)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Stencil_impl, _Policy, _In, _Out, _Radius, _Passes, _Func, _Tag);
+	}
+} // details
+
+// Sets every element of the two-dimensional view _Out at least _Radius away from its edges to _Func(w), where w is the
+// stencil_window of _In around the same position. The other elements of _Out are not written, _Out has the bounds of
+// _In and does not overlap it.
+template <class _ExPolicy, class _InView, class _OutView, class _Fn>
+inline typename details::_enable_if_view<_ExPolicy, _InView, void>::type stencil(_ExPolicy&& _Policy, const _InView& _In, const _OutView& _Out, ptrdiff_t _Radius, _Fn _Func)
+{
+	static_assert(_InView::rank == 2 && _OutView::rank == 2, "stencil works on two-dimensional views.");
+	static_assert(details::_Is_array_view<typename std::decay<_OutView>::type>::value, "Required array_view or strided_array_view.");
+
+	_ASSERT(_In.bounds() == _Out.bounds() && _Radius >= 0);
+	details::_Stencil_impl(_Policy, details::_Make_view_layout(_In), details::_Make_view_layout(_Out), _Radius, 1, _Func, std::false_type());
+}
+
+// _Passes applications of the stencil, each one to the result of the previous one. The tiles run all passes in
+// buffers of their own, thus _Func returns the element type of _In.
+template <class _ExPolicy, class _InView, class _OutView, class _Fn>
+inline typename details::_enable_if_view<_ExPolicy, _InView, void>::type stencil(_ExPolicy&& _Policy, const _InView& _In, const _OutView& _Out, ptrdiff_t _Radius, size_t _Passes, _Fn _Func)
+{
+	static_assert(_InView::rank == 2 && _OutView::rank == 2, "stencil works on two-dimensional views.");
+	static_assert(details::_Is_array_view<typename std::decay<_OutView>::type>::value, "Required array_view or strided_array_view.");
+
+	_ASSERT(_In.bounds() == _Out.bounds() && _Radius >= 0);
+	details::_Stencil_impl(_Policy, details::_Make_view_layout(_In), details::_Make_view_layout(_Out), _Radius, _Passes, _Func, std::true_type());
+}
+_PSTL_NS1_END // std::experimental::parallel
+
+#endif // _IMPL_STENCIL_H_
@@ -40,7 +40,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt2>::type swap_ranges
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt2>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::common_iterator<_FwdIt, _FwdIt2>::iterator_category _Cat;
+	typename details::common_iterator<_FwdIt, _FwdIt2>::iterator_category _Cat;
 	return details::_Swap_ranges_impl(_Policy, _First, _Last, _First2, _Cat);
 }
 _PSTL_NS1_END // std::experimental::parallel
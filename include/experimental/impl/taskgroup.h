@@ -7,6 +7,7 @@
 #include <mutex>
 #include <random>
 #include <limits>
+#include <climits>
 #include <list>
 #include <type_traits>
 #include "event.h"
@@ -21,24 +22,15 @@ namespace details
 	class WorkChoreBase
 	{
 		TaskGroup *m_taskGroup;
-		WorkChoreBase *m_prev;
-		std::atomic<WorkChoreBase*> m_next;
 		friend class TaskGroup;
 		friend class WorkStealingQueue;
 
 		inline void run(bool isAsync);
 
-		inline WorkChoreBase * tryStealNextChore();
-
-		inline bool tryClaimThisChore();
-
-		inline WorkStealingQueue * getWorkStealingQueue();
-
 	protected:
 		virtual void __cdecl userFunc() = 0;
-		WorkChoreBase() : m_prev(nullptr), m_taskGroup(nullptr)
+		WorkChoreBase() : m_taskGroup(nullptr)
 		{
-			_ASSERT(m_next.load() == nullptr);
 		}
 	};
 
@@ -66,10 +58,9 @@ namespace details
 	{
 		static const int MaximalChoreNum = INT_MAX - 1; // preventing overflow
 
-		WorkChoreBase *m_head, *m_tail;
 		WorkStealingQueue *m_queue;
+		intptr_t m_queueBottom; // chores of this group are queued at or above this position, possibly among those of later groups
 		int m_choreCounter;
-		bool m_needReleaseWSQ;
 		std::atomic<int> m_pendingChore;
 		Event m_event;
 
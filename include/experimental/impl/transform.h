@@ -122,8 +122,6 @@ namespace details {
 	template <class _ExPolicy, class _InIt, class _OutIt, class _Fn, class _IterCat>
 	_OutIt _Transform_impl(const _ExPolicy&, _InIt _First, _InIt _Last, _OutIt _Dest, _Fn _Func, _IterCat)
 	{
-		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
-
 		if (_First != _Last) {
 			return std::get<1>(*_Partitioner<_ExPolicy>::_For_Each(make_composable_iterator(_First, _Dest), std::distance(_First, _Last), _Func,
 				[](composable_iterator<_InIt, _OutIt> _Begin, size_t _Count, _Fn& _UserFunc) {
@@ -183,15 +181,64 @@ namespace details {
 	{
 		_EXP_GENERIC_EXECUTION_POLICY(_Transform_impl_binary, _Policy, _First, _Last, _First2, _Dest, _Func, _Cat);
 	}
+
+	//
+	// transform over array_view and strided_array_view, the views have the same bounds
+	//
+	template<class _ExPolicy, class _Ty, class _OutTy, int _Rank, class _Fn>
+	void _Transform_view_loop(const _View_layout<_Ty, _Rank>& _In, const _View_layout<_OutTy, _Rank>& _Out, ptrdiff_t _First, ptrdiff_t _Count, _Fn& _Func)
+	{
+		const ptrdiff_t _In_stride = _In._Stride[_Rank - 1], _Out_stride = _Out._Stride[_Rank - 1];
+		auto _Row_fn = [&](const D4087::index<_Rank>& _Origin, ptrdiff_t _Length) {
+			_Ty *_Src = _In._Row(_Origin);
+			_OutTy *_Dest = _Out._Row(_Origin);
+			if (_In_stride == 1 && _Out_stride == 1)
+				_Transform_helper<_ExPolicy, std::random_access_iterator_tag>::Loop(_Src, static_cast<size_t>(_Length), _Dest, _Func);
+			else
+			{
+				for (ptrdiff_t _I = 0; _I < _Length; ++_I, _Src += _In_stride, _Dest += _Out_stride)
+					*_Dest = _Func(*_Src);
+			}
+		};
+
+		_For_each_view_row(_In._Bnd, _First, _Count, _Row_fn);
+	}
+
+	template<class _Ty, class _OutTy, int _Rank, class _Fn>
+	void _Transform_view_impl(const sequential_execution_policy&, const _View_layout<_Ty, _Rank>& _In, const _View_layout<_OutTy, _Rank>& _Out, _Fn _Func)
+	{
+		_EXP_TRY
+			_Transform_view_loop<sequential_execution_policy>(_In, _Out, 0, _In._Bnd[0], _Func);
+		_EXP_RETHROW
+	}
+
+	template<class _ExPolicy, class _Ty, class _OutTy, int _Rank, class _Fn>
+	void _Transform_view_impl(const _ExPolicy&, const _View_layout<_Ty, _Rank>& _In, const _View_layout<_OutTy, _Rank>& _Out, _Fn _Func)
+	{
+		typedef typename std::decay<_ExPolicy>::type _ExecutionPolicy;
+
+		if (_In._Bnd.size() == 0)
+			return;
+
+		_For_each_view_part<_ExecutionPolicy>(_In._Bnd[0], _Func, [&_In, &_Out](ptrdiff_t _First, ptrdiff_t _Count, _Fn& _UserFunc) {
+			_Transform_view_loop<_ExecutionPolicy>(_In, _Out, _First, _Count, _UserFunc);
+		});
+	}
+
+	template<class _Ty, class _OutTy, int _Rank, class _Fn>
+	void _Transform_view_impl(const execution_policy& _Policy, const _View_layout<_Ty, _Rank>& _In, const _View_layout<_OutTy, _Rank>& _Out, _Fn _Func)
+	{
+		_EXP_GENERIC_EXECUTION_POLICY(_Transform_view_impl, _Policy, _In, _Out, _Func);
+	}
 } // details
 
 template <class _ExPolicy, class _InIt, class _OutIt, class _Fn>
 inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type transform(_ExPolicy&& _Policy, _InIt _First, _InIt _Last, _OutIt _Dest, _Fn _Func)
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _OutIt>::iterator_category _Cat;
 	return details::_Transform_impl(_Policy, _First, _Last, _Dest, _Func, _Cat);
 }
 
@@ -200,11 +247,22 @@ inline typename details::_enable_if_policy<_ExPolicy, _OutIt>::type transform(_E
 {
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt2>::iterator_category>::value, "Required input iterator or stronger.");
-	static_assert(std::is_base_of<std::_Mutable_iterator_tag, typename std::iterator_traits<_OutIt>::iterator_category>::value, "Required output iterator or stronger.");
+	static_assert(details::_Is_mutable_iterator<_OutIt>::value, "Required output iterator or stronger.");
 
-	details::common_iterator<_InIt, _InIt2, _OutIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _InIt2, _OutIt>::iterator_category _Cat;
 	return details::_Transform_impl_binary(_Policy, _First, _Last, _First2, _Dest, _Func, _Cat);
 }
+
+// Writes _Func of every element of the array_view or strided_array_view _In to the same index of _Out
+template <class _ExPolicy, class _InView, class _OutView, class _Fn>
+inline typename details::_enable_if_view<_ExPolicy, _InView, void>::type transform(_ExPolicy&& _Policy, const _InView& _In, const _OutView& _Out, _Fn _Func)
+{
+	static_assert(details::_Is_array_view<_OutView>::value, "Required array_view or strided_array_view.");
+	static_assert(_InView::rank == _OutView::rank, "Required views of the same rank.");
+	_ASSERT(_In.bounds() == _Out.bounds());
+
+	details::_Transform_view_impl(_Policy, details::_Make_view_layout(_In), details::_Make_view_layout(_Out), _Func);
+}
 _PSTL_NS1_END // std::experimental::parallel
 
 #endif // _IMPL_TRANSFORM_H_
@@ -21,7 +21,7 @@ namespace details {
 	template<class _ExPolicy, class _InIt, class _Diff, class _FwdIt, class _IterCat>
 	inline _FwdIt _Uninitialized_copy_n_impl(const _ExPolicy&, _InIt _First, _Diff _Count, _FwdIt _Dest, _IterCat)
 	{
-		typedef std::iterator_traits<_FwdIt>::value_type value_type;
+		typedef typename std::iterator_traits<_FwdIt>::value_type value_type;
 
 		return std::get<1>(*_Partitioner<static_partitioner_tag>::_For_each_with_cleanup(make_composable_iterator(_First, _Dest), _Count, std::tuple<>(),
 			[](composable_iterator<_InIt, _FwdIt> _Begin, size_t _Partition_size, std::tuple<>) {
@@ -85,7 +85,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type uninitialize
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::common_iterator<_InIt, _FwdIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _FwdIt>::iterator_category _Cat;
 	return details::_Uninitialized_copy_n_impl(_Policy, _First, _Count, _Dest, _Cat);
 }
 
@@ -95,7 +95,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type uninitialize
 	static_assert(std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_InIt>::iterator_category>::value, "Required input iterator or stronger.");
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::common_iterator<_InIt, _FwdIt>::iterator_category _Cat;
+	typename details::common_iterator<_InIt, _FwdIt>::iterator_category _Cat;
 	return details::_Uninitialized_copy_impl(_Policy, _First, _Last, _Dest, _Cat);
 }
 _PSTL_NS1_END// std::experimental::parallel
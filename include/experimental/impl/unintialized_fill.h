@@ -21,7 +21,7 @@ namespace details {
 	template<class _ExPolicy, class _FwdIt, class _Diff, class _Ty, class _IterCat>
 	inline _FwdIt _Uninitialized_fill_n_impl(const _ExPolicy&, _FwdIt _First, _Diff _Count, const _Ty& _Init, _IterCat)
 	{
-		typedef std::iterator_traits<_FwdIt>::value_type value_type;
+		typedef typename std::iterator_traits<_FwdIt>::value_type value_type;
 
 		return _Partitioner<static_partitioner_tag>::_For_each_with_cleanup(_First, _Count, std::tuple<>(),
 			[&_Init](_FwdIt _Begin, size_t _Partition_size, std::tuple<>) {
@@ -70,7 +70,7 @@ inline typename details::_enable_if_policy<_ExPolicy, _FwdIt>::type uninitialize
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	return details::_Uninitialized_fill_n_impl(_Policy, _First, _Count, _Init, std::_Iter_cat(_First));
+	return details::_Uninitialized_fill_n_impl(_Policy, _First, _Count, _Init, details::_Iter_cat(_First));
 }
 
 template<class _ExPolicy, class _FwdIt, class _Ty>
@@ -78,7 +78,7 @@ inline typename details::_enable_if_policy<_ExPolicy, void>::type uninitialized_
 {
 	static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_FwdIt>::iterator_category>::value, "Required forward iterator or stronger.");
 
-	details::_Uninitialized_fill_impl(_Policy, _First, _Last, _Init, std::_Iter_cat(_First));
+	details::_Uninitialized_fill_impl(_Policy, _First, _Last, _Init, details::_Iter_cat(_First));
 }
 _PSTL_NS1_END// std::experimental::parallel
 
@@ -1,14 +1,17 @@
-#pragma once
-
 #include <atomic>
+#include <cstring>
 #include <experimental/impl/algorithm_impl.h>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
 _PSTL_NS1_BEGIN
 
 namespace details {
 	namespace
 	{
-		__declspec(thread) _Contextaware_waitable_chore * _Thread_chore_context;
+		_PSTL_THREAD_LOCAL _Contextaware_waitable_chore * _Thread_chore_context;
 
 		// We need to limit the global over-subscription to linear size.
 		// Please note that *5 is just an arbitrary choice that fits in
@@ -16,6 +19,153 @@ namespace details {
 		// a little bit more linear over-subscription won't hurt.
 		size_t _Max_global_chore_num = get_hardware_concurrency() * 5;
 		atomic<size_t> _Global_chore_num;
+
+		// Worker slots of combinable, twice the number of hardware threads as the hashed buckets used to have.
+		// Threads beyond that (an oversubscribed OS thread pool) fall back to the combinable overflow list.
+		const unsigned int _Max_worker_slot_count = 256;
+		std::atomic<bool> _Worker_slot_in_use[_Max_worker_slot_count];
+
+		// Computed on first use, the static initializers of other translation units may already ask for it
+		unsigned int _Worker_slot_count()
+		{
+			static const unsigned int _Count = get_hardware_concurrency() * 2 < _Max_worker_slot_count ? get_hardware_concurrency() * 2 : _Max_worker_slot_count;
+			return _Count;
+		}
+
+		unsigned int _Claim_worker_slot()
+		{
+			// Always search from the bottom so that the slots in use stay dense and combinable scans few of them
+			for (unsigned int _Index = 0; _Index < _Worker_slot_count(); ++_Index)
+			{
+				bool _Expected = false;
+				if (!_Worker_slot_in_use[_Index].load(std::memory_order_relaxed) && _Worker_slot_in_use[_Index].compare_exchange_strong(_Expected, true, std::memory_order_acquire))
+					return _Index;
+			}
+			return _Worker_slot_count();
+		}
+
+		void _Release_worker_slot(unsigned int _Index)
+		{
+			if (_Index < _Worker_slot_count())
+				_Worker_slot_in_use[_Index].store(false, std::memory_order_release);
+		}
+
+		// The slot is kept off by one in TLS, 0 means the thread has not claimed one yet
+#if defined(_WIN32)
+		_PSTL_THREAD_LOCAL unsigned int _Thread_worker_slot;
+
+		// __declspec(thread) has no destructors, a fiber local storage callback gives the slot back on thread exit
+		void WINAPI _Release_worker_slot_callback(PVOID _Slot)
+		{
+			if (_Slot != nullptr)
+				_Release_worker_slot(static_cast<unsigned int>(reinterpret_cast<uintptr_t>(_Slot)) - 1);
+		}
+
+		DWORD _Worker_slot_fls_index = ::FlsAlloc(_Release_worker_slot_callback);
+
+		unsigned int _Bound_worker_slot()
+		{
+			return _Thread_worker_slot;
+		}
+
+		void _Bind_worker_slot(unsigned int _Index)
+		{
+			_Thread_worker_slot = _Index + 1;
+			::FlsSetValue(_Worker_slot_fls_index, reinterpret_cast<PVOID>(static_cast<uintptr_t>(_Index + 1)));
+		}
+#else
+		struct _Worker_slot_binding
+		{
+			unsigned int _Slot;
+
+			~_Worker_slot_binding()
+			{
+				if (_Slot != 0)
+					_Release_worker_slot(_Slot - 1);
+			}
+		};
+
+		thread_local _Worker_slot_binding _Thread_worker_binding = { 0 };
+
+		unsigned int _Bound_worker_slot()
+		{
+			return _Thread_worker_binding._Slot;
+		}
+
+		void _Bind_worker_slot(unsigned int _Index)
+		{
+			_Thread_worker_binding._Slot = _Index + 1;
+		}
+#endif
+
+		// Recycled slot blocks of one cache line stride, enough for a few nested or concurrent reductions
+		const size_t _Slot_block_cache_size = 16;
+		std::atomic<void *> _Slot_block_cache[_Slot_block_cache_size];
+
+		void *_Allocate_slot_block(size_t _Size)
+		{
+			// operator new aligns to at least the size of a pointer, there is always room for the raw pointer
+			char *_Raw = static_cast<char *>(::operator new(_Size + 64));
+			char *_Block = _Raw + 64 - (reinterpret_cast<uintptr_t>(_Raw) & 63);
+			reinterpret_cast<char **>(_Block)[-1] = _Raw;
+			memset(_Block, 0, _Size);
+			return _Block;
+		}
+
+		void _Free_slot_block(void *_Block)
+		{
+			::operator delete(reinterpret_cast<char **>(_Block)[-1]);
+		}
+	}
+
+	_EXP_IMPL unsigned int __cdecl get_worker_slot_count()
+	{
+		return _Worker_slot_count();
+	}
+
+	_EXP_IMPL unsigned int __cdecl get_current_worker_slot()
+	{
+		unsigned int _Slot = _Bound_worker_slot();
+		if (_Slot != 0)
+			return _Slot - 1;
+
+		unsigned int _Index = _Claim_worker_slot();
+		if (_Index < _Worker_slot_count())
+			_Bind_worker_slot(_Index);
+		return _Index;
+	}
+
+	_EXP_IMPL void * __cdecl _Acquire_slot_block(size_t _Stride)
+	{
+		if (_Stride == 64)
+		{
+			for (auto &_Cached : _Slot_block_cache)
+			{
+				if (_Cached.load(std::memory_order_relaxed) == nullptr)
+					continue;
+				// Zeroed again, the last owner may have held another type and left values where the constructed
+				// flags of this one are
+				if (void *_Block = _Cached.exchange(nullptr, std::memory_order_acquire))
+					return memset(_Block, 0, _Worker_slot_count() * _Stride);
+			}
+		}
+
+		return _Allocate_slot_block(_Worker_slot_count() * _Stride);
+	}
+
+	_EXP_IMPL void __cdecl _Release_slot_block(void *_Block, size_t _Stride)
+	{
+		if (_Stride == 64)
+		{
+			for (auto &_Cached : _Slot_block_cache)
+			{
+				void *_Expected = nullptr;
+				if (_Cached.load(std::memory_order_relaxed) == nullptr && _Cached.compare_exchange_strong(_Expected, _Block, std::memory_order_release))
+					return;
+			}
+		}
+
+		_Free_slot_block(_Block);
 	}
 
 
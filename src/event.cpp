@@ -1,35 +1,48 @@
-#include <experimental\impl\event.h>
-#include <Windows.h>
+#include <experimental/impl/event.h>
+#include "futex.h"
 
 _PSTL_NS1_BEGIN
 namespace details {
-	static_assert(sizeof(SRWLOCK) == sizeof(intptr_t), "Space for SRWLOCK is not enough");
-	static_assert(sizeof(CONDITION_VARIABLE) == sizeof(intptr_t), "Space for CONDITION_VARIABLE is not enough");
+	namespace
+	{
+		// Roughly a few microseconds of pause instructions, enough to catch the last chunk of a
+		// small fork-join finishing without paying for a sleep and a wake up.
+		const int EventSpinCount = 4000;
+	}
 
-	_EXP_IMPL Event::Event() : m_isSet(false)
+	_EXP_IMPL Event::Event() : m_state(EventNotSet)
 	{
-		InitializeSRWLock(reinterpret_cast<PSRWLOCK>(&m_lock));
-		InitializeConditionVariable(reinterpret_cast<PCONDITION_VARIABLE>(&m_cond));
 	}
 
 	_EXP_IMPL void __cdecl Event::wait()
 	{
-		AcquireSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&m_lock));
-		while (!m_isSet)
+		if (is_set())
+			return;
+
+		// Spinning only makes sense if the setter can run at the same time
+		if (get_hardware_concurrency() > 1)
 		{
-			SleepConditionVariableSRW(reinterpret_cast<PCONDITION_VARIABLE>(&m_cond), reinterpret_cast<PSRWLOCK>(&m_lock),
-				INFINITE, 0);
+			for (int i = 0; i < EventSpinCount; ++i)
+			{
+				_Cpu_relax();
+				if (is_set())
+					return;
+			}
 		}
-		ReleaseSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&m_lock));
 
+		// Announce the waiter, then park until set() flips the state
+		int state = EventNotSet;
+		if (!m_state.compare_exchange_strong(state, EventWaiters, std::memory_order_acquire) && state == EventSet)
+			return;
+
+		while (m_state.load(std::memory_order_acquire) != EventSet)
+			_Futex_wait(&m_state, EventWaiters);
 	}
 
 	_EXP_IMPL void __cdecl Event::set()
 	{
-		AcquireSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&m_lock));
-		m_isSet = true;
-		WakeAllConditionVariable(reinterpret_cast<PCONDITION_VARIABLE>(&m_cond));
-		ReleaseSRWLockExclusive(reinterpret_cast<PSRWLOCK>(&m_lock));
+		if (m_state.exchange(EventSet, std::memory_order_release) == EventWaiters)
+			_Futex_wake(&m_state);
 	}
 } // std::experimental::parallel::details
 _PSTL_NS1_END
@@ -0,0 +1,95 @@
+#pragma once
+
+#ifndef _SRC_FUTEX_H_
+#define _SRC_FUTEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <experimental/impl/defines.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+_PSTL_NS1_BEGIN
+namespace details {
+
+	static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex word must be a plain int");
+
+	inline void _Cpu_relax()
+	{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+		_mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+#if defined(__linux__)
+	// Blocks while *_Addr == _Expected. Spurious wakeups are possible, the caller must re-check its condition.
+	inline void _Futex_wait(std::atomic<int> *_Addr, int _Expected)
+	{
+		::syscall(SYS_futex, reinterpret_cast<int *>(_Addr), FUTEX_WAIT_PRIVATE, _Expected, nullptr, nullptr, 0);
+	}
+
+	inline void _Futex_wake(std::atomic<int> *_Addr, int _Count = INT_MAX)
+	{
+		::syscall(SYS_futex, reinterpret_cast<int *>(_Addr), FUTEX_WAKE_PRIVATE, _Count, nullptr, nullptr, 0);
+	}
+#else
+	// Emulation of the futex interface with a small table of hashed condition variables
+	struct _Futex_bucket
+	{
+		std::mutex _Lock;
+		std::condition_variable _Cond;
+	};
+
+	// Template static member so that every translation unit shares one table, initialized at load time
+	// rather than on first use (local statics are not thread safe on VS2013)
+	template <typename _Dummy = void>
+	struct _Futex_table
+	{
+		static _Futex_bucket _Buckets[64];
+	};
+
+	template <typename _Dummy>
+	_Futex_bucket _Futex_table<_Dummy>::_Buckets[64];
+
+	inline _Futex_bucket& _Futex_get_bucket(const void *_Addr)
+	{
+		return _Futex_table<>::_Buckets[(reinterpret_cast<uintptr_t>(_Addr) >> 4) % 64];
+	}
+
+	inline void _Futex_wait(std::atomic<int> *_Addr, int _Expected)
+	{
+		auto &_Bucket = _Futex_get_bucket(_Addr);
+		std::unique_lock<std::mutex> _Guard(_Bucket._Lock);
+		if (_Addr->load() == _Expected)
+			_Bucket._Cond.wait(_Guard);
+	}
+
+	inline void _Futex_wake(std::atomic<int> *_Addr, int = 0)
+	{
+		auto &_Bucket = _Futex_get_bucket(_Addr);
+		// Taking the lock orders the wake after a concurrent waiter either saw the new value or went to sleep
+		std::lock_guard<std::mutex> _Guard(_Bucket._Lock);
+		_Bucket._Cond.notify_all();
+	}
+#endif
+
+} // std::experimental::parallel::details
+_PSTL_NS1_END
+
+#endif // _SRC_FUTEX_H_
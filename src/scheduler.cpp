@@ -1,7 +1,10 @@
 #include <thread>
-#include <Windows.h>
 #include <experimental/impl/algorithm_scheduler.h>
 
+#ifndef _PSTL_THREAD_SCHEDULER
+
+#include <Windows.h>
+
 _PSTL_NS1_BEGIN
 namespace details {
 
@@ -36,6 +39,12 @@ namespace details {
 		::SubmitThreadpoolWork(static_cast<PTP_WORK>(_Chore->_Work));
 	}
 
+	_EXP_IMPL bool __cdecl try_execute_chore()
+	{
+		// Win32 thread pool injects threads for blocked callbacks, there is no queue to help with
+		return false;
+	}
+
 	_EXP_IMPL unsigned int __cdecl get_current_thread_id()
 	{
 		return GetCurrentThreadId();
@@ -43,3 +52,5 @@ namespace details {
 } // std::experimental::parallel::details
 _PSTL_NS1_END
 
+#endif // _PSTL_THREAD_SCHEDULER
+
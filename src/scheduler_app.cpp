@@ -81,6 +81,11 @@ namespace details {
 		return std::this_thread::yield();
 	}
 
+	_EXP_IMPL bool __cdecl try_execute_chore()
+	{
+		return false;
+	}
+
 	_EXP_IMPL unsigned int __cdecl get_current_thread_id()
 	{
 		return GetCurrentThreadId();
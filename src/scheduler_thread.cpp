@@ -0,0 +1,356 @@
+#include <experimental/impl/algorithm_scheduler.h>
+
+#ifdef _PSTL_THREAD_SCHEDULER
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "futex.h"
+#include "workstealing_deque.h"
+#include "topology.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+_PSTL_NS1_BEGIN
+namespace details {
+
+	namespace
+	{
+		// 1-based index of the pool worker running on this thread, 0 for any other thread
+		_PSTL_THREAD_LOCAL unsigned int tls_workerIndex;
+
+		std::vector<unsigned int> _Get_available_cpus()
+		{
+			std::vector<unsigned int> _Cpus;
+#if defined(__linux__)
+			cpu_set_t _Set;
+			CPU_ZERO(&_Set);
+			if (::sched_getaffinity(0, sizeof(_Set), &_Set) == 0)
+			{
+				for (unsigned int _Cpu = 0; _Cpu < CPU_SETSIZE; ++_Cpu)
+					if (CPU_ISSET(_Cpu, &_Set))
+						_Cpus.push_back(_Cpu);
+			}
+#endif
+			if (_Cpus.empty())
+			{
+				for (unsigned int _Cpu = 0; _Cpu < get_hardware_concurrency(); ++_Cpu)
+					_Cpus.push_back(_Cpu);
+			}
+			return _Cpus;
+		}
+
+		void _Pin_current_thread(unsigned int _Cpu)
+		{
+#if defined(__linux__)
+			cpu_set_t _Set;
+			CPU_ZERO(&_Set);
+			CPU_SET(_Cpu, &_Set);
+			::pthread_setaffinity_np(::pthread_self(), sizeof(_Set), &_Set);
+#elif defined(_WIN32)
+			if (_Cpu < sizeof(DWORD_PTR) * 8)
+				::SetThreadAffinityMask(::GetCurrentThread(), static_cast<DWORD_PTR>(1) << _Cpu);
+#else
+			(_Cpu);
+#endif
+		}
+	}
+
+	// Fixed pool of worker threads, one per available CPU, each one pinned to its CPU and owning a
+	// Chase-Lev deque. Chores scheduled from a worker are pushed to its own deque, chores scheduled
+	// from any other thread go through a shared injection queue. Idle workers steal, spin for a while
+	// and then park on a futex; producers only issue a wake syscall if some worker is parked.
+	class _Thread_scheduler
+	{
+		static const int _Spin_count = 64;
+
+		struct _Worker
+		{
+			_Workstealing_deque<_Threadpool_chore> _Queue;
+			std::thread _Thread;
+			unsigned int _Cpu;
+			unsigned int _Seed;
+			// other workers bucketed by distance, nearest first
+			std::vector<size_t> _Victims[_Cpu_distance_count];
+
+			_Worker(unsigned int _C) : _Cpu(_C), _Seed(_C * 2654435761u + 1) {}
+		};
+
+		std::vector<std::unique_ptr<_Worker>> _Workers;
+
+		std::mutex _Inject_lock;
+		std::deque<_Threadpool_chore *> _Injected;
+		std::atomic<size_t> _Injected_count;
+
+		std::atomic<int> _Wake_epoch;
+		std::atomic<int> _Sleepers;
+		std::atomic<bool> _Shutdown;
+
+		static unsigned int _Next_random(unsigned int &_Seed)
+		{
+			// xorshift32
+			_Seed ^= _Seed << 13;
+			_Seed ^= _Seed >> 17;
+			_Seed ^= _Seed << 5;
+			return _Seed;
+		}
+
+		_Threadpool_chore *_Take_injected()
+		{
+			if (_Injected_count.load(std::memory_order_relaxed) == 0)
+				return nullptr;
+
+			std::lock_guard<std::mutex> _Guard(_Inject_lock);
+			if (_Injected.empty())
+				return nullptr;
+
+			auto _Chore = _Injected.front();
+			_Injected.pop_front();
+			_Injected_count.fetch_sub(1, std::memory_order_relaxed);
+			return _Chore;
+		}
+
+		_Threadpool_chore *_Steal(size_t _Self, unsigned int &_Seed)
+		{
+			const size_t _Num = _Workers.size();
+			if (_Self >= _Num)
+			{
+				// not a pool thread, no locality to preserve
+				const size_t _Start = _Next_random(_Seed) % _Num;
+				for (size_t _I = 0; _I < _Num; ++_I)
+				{
+					if (auto _Chore = _Workers[(_Start + _I) % _Num]->_Queue.steal())
+						return _Chore;
+				}
+				return nullptr;
+			}
+
+			// Workers sharing the last level cache first, then the socket, then remote sockets
+			for (int _Level = 0; _Level < _Cpu_distance_count; ++_Level)
+			{
+				const auto &_Victims = _Workers[_Self]->_Victims[_Level];
+				if (_Victims.empty())
+					continue;
+
+				const size_t _Start = _Next_random(_Seed) % _Victims.size();
+				for (size_t _I = 0; _I < _Victims.size(); ++_I)
+				{
+					if (auto _Chore = _Workers[_Victims[(_Start + _I) % _Victims.size()]]->_Queue.steal())
+					{
+						_Record_steal(static_cast<_Cpu_distance>(_Level));
+						return _Chore;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		// _Self is the 0-based worker index or _Workers.size() for threads outside of the pool
+		_Threadpool_chore *_Find_work(size_t _Self, unsigned int &_Seed)
+		{
+			if (_Self < _Workers.size())
+			{
+				if (auto _Chore = _Workers[_Self]->_Queue.pop())
+					return _Chore;
+			}
+
+			if (auto _Chore = _Take_injected())
+				return _Chore;
+
+			return _Steal(_Self, _Seed);
+		}
+
+		bool _Has_work() const
+		{
+			if (_Injected_count.load(std::memory_order_relaxed) != 0)
+				return true;
+
+			for (auto &_W : _Workers)
+				if (!_W->_Queue.empty())
+					return true;
+
+			return false;
+		}
+
+		void _Notify()
+		{
+			// Pairs with the fence in _Park: either the parking worker sees the new chore,
+			// or we see it registered as a sleeper and wake it up.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (_Sleepers.load(std::memory_order_relaxed) > 0)
+			{
+				_Wake_epoch.fetch_add(1, std::memory_order_relaxed);
+				_Futex_wake(&_Wake_epoch, 1);
+			}
+		}
+
+		void _Park()
+		{
+			for (int _I = 0; _I < _Spin_count; ++_I)
+			{
+				if (_Has_work() || _Shutdown.load(std::memory_order_relaxed))
+					return;
+				_Cpu_relax();
+			}
+
+			int _Epoch = _Wake_epoch.load(std::memory_order_relaxed);
+			_Sleepers.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (!_Has_work() && !_Shutdown.load(std::memory_order_relaxed))
+				_Futex_wait(&_Wake_epoch, _Epoch);
+
+			_Sleepers.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void _Worker_main(size_t _Index)
+		{
+			_Worker &_Self = *_Workers[_Index];
+			tls_workerIndex = static_cast<unsigned int>(_Index + 1);
+			_Pin_current_thread(_Self._Cpu);
+
+			while (!_Shutdown.load(std::memory_order_acquire))
+			{
+				if (auto _Chore = _Find_work(_Index, _Self._Seed))
+					_Chore->invoke();
+				else
+					_Park();
+			}
+		}
+
+	public:
+		_Thread_scheduler() : _Injected_count(0), _Wake_epoch(0), _Sleepers(0), _Shutdown(false)
+		{
+			auto _Cpus = _Get_available_cpus();
+
+			_Workers.reserve(_Cpus.size());
+			for (auto _Cpu : _Cpus)
+				_Workers.emplace_back(new _Worker(_Cpu));
+
+			const _Cpu_topology &_Topology = _Cpu_topology::get();
+			for (size_t _I = 0; _I < _Workers.size(); ++_I)
+				for (size_t _J = 0; _J < _Workers.size(); ++_J)
+					if (_I != _J)
+						_Workers[_I]->_Victims[_Topology.distance(_Workers[_I]->_Cpu, _Workers[_J]->_Cpu)].push_back(_J);
+
+			// Workers read _Workers, thus start them only once the vector is complete
+			for (size_t _I = 0; _I < _Workers.size(); ++_I)
+				_Workers[_I]->_Thread = std::thread(&_Thread_scheduler::_Worker_main, this, _I);
+		}
+
+		~_Thread_scheduler()
+		{
+			_Shutdown.store(true, std::memory_order_release);
+			_Wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+			_Futex_wake(&_Wake_epoch);
+
+			for (auto &_W : _Workers)
+			{
+#if defined(_WIN32)
+				// Joining under the loader lock during DLL unload would deadlock
+				_W->_Thread.detach();
+#else
+				_W->_Thread.join();
+#endif
+			}
+		}
+
+		void _Submit(_Threadpool_chore *_Chore)
+		{
+			unsigned int _Self = tls_workerIndex;
+			if (_Self != 0)
+			{
+				_Workers[_Self - 1]->_Queue.push(_Chore);
+			}
+			else
+			{
+				std::lock_guard<std::mutex> _Guard(_Inject_lock);
+				_Injected.push_back(_Chore);
+				_Injected_count.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			_Notify();
+		}
+
+		bool _Try_execute_one()
+		{
+			unsigned int _Self = tls_workerIndex;
+			_Threadpool_chore *_Chore;
+			if (_Self != 0)
+			{
+				_Chore = _Find_work(_Self - 1, _Workers[_Self - 1]->_Seed);
+			}
+			else
+			{
+				unsigned int _Seed = get_current_thread_id() | 1;
+				_Chore = _Find_work(_Workers.size(), _Seed);
+			}
+
+			if (_Chore == nullptr)
+				return false;
+
+			_Chore->invoke();
+			return true;
+		}
+	};
+
+	// Constructed on first use. The workers reach the topology and the work stealing queues until they are
+	// joined here, neither of them is ever destroyed.
+	_Thread_scheduler &_Scheduler()
+	{
+		static _Thread_scheduler _SchedulerIns;
+		return _SchedulerIns;
+	}
+
+	_EXP_IMPL _Threadpool_chore::~_Threadpool_chore()
+	{
+		// Chores are owned by the caller, the pool only keeps raw pointers while they are queued
+		_Work = nullptr;
+	}
+
+	_EXP_IMPL void __cdecl _Threadpool_chore::reschedule()
+	{
+		_ASSERT(_Work == &_Scheduler());
+		_Scheduler()._Submit(this);
+	}
+
+	_EXP_IMPL void __cdecl schedule_chore(_Threadpool_chore *_Chore)
+	{
+		_ASSERT(_Chore->_Work == nullptr);
+		_Chore->_Work = &_Scheduler();
+		_Scheduler()._Submit(_Chore);
+	}
+
+	_EXP_IMPL bool __cdecl try_execute_chore()
+	{
+		return _Scheduler()._Try_execute_one();
+	}
+
+	_EXP_IMPL void __cdecl yield()
+	{
+		std::this_thread::yield();
+	}
+
+	_EXP_IMPL unsigned int __cdecl get_current_thread_id()
+	{
+#if defined(__linux__)
+		return static_cast<unsigned int>(::syscall(SYS_gettid));
+#elif defined(_WIN32)
+		return ::GetCurrentThreadId();
+#else
+		return static_cast<unsigned int>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+	}
+} // std::experimental::parallel::details
+_PSTL_NS1_END
+
+#endif // _PSTL_THREAD_SCHEDULER
@@ -1,20 +1,32 @@
 #include <thread>
+#include <mutex>
 #include <numeric>
 #include <cstdint>
+#include <vector>
+#include <experimental/impl/taskgroup.h>
+#include <experimental/impl/algorithm_impl.h>
+#include "workstealing_deque.h"
+#include "topology.h"
+#include "futex.h"
+
+#if defined(_WIN32)
 #include <Windows.h>
-#include <experimental\impl\taskgroup.h>
-#include <experimental\impl\algorithm_impl.h>
+#endif
 
 _PSTL_NS1_BEGIN
 namespace details
 {
 	const unsigned int TotalWorkStealingQueueNumber = 1024u; // It must be 2^n and greater than number of CPUs
 
-	void freeWorkStealingQueueOnCurrentThread();
+	// A waiting TaskGroup backs off between failed steal rounds, with 2^n pause instructions for the first rounds
+	// and a yield for the others. It parks on its event only after this many failed rounds in a row.
+	const int WaitSpinRounds = 8;
+	const int WaitStealRounds = 64;
 
 	class WorkStealingQueueFactory;
 	class WorkStealingQueueSet;
 
+#if defined(_WIN32)
 	bool IsWindows7()
 	{
 #if !defined(WINAPI_FAMILY) || WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
@@ -51,48 +63,46 @@ namespace details
 		return false;
 #endif					
 	}
+#else
+	bool IsWindows7()
+	{
+		return false;
+	}
+#endif
 
 	// The Workstealing queue is built on following 2 assumptions:
 	// 1. Workload of each chore is relatively light
 	// 2. Schedule method is invoked under relatively high volume
-	// We try to reduce the amount of atomics and dependencies on relaxed memory model
+	// Chores are kept in a Chase-Lev deque: the owner pushes and pops at the bottom without
+	// atomic RMW in the common case, thieves take the oldest chore from the top with a single CAS.
 	class WorkStealingQueue : public _Threadpool_chore
 	{
 		friend class WorkStealingQueueFactory;
 		friend class WorkStealingQueueSet;
-		friend void freeWorkStealingQueueOnCurrentThread();
 
-		std::atomic<int> m_workstealingPosition;
+		int m_workstealingPosition; // slot in WorkStealingQueueSet, never changes
+		unsigned int m_cpu; // CPU of the owning thread when the queue was allocated
+		bool m_pinned; // the owning thread is bound to m_cpu
+
+		// Slots this queue steals from when its owner is the thief, by distance from m_cpu. Owner only,
+		// rebuilt when the WorkStealingQueueSet generation moves past m_victimGeneration.
+		std::vector<int> m_victims[_Cpu_distance_count];
+		unsigned int m_victimGeneration;
 
 		// QueueReset, QueueScheduled are 2 status indicate that the chore is ready to be rescheduled
 		enum { QueueCreated, QueueReset, QueueScheduled } m_wsqStatus;
 
 		// workstealing queue
-		WorkChoreBase * m_topChore;
-		std::atomic<WorkChoreBase *> m_rootChore;
-		std::atomic<WorkChoreBase *> m_lastChore;
+		_Workstealing_deque<WorkChoreBase> m_chores;
 
 		// Scheduler
 		static std::atomic<size_t> s_threadPoolRunning;
 		static size_t s_concurrencyLevel;
 
-		void updateStealingPoint()
-		{
-			// Update stealing point
-			if (auto p = m_lastChore.load(std::memory_order_relaxed))
-			{
-				m_lastChore.store(nullptr, std::memory_order_relaxed);
-				m_rootChore = p->m_next.load();
-				// no other thread will ever touch this node
-				p->m_next.store(nullptr, std::memory_order_relaxed);
-			}
-		}
-
 		void injectThread()
 		{
 			if (m_wsqStatus != QueueScheduled)
 			{
-				m_topChore->m_next = nullptr;
 				if (m_wsqStatus == QueueCreated)
 					schedule_chore(this);
 				else
@@ -107,7 +117,7 @@ namespace details
 	public:
 		std::mt19937 randomGen;
 
-		WorkStealingQueue() : m_workstealingPosition(-1)
+		WorkStealingQueue() : m_workstealingPosition(-1), m_cpu(0), m_pinned(false), m_victimGeneration(0), m_chores(64)
 		{
 			m_wsqStatus = QueueCreated;
 			reset();
@@ -122,8 +132,8 @@ namespace details
 
 		void reset()
 		{
-			m_rootChore = m_topChore = nullptr;
-			m_lastChore.store(nullptr, std::memory_order_relaxed);
+			// all chores must have been claimed or stolen before the queue is released
+			_ASSERT(m_chores.empty());
 			if (m_wsqStatus != QueueCreated)
 				m_wsqStatus = QueueReset;
 		}
@@ -131,229 +141,260 @@ namespace details
 		// threadpool callback
 		virtual void __cdecl invoke() override;
 
-		WorkChoreBase *tryStealChore(bool waitForPending = false)
+		WorkChoreBase *tryStealChore()
 		{
-			WorkChoreBase * const PendingState = reinterpret_cast<WorkChoreBase *>(static_cast<intptr_t>(-1));
-
-			WorkChoreBase *chore = m_rootChore.exchange(PendingState);
-
-			// Busy waiting
-			while (waitForPending && chore == PendingState)
-			{
-				details::yield();
-				chore = m_rootChore;
-				if (chore != PendingState)
-					m_rootChore.compare_exchange_strong(chore, PendingState);
-			}
+			return m_chores.steal();
+		}
 
-			if (chore && chore != PendingState) // got an available chore
-			{
-				auto nextChore = chore->tryStealNextChore();
-
-				// if nextChore == nullptr, m_rootChore will be kept as nullptr until someone reset it
-				// from m_lastChore
-				m_rootChore = nextChore;
-				if (!nextChore)
-					m_lastChore.store(chore, std::memory_order_relaxed); // The workstealing queue is empty, notify the queue owner
-				return chore;
-			}
-			else
-			{
-				if (chore == nullptr)
-				{
-					chore = PendingState;
-					m_rootChore.compare_exchange_strong(chore, nullptr);
-				}
-				return nullptr;
-			}
+		// Owner only
+		intptr_t bottom() const
+		{
+			return m_chores.bottom();
 		}
 
+		// Owner only, returns nullptr if the most recently scheduled chore has been stolen
+		WorkChoreBase *popChore()
+		{
+			return m_chores.pop();
+		}
 
 		void schedule(WorkChoreBase *chore)
 		{
 			// step 1 push chore
-			chore->m_prev = m_topChore;
-			if (m_topChore)
-			{
-				m_topChore = m_topChore->m_next = chore;
-
-				updateStealingPoint();
-			}
-			else
-			{
-				m_rootChore = m_topChore = chore;
-				_ASSERT(m_lastChore.load(std::memory_order_relaxed) == nullptr);
-			}
+			m_chores.push(chore);
 
 			// step 2 spawn new thread if needed
 			if (s_threadPoolRunning < s_concurrencyLevel)
 				injectThread();
 		}
-
-		void setTopChoreBack(WorkChoreBase *chore)
-		{
-			// m_lastChore is always set by workstealingqueue owner
-			// except during "tryStealChore", which can be set by other threads
-			// with spin wait protection
-			if (m_lastChore.load(std::memory_order_relaxed) == m_topChore)
-				m_lastChore.store(chore, std::memory_order_relaxed);
-			m_topChore = chore;
-		}
 	};
 
-	class SRWLock
+	// Queues are bound to threads for the thread's lifetime: a thread claims a free slot with a single CAS
+	// the first time it needs a queue and gives it back when it exits, thus entering and leaving a parallel
+	// region does not touch any shared state. Slots never move, thieves scan the ones below m_highWater.
+	class WorkStealingQueueSet
 	{
-		SRWLOCK m_locker;
-	public:
-		SRWLock() { InitializeSRWLock(&m_locker); }
-
-		_Acquires_exclusive_lock_(this->m_locker) bool try_lock()
+		WorkStealingQueue m_queuePool[TotalWorkStealingQueueNumber];
+		std::atomic<bool> m_inUse[TotalWorkStealingQueueNumber];
+		// CPU of m_queuePool[i], kept apart so victim selection does not touch the queues' cache lines
+		std::atomic<unsigned int> m_queueCpu[TotalWorkStealingQueueNumber];
+		std::atomic<int> m_highWater; // one past the highest slot ever claimed
+		std::atomic<int> m_searchHint; // the slot search starts here, usually the last freed slot
+		std::atomic<unsigned int> m_generation; // bumped whenever a slot is claimed or released, never 0
+
+		// Victim lists of the thief, skipped while no slot has been claimed or released since the last build
+		void updateVictims(WorkStealingQueue *thief)
 		{
-			return TryAcquireSRWLockExclusive(&m_locker) != FALSE;
-		}
+			unsigned int generation = m_generation.load(std::memory_order_acquire);
+			if (thief->m_victimGeneration == generation)
+				return;
+			thief->m_victimGeneration = generation;
 
-		_Acquires_exclusive_lock_(this->m_locker) void lock()
-		{
-			AcquireSRWLockExclusive(&m_locker);
+			for (auto &victims : thief->m_victims)
+				victims.clear();
+
+			const _Cpu_topology &topology = _Cpu_topology::get();
+			int top = m_highWater.load(std::memory_order_acquire);
+			for (int pos = 0; pos < top; ++pos)
+			{
+				if (!m_inUse[pos].load(std::memory_order_relaxed) || pos == thief->m_workstealingPosition)
+					continue;
+
+				// An unpinned thread moves between CPUs, ordering by the CPU it once ran on buys nothing
+				int level = thief->m_pinned ? topology.distance(thief->m_cpu, m_queueCpu[pos].load(std::memory_order_relaxed)) : 0;
+				thief->m_victims[level].push_back(pos);
+			}
 		}
 
-		_Releases_exclusive_lock_(this->m_locker) void unlock()
+		void bumpGeneration()
 		{
-			ReleaseSRWLockExclusive(&m_locker);
+			if (m_generation.fetch_add(1, std::memory_order_release) + 1 == 0)
+				m_generation.fetch_add(1, std::memory_order_release);
 		}
-	};
-
-	class WorkStealingQueueSet
-	{
-		WorkStealingQueue m_queuePool[TotalWorkStealingQueueNumber];
-		// NOTE: when perf stability become an issue, we need to rewrite this 
-		// WorkStealingQueue allocation from LIFO to FIFO.
-		std::atomic<WorkStealingQueue *> m_queue[TotalWorkStealingQueueNumber];
-		SRWLock m_mutex;
-		std::atomic<int> m_top; // lock protected
 
 	public:
-		WorkStealingQueueSet() : m_top(0)
+		WorkStealingQueueSet() : m_highWater(0), m_searchHint(0), m_generation(1)
 		{
 			for (unsigned int i = 0; i < TotalWorkStealingQueueNumber; i++)
-				m_queue[i] = m_queuePool + i;
+			{
+				m_queuePool[i].m_workstealingPosition = static_cast<int>(i);
+				m_inUse[i] = false;
+				m_queueCpu[i] = 0;
+			}
 		}
 
 		WorkStealingQueue *alloc()
 		{
-			std::lock_guard<SRWLock> guard(m_mutex);
-			int top = m_top.load(std::memory_order_relaxed);
-			if (top >= TotalWorkStealingQueueNumber)
-				return nullptr;
-			auto wd = m_queue[top].load(std::memory_order_relaxed);
-			wd->m_workstealingPosition.store(top, std::memory_order_relaxed);
-			m_queue[top].store(wd, std::memory_order_relaxed);
-			m_top.store(top + 1, std::memory_order_relaxed);
-			return wd;
+			unsigned int cpu = _Cpu_topology::current_cpu();
+			int start = m_searchHint.load(std::memory_order_relaxed);
+
+			for (unsigned int i = 0; i < TotalWorkStealingQueueNumber; i++)
+			{
+				int pos = static_cast<int>((start + i) & (TotalWorkStealingQueueNumber - 1));
+				bool expected = false;
+				if (m_inUse[pos].load(std::memory_order_relaxed) || !m_inUse[pos].compare_exchange_strong(expected, true, std::memory_order_acquire))
+					continue;
+
+				auto wd = m_queuePool + pos;
+				wd->m_cpu = cpu;
+				wd->m_pinned = _Cpu_topology::current_thread_pinned();
+				wd->m_victimGeneration = 0;
+				m_queueCpu[pos].store(cpu, std::memory_order_relaxed);
+
+				int highWater = m_highWater.load(std::memory_order_relaxed);
+				while (highWater <= pos && !m_highWater.compare_exchange_weak(highWater, pos + 1, std::memory_order_release))
+					;
+
+				bumpGeneration();
+				m_searchHint.store((pos + 1) & (TotalWorkStealingQueueNumber - 1), std::memory_order_relaxed);
+				return wd;
+			}
+
+			return nullptr;
 		}
 
 		void free(WorkStealingQueue * wd)
 		{
 			wd->reset();
-			std::lock_guard<SRWLock> guard(m_mutex);
-			int pos = wd->m_workstealingPosition.load(std::memory_order_relaxed);
-			auto top = m_top.load(std::memory_order_relaxed);
-			if (--top != pos)
-			{
-				auto next = m_queue[top].load(std::memory_order_relaxed);
-				m_queue[pos].store(next, std::memory_order_relaxed);
-				m_queue[top].store(wd, std::memory_order_relaxed);
-				next->m_workstealingPosition.store(pos, std::memory_order_relaxed);
-			}
-			m_top.store(top, std::memory_order_relaxed);
+			m_searchHint.store(wd->m_workstealingPosition, std::memory_order_relaxed);
+			m_inUse[wd->m_workstealingPosition].store(false, std::memory_order_release);
+			bumpGeneration();
 		}
 
-		WorkChoreBase * tryRandomSteal(WorkStealingQueue *&lastTarget, std::mt19937 &randGen, int retry = 10)
+		// Hierarchical victim selection: queues sharing the last level cache with the thief are tried
+		// first, then the rest of its socket, and remote sockets only when both came up empty.
+		// Each level gets up to `retry` random attempts. Unpinned thieves have a single level.
+		WorkChoreBase * tryRandomSteal(WorkStealingQueue *thief, WorkStealingQueue *&lastTarget, int retry = 10)
 		{
-			WorkChoreBase * p = lastTarget->tryStealChore();
+			const _Cpu_topology &topology = _Cpu_topology::get();
+
+			if (auto p = lastTarget->tryStealChore())
+			{
+				// Taking a chore back from our own queue is no steal
+				if (lastTarget != thief)
+					_Record_steal(topology.distance(thief->m_cpu, lastTarget->m_cpu));
+				return p;
+			}
+
+			updateVictims(thief);
 
-			while (p == nullptr && retry--) {
-				// Without lock protection, this may access removed queue.
-				// However, steal from a removed queue is fail safe.
-				if (auto curTarget = m_queue[(lastTarget->m_workstealingPosition.load(std::memory_order_relaxed) + (randGen() & 0xFFFFFF)) % m_top.load(std::memory_order_relaxed)].load(std::memory_order_relaxed))
+			for (int level = 0; level < _Cpu_distance_count; ++level)
+			{
+				const auto &victims = thief->m_victims[level];
+				const int count = static_cast<int>(victims.size());
+				for (int attempt = 0; attempt < retry && attempt < count; ++attempt)
 				{
-					p = curTarget->tryStealChore();
-					lastTarget = curTarget;
+					// The slot may be released meanwhile, steal from a released queue is fail safe.
+					int pos = victims[static_cast<int>((thief->randomGen() & 0xFFFFFF) % count)];
+					auto curTarget = m_queuePool + pos;
+
+					if (auto p = curTarget->tryStealChore())
+					{
+						lastTarget = curTarget;
+						_Record_steal(thief->m_pinned ? static_cast<_Cpu_distance>(level) : topology.distance(thief->m_cpu, m_queueCpu[pos].load(std::memory_order_relaxed)));
+						return p;
+					}
 				}
 			}
 
-			return p;
+			return nullptr;
 		}
 	};
 
-	WorkStealingQueueSet g_wsqSet;
-	std::atomic<size_t> WorkStealingQueue::s_threadPoolRunning = 0;
-	size_t WorkStealingQueue::s_concurrencyLevel = get_hardware_concurrency() * 2;
-	__declspec(thread) WorkStealingQueue * tls_threadLocalQueue = 0;
+	// Never destroyed: pool workers and thread exit callbacks return their queues to the set while the
+	// other translation units are torn down, in whatever order the loader picks
+	std::once_flag g_wsqSetFlag;
+	WorkStealingQueueSet *g_wsqSetIns;
+
+	inline WorkStealingQueueSet &workStealingQueueSet()
+	{
+		std::call_once(g_wsqSetFlag, [] { g_wsqSetIns = new WorkStealingQueueSet(); });
+		return *g_wsqSetIns;
+	}
+
+	std::atomic<size_t> WorkStealingQueue::s_threadPoolRunning(0);
+	// Waiting threads help with stealing, thus there is no need to oversubscribe the cores
+	size_t WorkStealingQueue::s_concurrencyLevel = get_hardware_concurrency();
+
+#if defined(_WIN32)
+	_PSTL_THREAD_LOCAL WorkStealingQueue * tls_threadLocalQueue = 0;
+
+	// __declspec(thread) has no destructors, a fiber local storage callback returns the queue on thread exit
+	void WINAPI releaseWorkStealingQueue(PVOID queue)
+	{
+		if (queue != nullptr)
+			workStealingQueueSet().free(static_cast<WorkStealingQueue *>(queue));
+	}
 
+	DWORD g_wsqFlsIndex = ::FlsAlloc(releaseWorkStealingQueue);
 
-	inline WorkChoreBase *WorkChoreBase::tryStealNextChore()
+	inline WorkStealingQueue *boundWorkStealingQueue()
 	{
-		return m_next.exchange(nullptr);
+		return tls_threadLocalQueue;
 	}
 
-	inline bool WorkChoreBase::tryClaimThisChore()
+	inline void bindWorkStealingQueueToCurrentThread(WorkStealingQueue *queue)
 	{
-		if (m_prev && m_prev->tryStealNextChore())
-			return true;
-		else
+		tls_threadLocalQueue = queue;
+		::FlsSetValue(g_wsqFlsIndex, queue);
+	}
+#else
+	struct WorkStealingQueueBinding
+	{
+		WorkStealingQueue *queue;
+
+		~WorkStealingQueueBinding()
 		{
-			// Last chore on the workstealing queue cannot be claimed.
-			// We have to steal it
-			return getWorkStealingQueue()->tryStealChore(true) != nullptr;
+			if (queue != nullptr)
+				workStealingQueueSet().free(queue);
 		}
-	}
+	};
 
+	thread_local WorkStealingQueueBinding tls_threadLocalBinding = { nullptr };
 
-	inline WorkStealingQueue *createWorkStealingQueueOnCurrentThread()
+	inline WorkStealingQueue *boundWorkStealingQueue()
 	{
-		auto queue = g_wsqSet.alloc();
-		tls_threadLocalQueue = queue;
-		return queue;
+		return tls_threadLocalBinding.queue;
 	}
 
-	inline void freeWorkStealingQueueOnCurrentThread()
+	inline void bindWorkStealingQueueToCurrentThread(WorkStealingQueue *queue)
 	{
-		auto p = tls_threadLocalQueue;
-		if (p != nullptr)
+		tls_threadLocalBinding.queue = queue;
+	}
+#endif
+
+	// Returns the queue bound to this thread, claiming one on first use. Returns nullptr when all slots are taken.
+	inline WorkStealingQueue *getWorkStealingQueueOnCurrentThread()
+	{
+		auto queue = boundWorkStealingQueue();
+		if (queue == nullptr)
 		{
-			tls_threadLocalQueue = nullptr;
-			g_wsqSet.free(p);
+			queue = workStealingQueueSet().alloc();
+			if (queue != nullptr)
+				bindWorkStealingQueueToCurrentThread(queue);
 		}
+		return queue;
 	}
 
 	inline void WorkStealingQueue::invoke()
 	{
-		auto curQueue = createWorkStealingQueueOnCurrentThread();
-		if (curQueue == nullptr)
-			return;
-
-		auto myQueue = this;
-		while (auto chore = g_wsqSet.tryRandomSteal(myQueue, curQueue->randomGen))
+		auto curQueue = getWorkStealingQueueOnCurrentThread();
+		if (curQueue != nullptr)
 		{
-			curQueue->reset();
-			chore->run(true);
+			auto myQueue = this;
+			while (auto chore = workStealingQueueSet().tryRandomSteal(curQueue, myQueue))
+				chore->run(true);
 		}
-		freeWorkStealingQueueOnCurrentThread();
 		--WorkStealingQueue::s_threadPoolRunning;
 	}
 
-	_EXP_IMPL TaskGroup::TaskGroup() : m_pendingChore(MaximalChoreNum), m_head(nullptr), m_tail(nullptr), m_choreCounter(0), m_needReleaseWSQ(false)
+	_EXP_IMPL TaskGroup::TaskGroup() : m_choreCounter(0), m_pendingChore(MaximalChoreNum)
 	{
 		// This TaskGroup belong to workstealing queue on this thread
-		m_queue = tls_threadLocalQueue;
-		if (m_queue == nullptr)
-		{
-			m_needReleaseWSQ = true;
-			m_queue = createWorkStealingQueueOnCurrentThread();
-			if (!m_queue)
-				throw std::bad_alloc();
-		}
+		m_queue = getWorkStealingQueueOnCurrentThread();
+		if (!m_queue)
+			throw std::bad_alloc();
+		m_queueBottom = m_queue->bottom();
 	}
 
 	_EXP_IMPL void __cdecl TaskGroup::run(WorkChoreBase &work)
@@ -361,14 +402,10 @@ namespace details
 		_ASSERT(work.m_taskGroup == nullptr);
 		work.m_taskGroup = this;
 
-		if (m_head)
-		{
-			m_tail = &work;
-		}
-		else
-		{
-			m_head = m_tail = &work;
-		}
+		// A group created before this one and waited already may have popped the queue below our starting position
+		auto bottom = m_queue->bottom();
+		if (bottom < m_queueBottom)
+			m_queueBottom = bottom;
 
 		// push work item to current workstealing queue
 		m_queue->schedule(&work);
@@ -379,41 +416,62 @@ namespace details
 
 	_EXP_IMPL void __cdecl TaskGroup::wait()
 	{
-		if (m_tail == nullptr)
+		if (m_choreCounter == 0)
 			return;
 
-		auto p = m_tail;
+		// Nested task groups are usually waited before this one, so whatever is left above our
+		// starting position belongs to this group. Thieves take from the other end.
 		int inlinedChore = 0;
-		while (p->tryClaimThisChore())
+		while (m_queue->bottom() > m_queueBottom)
 		{
-			++inlinedChore;
-
-			// correct the header for potential inline in user function
-			m_queue->setTopChoreBack(p->m_prev);
-
-			p->run(false);
-
-			if (p == m_head)
+			auto p = m_queue->popChore();
+			if (p == nullptr)
 				break;
-			p = p->m_prev;
+
+			if (p->m_taskGroup == this)
+			{
+				++inlinedChore;
+				p->run(false);
+			}
+			else
+			{
+				// A group created after this one and not waited yet, its chore completes as if stolen
+				p->run(true);
+			}
 		}
 
 		if (inlinedChore != m_choreCounter && (m_pendingChore -= MaximalChoreNum - m_choreCounter + inlinedChore) > 0)
 		{
+			// Help first: while our stolen chores are in flight, run chores from other queues
+			// instead of idling this core. More work may be pushed while they run, so an empty
+			// round only backs off, and we block once steals kept failing for a while.
+			auto target = m_queue;
+			const bool spin = get_hardware_concurrency() > 1;
+			for (int failedRounds = 0; !m_event.is_set() && failedRounds < WaitStealRounds;)
+			{
+				if (auto chore = workStealingQueueSet().tryRandomSteal(m_queue, target))
+				{
+					chore->run(true);
+					failedRounds = 0;
+				}
+				else if (++failedRounds <= WaitSpinRounds && spin)
+				{
+					for (int i = 0; i < (1 << failedRounds); ++i)
+						_Cpu_relax();
+				}
+				else
+					details::yield();
+			}
+
 			m_event.wait();
 		}
 
-		// correct the header for next taskgroup
-		m_queue->setTopChoreBack(m_head->m_prev);
-
-		m_head = m_tail = nullptr;
+		m_choreCounter = 0;
 	}
 
 	_EXP_IMPL TaskGroup::~TaskGroup()
 	{
 		wait();
-		if (m_needReleaseWSQ)
-			freeWorkStealingQueueOnCurrentThread();
 	}
 
 	// isAsync indicates whether the chore is called by
@@ -427,11 +485,5 @@ namespace details
 		if (isAsync)
 			m_taskGroup->finishAsync();
 	}
-
-	inline WorkStealingQueue *WorkChoreBase::getWorkStealingQueue()
-	{
-		_ASSERT(m_taskGroup);
-		return m_taskGroup->m_queue;
-	}
 	}
 _PSTL_NS1_END // std::experimental::parallel
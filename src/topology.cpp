@@ -0,0 +1,233 @@
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <experimental/impl/algorithm_impl.h>
+#include "topology.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+_PSTL_NS1_BEGIN
+namespace details {
+
+	namespace
+	{
+		std::once_flag _Topology_flag;
+		_Cpu_topology *_Topology;
+
+		// Steal counters of a thief by distance, on a cache line of their own
+		struct _Steal_counters
+		{
+			std::atomic<size_t> _Count[_Cpu_distance_count];
+			char _Pad[64 - sizeof(std::atomic<size_t>) * _Cpu_distance_count];
+		};
+
+		static_assert(sizeof(_Steal_counters) == 64, "The steal counters must fill one cache line");
+
+		// One line per worker slot, so that a thief only ever writes its own. Threads without a slot share the
+		// overflow line. The slot block is never released, pool workers may steal during shutdown.
+		std::once_flag _Steal_counters_flag;
+		_Steal_counters *_Worker_steal_counters;
+		_Steal_counters _Overflow_steal_counters;
+
+		_Steal_counters *_Get_worker_steal_counters()
+		{
+			std::call_once(_Steal_counters_flag, [] {
+				_Worker_steal_counters = static_cast<_Steal_counters *>(_Acquire_slot_block(sizeof(_Steal_counters)));
+			});
+			return _Worker_steal_counters;
+		}
+
+#if defined(__linux__)
+		bool _Read_sysfs(const std::string &_Path, std::string &_Value)
+		{
+			std::ifstream _File(_Path);
+			if (!_File)
+				return false;
+
+			std::getline(_File, _Value);
+			return true;
+		}
+
+		// Parses the largest CPU number of a cpulist such as "0-7,16-23"
+		unsigned int _Max_cpu_in_list(const std::string &_List)
+		{
+			unsigned int _Max = 0;
+			std::stringstream _Stream(_List);
+			std::string _Range;
+			while (std::getline(_Stream, _Range, ','))
+			{
+				auto _Dash = _Range.find('-');
+				unsigned int _Last = static_cast<unsigned int>(std::stoul(_Dash == std::string::npos ? _Range : _Range.substr(_Dash + 1)));
+				if (_Last > _Max)
+					_Max = _Last;
+			}
+			return _Max;
+		}
+
+		// Parses the first CPU number of a cpulist
+		unsigned int _First_cpu_in_list(const std::string &_List)
+		{
+			return static_cast<unsigned int>(std::stoul(_List));
+		}
+#endif
+	}
+
+	_Cpu_topology::_Cpu_topology()
+	{
+#if defined(__linux__)
+		const std::string _Root = "/sys/devices/system/cpu/";
+
+		std::string _Possible;
+		unsigned int _Count = get_hardware_concurrency();
+		if (_Read_sysfs(_Root + "possible", _Possible) && !_Possible.empty())
+			_Count = _Max_cpu_in_list(_Possible) + 1;
+
+		_Cpus.resize(_Count);
+		for (unsigned int _Cpu = 0; _Cpu < _Count; ++_Cpu)
+		{
+			const std::string _Dir = _Root + "cpu" + std::to_string(_Cpu) + "/";
+			std::string _Value;
+
+			int _Socket = 0;
+			if (_Read_sysfs(_Dir + "topology/physical_package_id", _Value) && !_Value.empty())
+				_Socket = std::stoi(_Value);
+			_Cpus[_Cpu]._Socket = _Socket < 0 ? 0 : static_cast<unsigned int>(_Socket);
+
+			// The last level cache domain is named after its first CPU; without an L3
+			// the whole package is treated as one complex.
+			_Cpus[_Cpu]._Cache_domain = ~0u - _Cpus[_Cpu]._Socket;
+			for (int _Index = 0; _Index < 8; ++_Index)
+			{
+				const std::string _Cache = _Dir + "cache/index" + std::to_string(_Index) + "/";
+				std::string _Level, _Shared;
+				if (!_Read_sysfs(_Cache + "level", _Level))
+					break;
+				if (_Level == "3" && _Read_sysfs(_Cache + "shared_cpu_list", _Shared) && !_Shared.empty())
+				{
+					_Cpus[_Cpu]._Cache_domain = _First_cpu_in_list(_Shared);
+					break;
+				}
+			}
+		}
+#elif defined(_WIN32)
+		DWORD _Length = 0;
+		::GetLogicalProcessorInformation(nullptr, &_Length);
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> _Info(_Length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+		if (_Info.empty() || !::GetLogicalProcessorInformation(_Info.data(), &_Length))
+			return;
+
+		_Cpus.resize(sizeof(ULONG_PTR) * 8);
+		for (auto &_Cpu : _Cpus)
+		{
+			_Cpu._Socket = 0;
+			_Cpu._Cache_domain = ~0u;
+		}
+
+		unsigned int _Socket = 0, _Cache_domain = 0;
+		for (auto &_Entry : _Info)
+		{
+			const bool _Is_package = _Entry.Relationship == RelationProcessorPackage;
+			const bool _Is_l3 = _Entry.Relationship == RelationCache && _Entry.Cache.Level == 3;
+			if (!_Is_package && !_Is_l3)
+				continue;
+
+			for (unsigned int _Cpu = 0; _Cpu < _Cpus.size(); ++_Cpu)
+			{
+				if ((_Entry.ProcessorMask & (static_cast<ULONG_PTR>(1) << _Cpu)) == 0)
+					continue;
+				if (_Is_package)
+					_Cpus[_Cpu]._Socket = _Socket;
+				else
+					_Cpus[_Cpu]._Cache_domain = _Cache_domain;
+			}
+
+			if (_Is_package)
+				++_Socket;
+			else
+				++_Cache_domain;
+		}
+
+		// No L3 reported, the package is the complex
+		for (auto &_Cpu : _Cpus)
+			if (_Cpu._Cache_domain == ~0u)
+				_Cpu._Cache_domain = ~0u - 1 - _Cpu._Socket;
+#endif
+	}
+
+	const _Cpu_topology& _Cpu_topology::get()
+	{
+		std::call_once(_Topology_flag, [] { _Topology = new _Cpu_topology(); });
+		return *_Topology;
+	}
+
+	unsigned int _Cpu_topology::current_cpu()
+	{
+#if defined(__linux__)
+		int _Cpu = ::sched_getcpu();
+		return _Cpu < 0 ? 0 : static_cast<unsigned int>(_Cpu);
+#elif defined(_WIN32)
+		return ::GetCurrentProcessorNumber();
+#else
+		return 0;
+#endif
+	}
+
+	bool _Cpu_topology::current_thread_pinned()
+	{
+#if defined(__linux__)
+		cpu_set_t _Set;
+		CPU_ZERO(&_Set);
+		return ::sched_getaffinity(0, sizeof(_Set), &_Set) == 0 && CPU_COUNT(&_Set) == 1;
+#elif defined(_WIN32)
+		GROUP_AFFINITY _Affinity;
+		return ::GetThreadGroupAffinity(::GetCurrentThread(), &_Affinity) && (_Affinity.Mask & (_Affinity.Mask - 1)) == 0;
+#else
+		return false;
+#endif
+	}
+
+	void _Record_steal(_Cpu_distance _Distance)
+	{
+		_Steal_counters *_Counters = _Get_worker_steal_counters();
+		const unsigned int _Slot = get_current_worker_slot();
+		auto &_Own = _Slot < get_worker_slot_count() ? _Counters[_Slot] : _Overflow_steal_counters;
+		_Own._Count[_Distance].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	_EXP_IMPL steal_statistics __cdecl get_steal_statistics()
+	{
+		size_t _Sum[_Cpu_distance_count];
+		for (int _Distance = 0; _Distance < _Cpu_distance_count; ++_Distance)
+			_Sum[_Distance] = _Overflow_steal_counters._Count[_Distance].load(std::memory_order_relaxed);
+
+		_Steal_counters *_Counters = _Get_worker_steal_counters();
+		for (unsigned int _Slot = 0; _Slot < get_worker_slot_count(); ++_Slot)
+			for (int _Distance = 0; _Distance < _Cpu_distance_count; ++_Distance)
+				_Sum[_Distance] += _Counters[_Slot]._Count[_Distance].load(std::memory_order_relaxed);
+
+		steal_statistics _Stats;
+		_Stats.same_core_complex = _Sum[_Same_core_complex];
+		_Stats.same_socket = _Sum[_Same_socket];
+		_Stats.remote_socket = _Sum[_Remote_socket];
+		return _Stats;
+	}
+
+	_EXP_IMPL void __cdecl reset_steal_statistics()
+	{
+		_Steal_counters *_Counters = _Get_worker_steal_counters();
+		for (int _Distance = 0; _Distance < _Cpu_distance_count; ++_Distance)
+		{
+			_Overflow_steal_counters._Count[_Distance].store(0, std::memory_order_relaxed);
+			for (unsigned int _Slot = 0; _Slot < get_worker_slot_count(); ++_Slot)
+				_Counters[_Slot]._Count[_Distance].store(0, std::memory_order_relaxed);
+		}
+	}
+} // std::experimental::parallel::details
+_PSTL_NS1_END
@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef _SRC_TOPOLOGY_H_
+#define _SRC_TOPOLOGY_H_
+
+#include <vector>
+#include <experimental/impl/algorithm_scheduler.h>
+
+_PSTL_NS1_BEGIN
+namespace details {
+
+	// Distance between two CPUs as seen by work stealing victim selection
+	enum _Cpu_distance
+	{
+		_Same_core_complex = 0, // sharing the last level cache
+		_Same_socket = 1,
+		_Remote_socket = 2,
+		_Cpu_distance_count = 3
+	};
+
+	// Cache and package layout of the machine, read once at first use
+	// (/sys/devices/system/cpu on Linux, GetLogicalProcessorInformation on Windows).
+	class _Cpu_topology
+	{
+		struct _Cpu_info
+		{
+			unsigned int _Cache_domain; // id of the last level cache domain
+			unsigned int _Socket;
+		};
+
+		std::vector<_Cpu_info> _Cpus;
+
+		_Cpu_topology();
+
+	public:
+		static const _Cpu_topology& get();
+
+		// CPU the calling thread is running on at the moment
+		static unsigned int current_cpu();
+
+		// Whether the affinity of the calling thread allows a single CPU only
+		static bool current_thread_pinned();
+
+		_Cpu_distance distance(unsigned int _Cpu1, unsigned int _Cpu2) const
+		{
+			if (_Cpu1 >= _Cpus.size() || _Cpu2 >= _Cpus.size())
+				return _Same_socket; // unknown, treat as neutral
+
+			if (_Cpus[_Cpu1]._Socket != _Cpus[_Cpu2]._Socket)
+				return _Remote_socket;
+
+			return _Cpus[_Cpu1]._Cache_domain == _Cpus[_Cpu2]._Cache_domain ? _Same_core_complex : _Same_socket;
+		}
+	};
+
+	// Feeds get_steal_statistics()
+	void _Record_steal(_Cpu_distance _Distance);
+
+} // std::experimental::parallel::details
+_PSTL_NS1_END
+
+#endif // _SRC_TOPOLOGY_H_
@@ -0,0 +1,699 @@
+#include <cstddef>
+#include <cstdint>
+#include <experimental/impl/algorithm_impl.h>
+
+// SSE2 is there on every x64 CPU and checked at run time on x86. AVX2, POPCNT and FMA3 are always compiled and
+// checked at run time. MSVC accepts their intrinsics without /arch:AVX2, GCC and clang only in functions with the
+// matching target attribute, the rest of the library keeps the baseline instruction set.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define _PSTL_VEC_SSE2 1
+#define _PSTL_VEC_AVX2 1
+#define _PSTL_VEC_FMA 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define _PSTL_VEC_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define _PSTL_VEC_TARGET_FMA __attribute__((target("avx2,popcnt,fma")))
+// Inlines the generic kernel and the operations of the instruction set into the function with the target attribute
+#define _PSTL_VEC_FLATTEN __attribute__((flatten))
+#if !defined(__clang__)
+// The generic kernels pass AVX vectors around before they are inlined into the AVX2 functions, no call is left
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+#else
+#define _PSTL_VEC_TARGET_AVX2
+#define _PSTL_VEC_TARGET_FMA
+#define _PSTL_VEC_FLATTEN
+#endif
+
+_PSTL_NS1_BEGIN
+namespace details {
+	namespace
+	{
+		enum _Vec_isa { _Vec_isa_scalar, _Vec_isa_sse2, _Vec_isa_avx2 };
+
+		_Vec_isa _Detect_vec_isa()
+		{
+#if defined(_MSC_VER) && defined(_PSTL_VEC_SSE2)
+			int _Info[4];
+			__cpuid(_Info, 0);
+			const int _Max_leaf = _Info[0];
+
+			__cpuid(_Info, 1);
+			const bool _Sse2 = (_Info[3] & (1 << 26)) != 0;
+			const bool _Popcnt = (_Info[2] & (1 << 23)) != 0;
+			// The OS has to save the ymm registers on context switches
+			const bool _Avx_enabled = (_Info[2] & (1 << 27)) != 0 && (_Info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+
+			bool _Avx2 = false;
+			if (_Max_leaf >= 7)
+			{
+				__cpuidex(_Info, 7, 0);
+				_Avx2 = (_Info[1] & (1 << 5)) != 0;
+			}
+
+			if (_Avx2 && _Avx_enabled && _Popcnt)
+				return _Vec_isa_avx2;
+			return _Sse2 ? _Vec_isa_sse2 : _Vec_isa_scalar;
+#elif defined(_PSTL_VEC_AVX2)
+			// Checks the OS support of the ymm registers as well
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+				return _Vec_isa_avx2;
+			return _Vec_isa_sse2;
+#elif defined(_PSTL_VEC_SSE2)
+			return _Vec_isa_sse2;
+#else
+			return _Vec_isa_scalar;
+#endif
+		}
+
+		// FMA3 has a feature bit of its own, it is only used together with AVX2
+		bool _Detect_fma()
+		{
+#if defined(_MSC_VER) && defined(_PSTL_VEC_FMA)
+			int _Info[4];
+			__cpuid(_Info, 1);
+			return (_Info[2] & (1 << 12)) != 0;
+#elif defined(_PSTL_VEC_FMA)
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("fma") != 0;
+#else
+			return false;
+#endif
+		}
+
+		const _Vec_isa _Vec_level = _Detect_vec_isa();
+		const bool _Vec_fma = _Detect_fma();
+
+		// Every instruction set below compares whole vectors and returns a mask with sizeof(_Ty) bits per element,
+		// set for the equal ones. _Scalar stands in for a vector of one element.
+		template<typename _Ty>
+		struct _Scalar
+		{
+			typedef _Ty _Vec;
+
+			static unsigned int _All()
+			{
+				return (1u << sizeof(_Ty)) - 1;
+			}
+
+			static _Vec _Load(const _Ty *_Ptr)
+			{
+				return *_Ptr;
+			}
+
+			static _Vec _Broadcast(_Ty _Val)
+			{
+				return _Val;
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return _Left == _Right ? _All() : 0;
+			}
+
+			static size_t _Popcount(unsigned int _Mask)
+			{
+				return _Mask_popcount(_Mask);
+			}
+		};
+
+#if defined(_PSTL_VEC_SSE2)
+		template<typename _Ty>
+		struct _Sse2_base
+		{
+			typedef __m128i _Vec;
+
+			static unsigned int _All()
+			{
+				return 0xffff;
+			}
+
+			static _Vec _Load(const _Ty *_Ptr)
+			{
+				return _mm_loadu_si128(reinterpret_cast<const __m128i *>(_Ptr));
+			}
+
+			static size_t _Popcount(unsigned int _Mask)
+			{
+				return _Mask_popcount(_Mask);
+			}
+		};
+
+		template<typename _Ty>
+		struct _Sse2;
+
+		template<>
+		struct _Sse2<int8_t> : _Sse2_base<int8_t>
+		{
+			static _Vec _Broadcast(int8_t _Val)
+			{
+				return _mm_set1_epi8(_Val);
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_Left, _Right)));
+			}
+		};
+
+		template<>
+		struct _Sse2<int16_t> : _Sse2_base<int16_t>
+		{
+			static _Vec _Broadcast(int16_t _Val)
+			{
+				return _mm_set1_epi16(_Val);
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(_Left, _Right)));
+			}
+		};
+
+		template<>
+		struct _Sse2<int32_t> : _Sse2_base<int32_t>
+		{
+			static _Vec _Broadcast(int32_t _Val)
+			{
+				return _mm_set1_epi32(_Val);
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi32(_Left, _Right)));
+			}
+		};
+
+		// SSE2 has no 64 bit comparison, both halves have to be equal
+		template<>
+		struct _Sse2<int64_t> : _Sse2_base<int64_t>
+		{
+			static _Vec _Broadcast(int64_t _Val)
+			{
+				const __m128i _Low = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&_Val));
+				return _mm_unpacklo_epi64(_Low, _Low);
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				const __m128i _Halves = _mm_cmpeq_epi32(_Left, _Right);
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(_Halves, _mm_shuffle_epi32(_Halves, _MM_SHUFFLE(2, 3, 0, 1)))));
+			}
+		};
+
+		template<>
+		struct _Sse2<float> : _Sse2_base<float>
+		{
+			typedef __m128 _Vec;
+
+			static _Vec _Load(const float *_Ptr)
+			{
+				return _mm_loadu_ps(_Ptr);
+			}
+
+			static _Vec _Broadcast(float _Val)
+			{
+				return _mm_set1_ps(_Val);
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_Left, _Right))));
+			}
+		};
+
+		template<>
+		struct _Sse2<double> : _Sse2_base<double>
+		{
+			typedef __m128d _Vec;
+
+			static _Vec _Load(const double *_Ptr)
+			{
+				return _mm_loadu_pd(_Ptr);
+			}
+
+			static _Vec _Broadcast(double _Val)
+			{
+				return _mm_set1_pd(_Val);
+			}
+
+			static unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_Left, _Right))));
+			}
+		};
+#endif // _PSTL_VEC_SSE2
+
+#if defined(_PSTL_VEC_AVX2)
+		template<typename _Ty>
+		struct _Avx2_base
+		{
+			typedef __m256i _Vec;
+
+			static unsigned int _All()
+			{
+				return 0xffffffff;
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Load(const _Ty *_Ptr)
+			{
+				return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_Ptr));
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 size_t _Popcount(unsigned int _Mask)
+			{
+				return _mm_popcnt_u32(_Mask);
+			}
+		};
+
+		template<typename _Ty>
+		struct _Avx2;
+
+		template<>
+		struct _Avx2<int8_t> : _Avx2_base<int8_t>
+		{
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Broadcast(int8_t _Val)
+			{
+				return _mm256_set1_epi8(_Val);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_Left, _Right)));
+			}
+		};
+
+		template<>
+		struct _Avx2<int16_t> : _Avx2_base<int16_t>
+		{
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Broadcast(int16_t _Val)
+			{
+				return _mm256_set1_epi16(_Val);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_Left, _Right)));
+			}
+		};
+
+		template<>
+		struct _Avx2<int32_t> : _Avx2_base<int32_t>
+		{
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Broadcast(int32_t _Val)
+			{
+				return _mm256_set1_epi32(_Val);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_Left, _Right)));
+			}
+		};
+
+		template<>
+		struct _Avx2<int64_t> : _Avx2_base<int64_t>
+		{
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Broadcast(int64_t _Val)
+			{
+				return _mm256_broadcastq_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(&_Val)));
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(_Left, _Right)));
+			}
+		};
+
+		template<>
+		struct _Avx2<float> : _Avx2_base<float>
+		{
+			typedef __m256 _Vec;
+
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Load(const float *_Ptr)
+			{
+				return _mm256_loadu_ps(_Ptr);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Broadcast(float _Val)
+			{
+				return _mm256_set1_ps(_Val);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_Left, _Right, _CMP_EQ_OQ))));
+			}
+		};
+
+		template<>
+		struct _Avx2<double> : _Avx2_base<double>
+		{
+			typedef __m256d _Vec;
+
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Load(const double *_Ptr)
+			{
+				return _mm256_loadu_pd(_Ptr);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 _Vec _Broadcast(double _Val)
+			{
+				return _mm256_set1_pd(_Val);
+			}
+
+			static _PSTL_VEC_TARGET_AVX2 unsigned int _Equal(_Vec _Left, _Vec _Right)
+			{
+				return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_Left, _Right, _CMP_EQ_OQ))));
+			}
+		};
+#endif // _PSTL_VEC_AVX2
+
+		// The kernels run over the full vectors and finish the last elements one by one. _Second is the value
+		// for find and count, the other range for mismatch.
+		struct _Find_equal_kernel
+		{
+			template<typename _Isa, typename _Ty>
+			static size_t _Run(const _Ty *_First, const _Ty *_Second, size_t _Count)
+			{
+				const size_t _Lanes = sizeof(typename _Isa::_Vec) / sizeof(_Ty);
+				const typename _Isa::_Vec _Key = _Isa::_Broadcast(*_Second);
+
+				size_t _Pos = 0;
+				for (; _Pos + _Lanes <= _Count; _Pos += _Lanes)
+				{
+					const unsigned int _Mask = _Isa::_Equal(_Isa::_Load(_First + _Pos), _Key);
+					if (_Mask != 0)
+						return _Pos + _Mask_lowest_bit(_Mask) / sizeof(_Ty);
+				}
+
+				for (; _Pos < _Count; ++_Pos)
+					if (_First[_Pos] == *_Second)
+						return _Pos;
+
+				return _Count;
+			}
+		};
+
+		struct _Count_equal_kernel
+		{
+			template<typename _Isa, typename _Ty>
+			static size_t _Run(const _Ty *_First, const _Ty *_Second, size_t _Count)
+			{
+				const size_t _Lanes = sizeof(typename _Isa::_Vec) / sizeof(_Ty);
+				const typename _Isa::_Vec _Key = _Isa::_Broadcast(*_Second);
+
+				size_t _Bits = 0, _Pos = 0;
+				for (; _Pos + _Lanes <= _Count; _Pos += _Lanes)
+					_Bits += _Isa::_Popcount(_Isa::_Equal(_Isa::_Load(_First + _Pos), _Key));
+
+				size_t _Equal = _Bits / sizeof(_Ty);
+				for (; _Pos < _Count; ++_Pos)
+					if (_First[_Pos] == *_Second)
+						++_Equal;
+
+				return _Equal;
+			}
+		};
+
+		struct _Mismatch_kernel
+		{
+			template<typename _Isa, typename _Ty>
+			static size_t _Run(const _Ty *_First, const _Ty *_Second, size_t _Count)
+			{
+				const size_t _Lanes = sizeof(typename _Isa::_Vec) / sizeof(_Ty);
+
+				size_t _Pos = 0;
+				for (; _Pos + _Lanes <= _Count; _Pos += _Lanes)
+				{
+					const unsigned int _Mask = _Isa::_Equal(_Isa::_Load(_First + _Pos), _Isa::_Load(_Second + _Pos)) ^ _Isa::_All();
+					if (_Mask != 0)
+						return _Pos + _Mask_lowest_bit(_Mask) / sizeof(_Ty);
+				}
+
+				for (; _Pos < _Count; ++_Pos)
+					if (!(_First[_Pos] == _Second[_Pos]))
+						return _Pos;
+
+				return _Count;
+			}
+		};
+
+		// Compares the range with itself shifted by one element
+		struct _Adjacent_equal_kernel
+		{
+			template<typename _Isa, typename _Ty>
+			static size_t _Run(const _Ty *_First, const _Ty *, size_t _Count)
+			{
+				const size_t _Lanes = sizeof(typename _Isa::_Vec) / sizeof(_Ty);
+
+				size_t _Pos = 0;
+				for (; _Pos + _Lanes <= _Count; _Pos += _Lanes)
+				{
+					const unsigned int _Mask = _Isa::_Equal(_Isa::_Load(_First + _Pos), _Isa::_Load(_First + _Pos + 1));
+					if (_Mask != 0)
+						return _Pos + _Mask_lowest_bit(_Mask) / sizeof(_Ty);
+				}
+
+				for (; _Pos < _Count; ++_Pos)
+					if (_First[_Pos] == _First[_Pos + 1])
+						return _Pos;
+
+				return _Count;
+			}
+		};
+
+#if defined(_PSTL_VEC_AVX2)
+		template<typename _Kernel, typename _Ty>
+		_PSTL_VEC_TARGET_AVX2 _PSTL_VEC_FLATTEN size_t _Run_kernel_avx2(const _Ty *_First, const _Ty *_Second, size_t _Count)
+		{
+			const size_t _Result = _Kernel::template _Run<_Avx2<_Ty> >(_First, _Second, _Count);
+			// Avoids the transition penalty of the SSE code that follows
+			_mm256_zeroupper();
+			return _Result;
+		}
+#endif
+
+		template<typename _Kernel, typename _Ty>
+		size_t _Run_kernel(const void *_First, const void *_Second, size_t _Count)
+		{
+			const _Ty *_Ptr = static_cast<const _Ty *>(_First);
+			const _Ty *_Ptr2 = static_cast<const _Ty *>(_Second);
+
+			switch (_Vec_level)
+			{
+#if defined(_PSTL_VEC_AVX2)
+			case _Vec_isa_avx2:
+				return _Run_kernel_avx2<_Kernel>(_Ptr, _Ptr2, _Count);
+#endif
+#if defined(_PSTL_VEC_SSE2)
+			case _Vec_isa_sse2:
+				return _Kernel::template _Run<_Sse2<_Ty> >(_Ptr, _Ptr2, _Count);
+#endif
+			default:
+				return _Kernel::template _Run<_Scalar<_Ty> >(_Ptr, _Ptr2, _Count);
+			}
+		}
+
+		// Integers of the same size compare equal bit for bit whatever their signedness
+		template<typename _Kernel>
+		size_t _Run_kernel(_Vec_element_kind _Kind, const void *_First, const void *_Second, size_t _Count)
+		{
+			switch (_Kind)
+			{
+			case _Vec_int8:
+				return _Run_kernel<_Kernel, int8_t>(_First, _Second, _Count);
+			case _Vec_int16:
+				return _Run_kernel<_Kernel, int16_t>(_First, _Second, _Count);
+			case _Vec_int32:
+				return _Run_kernel<_Kernel, int32_t>(_First, _Second, _Count);
+			case _Vec_int64:
+				return _Run_kernel<_Kernel, int64_t>(_First, _Second, _Count);
+			case _Vec_float:
+				return _Run_kernel<_Kernel, float>(_First, _Second, _Count);
+			case _Vec_double:
+				return _Run_kernel<_Kernel, double>(_First, _Second, _Count);
+			default:
+				_ASSERT(false);
+				return _Count;
+			}
+		}
+
+		// Matrix multiplication micro-kernels: _Gemm_mr rows by _Gemm_nr columns of C are kept in registers while the
+		// panels are read, the panel of A holds _Gemm_mr values and the panel of B _Gemm_nr values per step of k
+		void _Gemm_kernel_scalar(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+		{
+			double _Acc[_Gemm_mr][_Gemm_nr] = {};
+			for (size_t _K = 0; _K < _Kc; ++_K, _A_panel += _Gemm_mr, _B_panel += _Gemm_nr)
+			{
+				for (size_t _I = 0; _I < _Gemm_mr; ++_I)
+					for (size_t _J = 0; _J < _Gemm_nr; ++_J)
+						_Acc[_I][_J] += _A_panel[_I] * _B_panel[_J];
+			}
+
+			for (size_t _I = 0; _I < _Gemm_mr; ++_I, _C += _Ldc)
+			{
+				for (size_t _J = 0; _J < _Gemm_nr; ++_J)
+					_C[_J] = _Accumulate ? _C[_J] + _Acc[_I][_J] : _Acc[_I][_J];
+			}
+		}
+
+#if defined(_PSTL_VEC_SSE2)
+		// Sixteen accumulators of two doubles, a row of C takes four
+		void _Gemm_kernel_sse2(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+		{
+			static_assert(_Gemm_mr == 4 && _Gemm_nr == 8, "The kernel computes 4 x 8 elements");
+
+			__m128d _Acc[4][4];
+			for (int _I = 0; _I < 4; ++_I)
+				for (int _J = 0; _J < 4; ++_J)
+					_Acc[_I][_J] = _mm_setzero_pd();
+
+			for (size_t _K = 0; _K < _Kc; ++_K, _A_panel += _Gemm_mr, _B_panel += _Gemm_nr)
+			{
+				const __m128d _B0 = _mm_loadu_pd(_B_panel), _B1 = _mm_loadu_pd(_B_panel + 2);
+				const __m128d _B2 = _mm_loadu_pd(_B_panel + 4), _B3 = _mm_loadu_pd(_B_panel + 6);
+				for (int _I = 0; _I < 4; ++_I)
+				{
+					const __m128d _Ai = _mm_set1_pd(_A_panel[_I]);
+					_Acc[_I][0] = _mm_add_pd(_Acc[_I][0], _mm_mul_pd(_Ai, _B0));
+					_Acc[_I][1] = _mm_add_pd(_Acc[_I][1], _mm_mul_pd(_Ai, _B1));
+					_Acc[_I][2] = _mm_add_pd(_Acc[_I][2], _mm_mul_pd(_Ai, _B2));
+					_Acc[_I][3] = _mm_add_pd(_Acc[_I][3], _mm_mul_pd(_Ai, _B3));
+				}
+			}
+
+			for (int _I = 0; _I < 4; ++_I, _C += _Ldc)
+			{
+				for (int _J = 0; _J < 4; ++_J)
+				{
+					const __m128d _Val = _Accumulate ? _mm_add_pd(_mm_loadu_pd(_C + 2 * _J), _Acc[_I][_J]) : _Acc[_I][_J];
+					_mm_storeu_pd(_C + 2 * _J, _Val);
+				}
+			}
+		}
+#endif // _PSTL_VEC_SSE2
+
+#if defined(_PSTL_VEC_AVX2)
+		template<bool _Fma>
+		struct _Gemm_madd
+		{
+			static _PSTL_VEC_TARGET_AVX2 __m256d _Run(__m256d _Left, __m256d _Right, __m256d _Acc)
+			{
+				return _mm256_add_pd(_Acc, _mm256_mul_pd(_Left, _Right));
+			}
+		};
+
+#if defined(_PSTL_VEC_FMA)
+		template<>
+		struct _Gemm_madd<true>
+		{
+			static _PSTL_VEC_TARGET_FMA __m256d _Run(__m256d _Left, __m256d _Right, __m256d _Acc)
+			{
+				return _mm256_fmadd_pd(_Left, _Right, _Acc);
+			}
+		};
+#endif
+
+		// Eight accumulators of four doubles, a row of C takes two
+		template<bool _Fma>
+		_PSTL_VEC_TARGET_AVX2 void _Gemm_kernel_avx2(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+		{
+			static_assert(_Gemm_mr == 4 && _Gemm_nr == 8, "The kernel computes 4 x 8 elements");
+			typedef _Gemm_madd<_Fma> _Madd;
+
+			__m256d _C00 = _mm256_setzero_pd(), _C01 = _mm256_setzero_pd(), _C10 = _mm256_setzero_pd(), _C11 = _mm256_setzero_pd();
+			__m256d _C20 = _mm256_setzero_pd(), _C21 = _mm256_setzero_pd(), _C30 = _mm256_setzero_pd(), _C31 = _mm256_setzero_pd();
+			for (size_t _K = 0; _K < _Kc; ++_K, _A_panel += _Gemm_mr, _B_panel += _Gemm_nr)
+			{
+				const __m256d _B0 = _mm256_loadu_pd(_B_panel), _B1 = _mm256_loadu_pd(_B_panel + 4);
+
+				__m256d _Ai = _mm256_broadcast_sd(_A_panel);
+				_C00 = _Madd::_Run(_Ai, _B0, _C00);
+				_C01 = _Madd::_Run(_Ai, _B1, _C01);
+				_Ai = _mm256_broadcast_sd(_A_panel + 1);
+				_C10 = _Madd::_Run(_Ai, _B0, _C10);
+				_C11 = _Madd::_Run(_Ai, _B1, _C11);
+				_Ai = _mm256_broadcast_sd(_A_panel + 2);
+				_C20 = _Madd::_Run(_Ai, _B0, _C20);
+				_C21 = _Madd::_Run(_Ai, _B1, _C21);
+				_Ai = _mm256_broadcast_sd(_A_panel + 3);
+				_C30 = _Madd::_Run(_Ai, _B0, _C30);
+				_C31 = _Madd::_Run(_Ai, _B1, _C31);
+			}
+
+			const __m256d _Rows[4][2] = { { _C00, _C01 }, { _C10, _C11 }, { _C20, _C21 }, { _C30, _C31 } };
+			for (int _I = 0; _I < 4; ++_I, _C += _Ldc)
+			{
+				for (int _J = 0; _J < 2; ++_J)
+				{
+					const __m256d _Val = _Accumulate ? _mm256_add_pd(_mm256_loadu_pd(_C + 4 * _J), _Rows[_I][_J]) : _Rows[_I][_J];
+					_mm256_storeu_pd(_C + 4 * _J, _Val);
+				}
+			}
+		}
+
+		_PSTL_VEC_TARGET_AVX2 _PSTL_VEC_FLATTEN void _Gemm_kernel_avx2_mul_add(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+		{
+			_Gemm_kernel_avx2<false>(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+			_mm256_zeroupper();
+		}
+
+#if defined(_PSTL_VEC_FMA)
+		_PSTL_VEC_TARGET_FMA _PSTL_VEC_FLATTEN void _Gemm_kernel_avx2_fma(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+		{
+			_Gemm_kernel_avx2<true>(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+			_mm256_zeroupper();
+		}
+#endif
+#endif // _PSTL_VEC_AVX2
+	}
+
+	_EXP_IMPL size_t __cdecl _Vec_find_equal(const void *_First, size_t _Count, const void *_Val, _Vec_element_kind _Kind)
+	{
+		return _Run_kernel<_Find_equal_kernel>(_Kind, _First, _Val, _Count);
+	}
+
+	_EXP_IMPL size_t __cdecl _Vec_count_equal(const void *_First, size_t _Count, const void *_Val, _Vec_element_kind _Kind)
+	{
+		return _Run_kernel<_Count_equal_kernel>(_Kind, _First, _Val, _Count);
+	}
+
+	_EXP_IMPL size_t __cdecl _Vec_mismatch(const void *_First, const void *_First2, size_t _Count, _Vec_element_kind _Kind)
+	{
+		return _Run_kernel<_Mismatch_kernel>(_Kind, _First, _First2, _Count);
+	}
+
+	_EXP_IMPL size_t __cdecl _Vec_adjacent_equal(const void *_First, size_t _Count, _Vec_element_kind _Kind)
+	{
+		return _Run_kernel<_Adjacent_equal_kernel>(_Kind, _First, nullptr, _Count);
+	}
+
+	_EXP_IMPL void __cdecl _Gemm_kernel_double(size_t _Kc, const double *_A_panel, const double *_B_panel, double *_C, ptrdiff_t _Ldc, bool _Accumulate)
+	{
+		switch (_Vec_level)
+		{
+#if defined(_PSTL_VEC_AVX2)
+		case _Vec_isa_avx2:
+#if defined(_PSTL_VEC_FMA)
+			if (_Vec_fma)
+				_Gemm_kernel_avx2_fma(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+			else
+#endif
+				_Gemm_kernel_avx2_mul_add(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+			break;
+#endif
+#if defined(_PSTL_VEC_SSE2)
+		case _Vec_isa_sse2:
+			_Gemm_kernel_sse2(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+			break;
+#endif
+		default:
+			_Gemm_kernel_scalar(_Kc, _A_panel, _B_panel, _C, _Ldc, _Accumulate);
+		}
+	}
+} // details
+_PSTL_NS1_END
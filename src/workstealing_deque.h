@@ -0,0 +1,162 @@
+#pragma once
+
+#ifndef _SRC_WORKSTEALING_DEQUE_H_
+#define _SRC_WORKSTEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <experimental/impl/defines.h>
+
+_PSTL_NS1_BEGIN
+namespace details {
+
+	// Chase-Lev work-stealing deque of pointers, following the C11 formulation of
+	// Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models".
+	// The owner pushes and pops at the bottom, thieves take from the top with a single CAS.
+	// The buffer grows on demand; retired buffers are kept until the deque is destroyed
+	// since a concurrent thief may still be reading from them.
+	template <typename _Ty>
+	class _Workstealing_deque
+	{
+		struct _Buffer
+		{
+			intptr_t _Capacity; // 2^n
+			std::atomic<_Ty *> *_Slots;
+			_Buffer *_Retired;
+
+			explicit _Buffer(intptr_t _Cap) : _Capacity(_Cap), _Slots(new std::atomic<_Ty *>[static_cast<size_t>(_Cap)]), _Retired(nullptr)
+			{
+			}
+
+			~_Buffer()
+			{
+				delete [] _Slots;
+			}
+
+			_Ty *get(intptr_t _Index) const
+			{
+				return _Slots[_Index & (_Capacity - 1)].load(std::memory_order_relaxed);
+			}
+
+			void put(intptr_t _Index, _Ty *_Item)
+			{
+				_Slots[_Index & (_Capacity - 1)].store(_Item, std::memory_order_relaxed);
+			}
+
+			_Buffer *grow(intptr_t _Bottom, intptr_t _Top)
+			{
+				_Buffer *_New = new _Buffer(_Capacity * 2);
+				for (intptr_t _I = _Top; _I < _Bottom; ++_I)
+					_New->put(_I, get(_I));
+				_New->_Retired = this;
+				return _New;
+			}
+		};
+
+		// top and bottom are kept on separate cache lines, thieves hammer top while the owner updates bottom
+		std::atomic<intptr_t> _Top;
+		char _Pad[64 - sizeof(std::atomic<intptr_t>)];
+		std::atomic<intptr_t> _Bottom;
+		std::atomic<_Buffer *> _Array;
+
+	public:
+		explicit _Workstealing_deque(intptr_t _Initial_capacity = 256) : _Top(0), _Bottom(0), _Array(new _Buffer(_Initial_capacity))
+		{
+		}
+
+		_Workstealing_deque(const _Workstealing_deque &) = delete;
+		_Workstealing_deque &operator =(const _Workstealing_deque &) = delete;
+
+		~_Workstealing_deque()
+		{
+			_Buffer *_Buf = _Array.load(std::memory_order_relaxed);
+			while (_Buf != nullptr)
+			{
+				_Buffer *_Next = _Buf->_Retired;
+				delete _Buf;
+				_Buf = _Next;
+			}
+		}
+
+		// Owner only
+		void push(_Ty *_Item)
+		{
+			intptr_t _B = _Bottom.load(std::memory_order_relaxed);
+			intptr_t _T = _Top.load(std::memory_order_acquire);
+			_Buffer *_Buf = _Array.load(std::memory_order_relaxed);
+			if (_B - _T > _Buf->_Capacity - 1)
+			{
+				_Buf = _Buf->grow(_B, _T);
+				_Array.store(_Buf, std::memory_order_relaxed);
+			}
+			_Buf->put(_B, _Item);
+			std::atomic_thread_fence(std::memory_order_release);
+			_Bottom.store(_B + 1, std::memory_order_relaxed);
+		}
+
+		// Owner only. Returns nullptr when the deque is empty or the last item was lost to a thief.
+		_Ty *pop()
+		{
+			intptr_t _B = _Bottom.load(std::memory_order_relaxed) - 1;
+			_Buffer *_Buf = _Array.load(std::memory_order_relaxed);
+			_Bottom.store(_B, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			intptr_t _T = _Top.load(std::memory_order_relaxed);
+
+			_Ty *_Item = nullptr;
+			if (_T <= _B)
+			{
+				_Item = _Buf->get(_B);
+				if (_T == _B)
+				{
+					// single item left, race against thieves for it
+					if (!_Top.compare_exchange_strong(_T, _T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						_Item = nullptr;
+					_Bottom.store(_B + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+				_Bottom.store(_B + 1, std::memory_order_relaxed);
+
+			return _Item;
+		}
+
+		// Any thread. Returns nullptr when the deque is empty or the CAS was lost to another thief or the owner.
+		_Ty *steal()
+		{
+			intptr_t _T = _Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			intptr_t _B = _Bottom.load(std::memory_order_acquire);
+
+			if (_T < _B)
+			{
+				// consume is promoted to acquire by every compiler we target
+				_Buffer *_Buf = _Array.load(std::memory_order_acquire);
+				_Ty *_Item = _Buf->get(_T);
+				if (!_Top.compare_exchange_strong(_T, _T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+				return _Item;
+			}
+
+			return nullptr;
+		}
+
+		// Owner only. Index one past the most recently pushed item; items are never moved,
+		// so an owner can tell whether anything it pushed after a given point is still queued.
+		intptr_t bottom() const
+		{
+			return _Bottom.load(std::memory_order_relaxed);
+		}
+
+		// Approximation only, the value can be stale by the time it is used
+		bool empty() const
+		{
+			return _Bottom.load(std::memory_order_relaxed) <= _Top.load(std::memory_order_relaxed);
+		}
+	};
+
+} // std::experimental::parallel::details
+_PSTL_NS1_END
+
+#endif // _SRC_WORKSTEALING_DEQUE_H_